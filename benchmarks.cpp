@@ -0,0 +1,1248 @@
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <malloc.h>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include "bloomFilter.h"
+#include "customerStore.h"
+#include "durableFile.h"
+#include "flatSet.h"
+#include "idGenerator.h"
+#include "inventoryCount.h"
+#include "mappedFile.h"
+#include "money.h"
+#include "recordId.h"
+#include "recordParser.h"
+#include "rewardRules.h"
+#include "threadPool.h"
+#include "transactionLog.h"
+#include "utility.h"
+
+/*
+****************************************************************************
+************************** BENCHMARK HELPERS START *************************
+****************************************************************************
+*/
+
+static const char benchmarkCustomerFile[] = "benchmark_customers.txt";
+
+/*
+Function Name: writeSyntheticCustomers
+Purpose: Writes a customer file in the same layout as "customers.txt" for the benchmarks to read.
+Meaning of Parameters:
+  - const std::string& fileName: The file to create.
+  - int count: How many customer records to write.
+Description of Return Values:
+  - Returns the size of the file in bytes, or 0 if it could not be written.
+*/
+static std::uint64_t writeSyntheticCustomers(const std::string& fileName, int count) {
+    std::ofstream outfile(fileName, std::ios::trunc);
+    for (int i = 1; i <= count; ++i) {
+        outfile << "Customer " << i << "\n"
+                << "\tID: CustID" << (1000000000LL + i) << "\n"
+                << "\tUser name: U_user" << i << "\n"
+                << "\tFirst Name: First\n"
+                << "\tLast Name: Last\n"
+                << "\tAge: " << (18 + i % 60) << "\n"
+                << "\tCredit Card: 1234-5678-9012\n"
+                << "\tTotal Reward Points: " << (i % 5000) << "\n";
+    }
+    std::uint64_t size = static_cast<std::uint64_t>(outfile.tellp());
+    outfile.close();
+    return outfile ? size : 0;
+}
+
+/*
+Function Name: reportThroughput
+Purpose: Prints how long a parse took and the resulting throughput.
+Meaning of Parameters:
+  - const std::string& label: What was measured.
+  - std::uint64_t bytes: How many bytes were parsed.
+  - double seconds: How long it took.
+  - std::size_t records: How many records were produced, as a check that both parsers agree.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void reportThroughput(const std::string& label, std::uint64_t bytes, double seconds, std::size_t records) {
+    double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    std::printf("  %-34s %8.1f ms %9.1f MB/s  (%zu records)\n", label.c_str(), seconds * 1000.0,
+                seconds > 0.0 ? megabytes / seconds : 0.0, records);
+}
+
+/*
+Function Name: secondsSince
+Purpose: Measures the time elapsed since a starting point.
+Meaning of Parameters:
+  - std::chrono::steady_clock::time_point start: The starting point.
+Description of Return Values:
+  - Returns the elapsed time in seconds.
+*/
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+****************************************************************************
+*************************** BENCHMARK HELPERS END **************************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+*********************** RECORD PARSER BENCHMARK START **********************
+****************************************************************************
+*/
+
+/*
+Function Name: parseCustomersWithGetline
+Purpose: Parses a customer file the way the readers did before RecordParser: std::getline into a string, trim() and extractField() copies, and std::atoi.
+Meaning of Parameters:
+  - const std::string& fileName: The customer file to parse.
+  - std::vector<CustomerRecord>& records: Receives the records.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void parseCustomersWithGetline(const std::string& fileName, std::vector<CustomerRecord>& records) {
+    std::ifstream infile(fileName);
+    std::string line;
+    std::string value;
+    while (std::getline(infile, line)) {
+        line = trim(line);
+        if (extractField(line, "Customer", value)) {
+            records.push_back(CustomerRecord());
+            records.back().customerNumber = std::atoi(value.c_str());
+        } else if (records.empty()) {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        } else if (extractField(line, "ID:", value)) {
+            parseCustomerId(value, records.back().userID);
+        } else if (extractField(line, "User name:", value)) {
+            records.back().username = value;
+        } else if (extractField(line, "First Name:", value)) {
+            records.back().firstName = value;
+        } else if (extractField(line, "Last Name:", value)) {
+            records.back().lastName = value;
+        } else if (extractField(line, "Age:", value)) {
+            records.back().age = std::atoi(value.c_str());
+        } else if (extractField(line, "Credit Card:", value)) {
+            records.back().creditCard = value;
+        } else if (extractField(line, "Total Reward Points:", value)) {
+            records.back().rewardPoints = std::atoi(value.c_str());
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: parseCustomersWithRecordParser
+Purpose: Parses customer file text the way the stores do now: string_view fields from RecordParser and std::from_chars numbers.
+Meaning of Parameters:
+  - std::string_view contents: The whole customer file, read into memory or mapped.
+  - std::vector<CustomerRecord>& records: Receives the records.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void parseCustomersWithRecordParser(std::string_view contents, std::vector<CustomerRecord>& records) {
+    RecordParser parser(contents);
+    std::string_view line;
+    std::string_view value;
+    while (parser.nextLine(line)) {
+        if (fieldValue(line, "Customer", value)) {
+            records.push_back(CustomerRecord());
+            parseNumber(value, records.back().customerNumber);
+        } else if (records.empty()) {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        } else if (fieldValue(line, "ID:", value)) {
+            parseCustomerId(value, records.back().userID);
+        } else if (fieldValue(line, "User name:", value)) {
+            records.back().username.assign(value);
+        } else if (fieldValue(line, "First Name:", value)) {
+            records.back().firstName.assign(value);
+        } else if (fieldValue(line, "Last Name:", value)) {
+            records.back().lastName.assign(value);
+        } else if (fieldValue(line, "Age:", value)) {
+            parseNumber(value, records.back().age);
+        } else if (fieldValue(line, "Credit Card:", value)) {
+            records.back().creditCard.assign(value);
+        } else if (fieldValue(line, "Total Reward Points:", value)) {
+            parseNumber(value, records.back().rewardPoints);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: benchmarkRecordParser
+Purpose: Compares customer file parse throughput before and after the switch to RecordParser, plus a full CustomerStore::load for reference.
+Meaning of Parameters:
+  - int customerCount: How many synthetic customers to parse.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkRecordParser(int customerCount) {
+    std::uint64_t bytes = writeSyntheticCustomers(benchmarkCustomerFile, customerCount);
+    std::vector<CustomerRecord> records;
+    std::string buffer;
+    MappedFile mappedFile;
+    CustomerStore store;
+    std::cout << "Record parsing (" << customerCount << " customers, " << bytes / 1024 << " KB):\n";
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    parseCustomersWithGetline(benchmarkCustomerFile, records);
+    reportThroughput("getline + trim + extractField", bytes, secondsSince(start), records.size());
+
+    records.clear();
+    start = std::chrono::steady_clock::now();
+    readWholeFile(benchmarkCustomerFile, buffer);
+    parseCustomersWithRecordParser(buffer, records);
+    reportThroughput("read + RecordParser + from_chars", bytes, secondsSince(start), records.size());
+
+    records.clear();
+    start = std::chrono::steady_clock::now();
+    mappedFile.open(benchmarkCustomerFile);
+    parseCustomersWithRecordParser(mappedFile.contents(), records);
+    reportThroughput("mmap + RecordParser + from_chars", bytes, secondsSince(start), records.size());
+    mappedFile.close();
+
+    start = std::chrono::steady_clock::now();
+    store.load(benchmarkCustomerFile);
+    reportThroughput("CustomerStore::load (with index)", bytes, secondsSince(start), store.size());
+
+    std::remove(benchmarkCustomerFile);
+}
+
+/*
+****************************************************************************
+************************ RECORD PARSER BENCHMARK END ***********************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+************************ REWARD RULES BENCHMARK START **********************
+****************************************************************************
+*/
+
+/*
+Function Name: legacyRewardPoints
+Purpose: The fixed reward calculation used before the configurable rules: 10 points per full $5 plus a proportional share of the remainder.
+Meaning of Parameters:
+  - double totalAmount: The transaction total in dollars.
+Description of Return Values:
+  - Returns the reward points earned.
+*/
+static int legacyRewardPoints(double totalAmount) {
+    int fullChunks = static_cast<int>(totalAmount / 5);
+    double remainder = totalAmount - (fullChunks * 5);
+    return (fullChunks * 10) + static_cast<int>((remainder / 5) * 10);
+}
+
+/*
+Function Name: sampleRuleSet
+Purpose: Builds a rule set with a minimum spend, three brackets and a few product and category multipliers, for timing a realistic configuration.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the rule set.
+*/
+static RewardRuleSet sampleRuleSet() {
+    RewardRuleSet ruleSet;
+    ruleSet.minimumSpend = Money::fromCents(100);
+    ruleSet.brackets.push_back(RewardBracket{ Money::fromCents(2500), 250 });
+    ruleSet.brackets.push_back(RewardBracket{ Money::fromCents(10000), 300 });
+    ruleSet.brackets.push_back(RewardBracket{ Money::fromCents(50000), 400 });
+    ruleSet.multipliers.push_back(RewardMultiplier{ "Product Multiplier 1", 200, { "Prod10007" } });
+    ruleSet.multipliers.push_back(RewardMultiplier{ "Category Multiplier 1", 150, { "Prod10003", "Prod10007", "Prod10011" } });
+    return ruleSet;
+}
+
+/*
+Function Name: benchmarkRewardRules
+Purpose: Checks that the default compiled rules give the same points as the legacy calculation for every whole-cent total, then times both and a sample rule set with brackets and multipliers.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkRewardRules() {
+    const int cents = 1000000; // Every total from $0.00 to $9999.99
+    const int rounds = 20;
+    std::vector<double> dollars(cents);
+    std::vector<Money> amounts(cents);
+    std::vector<ProductId> productIDs(cents);
+    for (int i = 0; i < cents; ++i) {
+        dollars[i] = i / 100.0;
+        amounts[i] = Money::fromCents(i);
+        productIDs[i] = static_cast<ProductId>(10000 + i % 16);
+    }
+
+    RewardRules defaultRules;
+    RewardRules sampleRules;
+    sampleRules.compile(sampleRuleSet());
+    int mismatches = 0;
+    for (int i = 0; i < cents; ++i) {
+        mismatches += (legacyRewardPoints(dollars[i]) != defaultRules.points(amounts[i], amounts[i].cents() * rewardScale)) ? 1 : 0;
+    }
+    std::cout << "Reward rules (" << cents << " totals x " << rounds << "): " << mismatches << " mismatches between legacy and default rules\n";
+
+    long long sum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < cents; ++i) {
+            sum += legacyRewardPoints(dollars[i]);
+        }
+    }
+    std::printf("  %-36s %8.2f ns/evaluation\n", "legacy calculateRewardPoints", secondsSince(start) * 1e9 / (double(cents) * rounds));
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < cents; ++i) {
+            sum += defaultRules.points(amounts[i], amounts[i].cents() * rewardScale);
+        }
+    }
+    std::printf("  %-36s %8.2f ns/evaluation\n", "compiled default rules", secondsSince(start) * 1e9 / (double(cents) * rounds));
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < cents; ++i) {
+            sum += sampleRules.points(amounts[i], sampleRules.weigh(amounts[i], productIDs[i]));
+        }
+    }
+    std::printf("  %-36s %8.2f ns/evaluation\n", "compiled brackets + multipliers", secondsSince(start) * 1e9 / (double(cents) * rounds));
+    std::cout << "  (checksum " << sum << ")\n";
+}
+
+/*
+Function Name: timeRewardBatch
+Purpose: Times one pointsBatch path over the same totals and checks its results against the scalar loop.
+Meaning of Parameters:
+  - const std::string& label: The row label.
+  - const RewardRules& rules: The compiled rules.
+  - const std::vector<Money>& amounts: The totals.
+  - const std::vector<int>& expected: The scalar loop's results.
+  - int batchPath: The path to time.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeRewardBatch(const std::string& label, const RewardRules& rules, const std::vector<Money>& amounts, const std::vector<int>& expected, int batchPath) {
+    std::vector<int> points(amounts.size());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    rules.pointsBatch(amounts.data(), points.data(), amounts.size(), batchPath);
+    double seconds = secondsSince(start);
+    std::printf("  %-36s %8.1f M totals/s  (%s)\n", label.c_str(), amounts.size() / seconds / 1e6, points == expected ? "matches" : "DIFFERS");
+}
+
+/*
+Function Name: benchmarkRewardBatch
+Purpose: Compares the batch reward calculation on each path (scalar, SSE2, AVX2) with a loop of single evaluations, using a rule set with a minimum spend and three brackets.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkRewardBatch() {
+    const std::size_t count = 4000000;
+    std::vector<Money> amounts(count);
+    std::uint64_t seed = 12345;
+    for (std::size_t i = 0; i < count; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        amounts[i] = Money::fromCents(static_cast<std::int64_t>((seed >> 33) % 100000)); // $0 to $1000
+    }
+
+    RewardRules rules;
+    rules.compile(sampleRuleSet());
+    std::vector<int> expected(count);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        expected[i] = rules.points(amounts[i], amounts[i].cents() * rewardScale);
+    }
+    std::cout << "Batch reward calculation (" << count << " totals, 3 brackets):\n";
+    std::printf("  %-36s %8.1f M totals/s\n", "loop of RewardRules::points", count / secondsSince(start) / 1e6);
+
+    timeRewardBatch("pointsBatch, scalar", rules, amounts, expected, rewardBatchScalar);
+    timeRewardBatch("pointsBatch, SSE2", rules, amounts, expected, rewardBatchSse2);
+    if (RewardRules::bestBatchPath() == rewardBatchAvx2) {
+        timeRewardBatch("pointsBatch, AVX2", rules, amounts, expected, rewardBatchAvx2);
+    } else {
+        std::cout << "  (AVX2 not supported on this CPU)\n";
+    }
+}
+
+/*
+****************************************************************************
+************************* REWARD RULES BENCHMARK END ***********************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+**************************** MONEY BENCHMARK START *************************
+****************************************************************************
+*/
+
+/*
+Function Name: benchmarkMoney
+Purpose: Compares parsing and formatting prices as double (std::stod and a fixed two-place ostringstream) with parseMoney and appendMoney, and shows the error a double sum builds up over a large batch.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkMoney() {
+    const int count = 1000000;
+    std::vector<std::string> prices(count);
+    for (int i = 0; i < count; ++i) {
+        prices[i] = std::to_string(i % 100000 / 100) + "." + std::to_string(10 + i % 90);
+    }
+    std::cout << "Money (" << count << " prices):\n";
+
+    std::vector<double> doublePrices(count);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        doublePrices[i] = std::stod(prices[i]);
+    }
+    std::printf("  %-36s %8.2f ns/price\n", "parse with std::stod", secondsSince(start) * 1e9 / count);
+
+    std::vector<Money> moneyPrices(count);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        parseMoney(prices[i], moneyPrices[i]);
+    }
+    std::printf("  %-36s %8.2f ns/price\n", "parse with parseMoney", secondsSince(start) * 1e9 / count);
+
+    std::ostringstream oss;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        oss << std::fixed << std::setprecision(2) << doublePrices[i] << "\n";
+    }
+    std::printf("  %-36s %8.2f ns/price\n", "format with ostringstream", secondsSince(start) * 1e9 / count);
+
+    std::string text;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        appendMoney(text, moneyPrices[i]);
+        text += '\n';
+    }
+    std::printf("  %-36s %8.2f ns/price\n", "format with appendMoney", secondsSince(start) * 1e9 / count);
+    std::cout << "  formatted output " << (oss.str() == text ? "matches" : "DIFFERS") << "\n";
+
+    double doubleTotal = 0.0;
+    Money moneyTotal;
+    for (int i = 0; i < count; ++i) {
+        doubleTotal += doublePrices[i];
+        moneyTotal += moneyPrices[i];
+    }
+    std::ostringstream sums;
+    sums << std::fixed << std::setprecision(6) << doubleTotal;
+    std::cout << "  sum as double " << sums.str() << ", as Money " << formatMoney(moneyTotal) << "\n";
+}
+
+/*
+****************************************************************************
+***************************** MONEY BENCHMARK END **************************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+************************* ID GENERATOR BENCHMARK START *********************
+****************************************************************************
+*/
+
+static const char benchmarkIdStateFile[] = "benchmark_id_state.txt";
+
+/*
+Function Name: legacyProductIDs
+Purpose: Fills the product ID space the way generateProductID used to, retrying random numbers until one is not in the set, seeding once so it can finish.
+Meaning of Parameters:
+  - std::size_t count: How many IDs to generate.
+Description of Return Values:
+  - Returns how many random numbers were drawn in total.
+*/
+static std::uint64_t legacyProductIDs(std::size_t count) {
+    std::unordered_set<std::string> ids;
+    std::uint64_t draws = 0;
+    std::srand(12345);
+    while (ids.size() < count) {
+        ids.insert("Prod" + std::to_string(10000 + std::rand() % 90000));
+        ++draws;
+    }
+    return draws;
+}
+
+/*
+Function Name: countDistinctNumbers
+Purpose: Draws every number from a fresh generator and checks that none repeats and all fall in the range.
+Meaning of Parameters:
+  - std::uint64_t first: The smallest number in the range.
+  - std::uint64_t count: How many numbers to draw; no more than the range holds.
+  - std::uint64_t rangeSize: How many numbers the range holds.
+Description of Return Values:
+  - Returns how many distinct in-range numbers were drawn; equal to `count` when the generator is a permutation.
+*/
+static std::uint64_t countDistinctNumbers(std::uint64_t first, std::uint64_t count, std::uint64_t rangeSize) {
+    std::remove(benchmarkIdStateFile);
+    IdGenerator generator("", first, rangeSize, 4096, benchmarkIdStateFile);
+    std::vector<bool> seen(rangeSize, false);
+    std::uint64_t distinct = 0;
+    std::uint64_t number = 0;
+    for (std::uint64_t i = 0; i < count && generator.nextNumber(number); ++i) {
+        if (number >= first && number - first < rangeSize && !seen[number - first]) {
+            seen[number - first] = true;
+            ++distinct;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return distinct;
+}
+
+/*
+Function Name: timeCustomerIds
+Purpose: Times issuing IDs from a fresh generator over the 10 digit customer range, as bare numbers and as prefixed strings.
+Meaning of Parameters:
+  - std::uint64_t count: How many IDs to issue each way.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeCustomerIds(std::uint64_t count) {
+    std::remove(benchmarkIdStateFile);
+    IdGenerator customers("CustID", 1000000000ULL, 9000000000ULL, 4096, benchmarkIdStateFile);
+    std::uint64_t number = 0;
+    std::uint64_t checksum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < count; ++i) {
+        customers.nextNumber(number);
+        checksum += number;
+    }
+    double seconds = secondsSince(start);
+    std::printf("  %-36s %8.2f M IDs/s (checksum %llu)\n", "nextNumber, 10 digit customer range", count / seconds / 1e6, static_cast<unsigned long long>(checksum % 1000));
+
+    std::string id;
+    start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < count; ++i) {
+        customers.nextNumber(number);
+        id = formatId(static_cast<CustomerId>(number));
+    }
+    std::printf("  %-36s %8.2f M IDs/s\n", "nextNumber + formatId", count / secondsSince(start) / 1e6);
+}
+
+/*
+Function Name: benchmarkIdGenerator
+Purpose: Times issuing IDs from the keyed permutation and filling the product ID space with the old retry loop, and checks that no ID repeats.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkIdGenerator() {
+    std::cout << "ID generator:\n";
+    timeCustomerIds(5000000);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::uint64_t draws = legacyProductIDs(90000);
+    std::printf("  %-36s %8.2f ms (%llu draws)\n", "old retry loop, all 90000 products", secondsSince(start) * 1e3, static_cast<unsigned long long>(draws));
+    start = std::chrono::steady_clock::now();
+    std::uint64_t distinct = countDistinctNumbers(10000, 90000, 90000);
+    std::printf("  %-36s %8.2f ms (%llu distinct)\n", "permutation, all 90000 products", secondsSince(start) * 1e3, static_cast<unsigned long long>(distinct));
+    distinct = countDistinctNumbers(1000000, 9000000, 9000000);
+    std::cout << "  all 9000000 transaction IDs: " << distinct << " distinct\n";
+    std::remove(benchmarkIdStateFile);
+}
+
+/*
+****************************************************************************
+************************** ID GENERATOR BENCHMARK END **********************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+*************************** RECORD ID BENCHMARK START **********************
+****************************************************************************
+*/
+
+/*
+Function Name: heapBytesInUse
+Purpose: Reports how much heap memory is allocated right now, for measuring what a container costs.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the bytes allocated through malloc, including large blocks malloc maps on their own.
+*/
+static std::size_t heapBytesInUse() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+/*
+Function Name: timeStringIdSet
+Purpose: Builds a set of customer IDs kept as "CustID##########" strings, the way the global sets used to hold them, and looks every ID up again.
+Meaning of Parameters:
+  - const std::vector<std::uint64_t>& numbers: The ID numbers.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeStringIdSet(const std::vector<std::uint64_t>& numbers) {
+    std::size_t heapBefore = heapBytesInUse();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::unordered_set<std::string> ids;
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        ids.insert("CustID" + std::to_string(numbers[i]));
+    }
+    double insertSeconds = secondsSince(start);
+    std::size_t bytes = heapBytesInUse() - heapBefore;
+
+    std::size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        found += ids.count("CustID" + std::to_string(numbers[i]));
+    }
+    std::printf("  %-36s %8.2f ms insert %8.2f ms lookup %6.1f bytes/ID (%zu found)\n", "unordered_set<std::string>", insertSeconds * 1e3, secondsSince(start) * 1e3, static_cast<double>(bytes) / numbers.size(), found);
+}
+
+/*
+Function Name: timeTypedIdSet
+Purpose: Builds a set of customer IDs kept as CustomerId integers, as the global sets now hold them, and looks every ID up again.
+Meaning of Parameters:
+  - const std::vector<std::uint64_t>& numbers: The ID numbers.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeTypedIdSet(const std::vector<std::uint64_t>& numbers) {
+    std::size_t heapBefore = heapBytesInUse();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::unordered_set<CustomerId> ids;
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        ids.insert(static_cast<CustomerId>(numbers[i]));
+    }
+    double insertSeconds = secondsSince(start);
+    std::size_t bytes = heapBytesInUse() - heapBefore;
+
+    std::size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        found += ids.count(static_cast<CustomerId>(numbers[i]));
+    }
+    std::printf("  %-36s %8.2f ms insert %8.2f ms lookup %6.1f bytes/ID (%zu found)\n", "unordered_set<CustomerId>", insertSeconds * 1e3, secondsSince(start) * 1e3, static_cast<double>(bytes) / numbers.size(), found);
+}
+
+/*
+Function Name: benchmarkRecordIds
+Purpose: Compares the memory and speed of a customer ID set keyed on strings with one keyed on integers, and times parsing and formatting IDs at the file boundary.
+Meaning of Parameters:
+  - int count: How many IDs to use.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkRecordIds(int count) {
+    std::cout << "Record IDs (" << count << " customer IDs):\n";
+    std::vector<std::uint64_t> numbers(count);
+    for (int i = 0; i < count; ++i) {
+        numbers[i] = 1000000000ULL + static_cast<std::uint64_t>(i) * 7919;
+    }
+    timeStringIdSet(numbers);
+    timeTypedIdSet(numbers);
+
+    std::vector<std::string> texts(count);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        texts[i] = formatId(static_cast<CustomerId>(numbers[i]));
+    }
+    double formatSeconds = secondsSince(start);
+    CustomerId id{};
+    std::size_t parsed = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        parsed += parseCustomerId(texts[i], id) ? 1 : 0;
+    }
+    std::printf("  %-36s %8.2f ms format %8.2f ms parse (%zu parsed)\n", "formatId / parseCustomerId", formatSeconds * 1e3, secondsSince(start) * 1e3, parsed);
+}
+
+/*
+****************************************************************************
+**************************** RECORD ID BENCHMARK END ***********************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+**************************** FLAT SET BENCHMARK START **********************
+****************************************************************************
+*/
+
+/*
+Function Name: syntheticUsername
+Purpose: Makes the i-th of a run of distinct usernames in the "U_" + 5 letters + 3 digits format.
+Meaning of Parameters:
+  - std::uint64_t i: Which username; distinct below 26^5.
+Description of Return Values:
+  - Returns the username.
+*/
+static std::string syntheticUsername(std::uint64_t i) {
+    std::string username = "U_";
+    for (int k = 0; k < 5; ++k) {
+        username += static_cast<char>('a' + i % 26);
+        i /= 26;
+    }
+    username += std::to_string(100 + i % 900);
+    return username;
+}
+
+/*
+Function Name: syntheticCard
+Purpose: Makes the i-th of a run of distinct credit card numbers in the "XXXX-XXXX-XXXX" format.
+Meaning of Parameters:
+  - std::uint64_t i: Which card number.
+Description of Return Values:
+  - Returns the card number.
+*/
+static std::string syntheticCard(std::uint64_t i) {
+    std::string digits = std::to_string(100000000000ULL + i * 7919);
+    return digits.substr(0, 4) + "-" + digits.substr(4, 4) + "-" + digits.substr(8, 4);
+}
+
+/*
+Function Name: timeUnorderedStrings
+Purpose: Times filling a std::unordered_set<std::string> and looking up keys that are and are not in it, and measures its heap use.
+Meaning of Parameters:
+  - const char* label: The name printed for the row.
+  - const std::vector<std::string>& keys: The keys to insert.
+  - const std::vector<std::string>& hits: The same keys in another order, to look up.
+  - const std::vector<std::string>& missing: Keys that are not in the set.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeUnorderedStrings(const char* label, const std::vector<std::string>& keys, const std::vector<std::string>& hits, const std::vector<std::string>& missing) {
+    std::size_t heapBefore = heapBytesInUse();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::unordered_set<std::string> set;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        set.insert(keys[i]);
+    }
+    double insertSeconds = secondsSince(start);
+    std::size_t bytes = heapBytesInUse() - heapBefore;
+
+    std::size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+        found += set.count(hits[i]);
+    }
+    double hitSeconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        found += set.count(missing[i]);
+    }
+    std::printf("  %-36s %7.1f ms insert %7.1f ms hit %7.1f ms miss %6.1f bytes/key (%zu found)\n", label, insertSeconds * 1e3, hitSeconds * 1e3, secondsSince(start) * 1e3, static_cast<double>(bytes) / keys.size(), found);
+}
+
+/*
+Function Name: timeFlatStrings
+Purpose: Times filling a FlatSet of 16-byte keys and looking up keys that are and are not in it, and measures its heap use.
+Meaning of Parameters:
+  - const char* label: The name printed for the row.
+  - const std::vector<std::string>& keys: The keys to insert.
+  - const std::vector<std::string>& hits: The same keys in another order, to look up.
+  - const std::vector<std::string>& missing: Keys that are not in the set.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeFlatStrings(const char* label, const std::vector<std::string>& keys, const std::vector<std::string>& hits, const std::vector<std::string>& missing) {
+    std::size_t heapBefore = heapBytesInUse();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    FlatSet set(FlatSet::maxKeyWidth);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        set.insert(keys[i]);
+    }
+    double insertSeconds = secondsSince(start);
+    std::size_t bytes = heapBytesInUse() - heapBefore;
+
+    std::size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+        found += set.contains(hits[i]) ? 1 : 0;
+    }
+    double hitSeconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        found += set.contains(missing[i]) ? 1 : 0;
+    }
+    std::printf("  %-36s %7.1f ms insert %7.1f ms hit %7.1f ms miss %6.1f bytes/key (%zu found)\n", label, insertSeconds * 1e3, hitSeconds * 1e3, secondsSince(start) * 1e3, static_cast<double>(bytes) / keys.size(), found);
+}
+
+/*
+Function Name: timeUnorderedIds
+Purpose: Times filling a std::unordered_set<CustomerId> and looking up IDs that are and are not in it, and measures its heap use.
+Meaning of Parameters:
+  - const std::vector<std::uint64_t>& numbers: The ID numbers to insert; the numbers one above them are not in the set.
+  - const std::vector<std::uint64_t>& hits: The same numbers in another order, to look up.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeUnorderedIds(const std::vector<std::uint64_t>& numbers, const std::vector<std::uint64_t>& hits) {
+    std::size_t heapBefore = heapBytesInUse();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::unordered_set<CustomerId> set;
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        set.insert(static_cast<CustomerId>(numbers[i]));
+    }
+    double insertSeconds = secondsSince(start);
+    std::size_t bytes = heapBytesInUse() - heapBefore;
+
+    std::size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        found += set.count(static_cast<CustomerId>(hits[i]));
+    }
+    double hitSeconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        found += set.count(static_cast<CustomerId>(hits[i] + 1));
+    }
+    std::printf("  %-36s %7.1f ms insert %7.1f ms hit %7.1f ms miss %6.1f bytes/key (%zu found)\n", "unordered_set<CustomerId>", insertSeconds * 1e3, hitSeconds * 1e3, secondsSince(start) * 1e3, static_cast<double>(bytes) / numbers.size(), found);
+}
+
+/*
+Function Name: timeFlatIds
+Purpose: Times filling a FlatSet of customer IDs and looking up IDs that are and are not in it, and measures its heap use.
+Meaning of Parameters:
+  - const std::vector<std::uint64_t>& numbers: The ID numbers to insert; the numbers one above them are not in the set.
+  - const std::vector<std::uint64_t>& hits: The same numbers in another order, to look up.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeFlatIds(const std::vector<std::uint64_t>& numbers, const std::vector<std::uint64_t>& hits) {
+    std::size_t heapBefore = heapBytesInUse();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    FlatSet set(sizeof(std::uint64_t));
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        set.insert(static_cast<CustomerId>(numbers[i]));
+    }
+    double insertSeconds = secondsSince(start);
+    std::size_t bytes = heapBytesInUse() - heapBefore;
+
+    std::size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        found += set.contains(static_cast<CustomerId>(hits[i])) ? 1 : 0;
+    }
+    double hitSeconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        found += set.contains(static_cast<CustomerId>(hits[i] + 1)) ? 1 : 0;
+    }
+    std::printf("  %-36s %7.1f ms insert %7.1f ms hit %7.1f ms miss %6.1f bytes/key (%zu found)\n", "FlatSet, CustomerId", insertSeconds * 1e3, hitSeconds * 1e3, secondsSince(start) * 1e3, static_cast<double>(bytes) / numbers.size(), found);
+}
+
+/*
+Function Name: benchmarkFlatSet
+Purpose: Compares FlatSet with std::unordered_set on the keys the global tables hold: usernames, credit card numbers and customer IDs.
+Meaning of Parameters:
+  - int count: How many keys of each kind to use.
+Description of Return Values:
+  - This function does not return a value. Each row reports the number of keys found, which should equal the count.
+*/
+static void benchmarkFlatSet(int count) {
+    std::cout << "Flat set (" << count << " keys, looked up in shuffled order, as many misses):\n";
+    std::mt19937 random(12345);
+    std::vector<std::string> keys(count);
+    std::vector<std::string> missing(count);
+    for (int i = 0; i < count; ++i) {
+        keys[i] = syntheticUsername(i);
+        missing[i] = syntheticUsername(count + i);
+    }
+    // Looking keys up in the order they went in would walk std::unordered_set's nodes in allocation order, which real lookups never do
+    std::vector<std::string> hits(keys);
+    std::shuffle(hits.begin(), hits.end(), random);
+    timeUnorderedStrings("unordered_set<std::string>, usernames", keys, hits, missing);
+    timeFlatStrings("FlatSet, usernames", keys, hits, missing);
+
+    for (int i = 0; i < count; ++i) {
+        keys[i] = syntheticCard(i);
+        missing[i] = syntheticCard(count + i);
+    }
+    hits = keys;
+    std::shuffle(hits.begin(), hits.end(), random);
+    timeUnorderedStrings("unordered_set<std::string>, cards", keys, hits, missing);
+    timeFlatStrings("FlatSet, cards", keys, hits, missing);
+
+    std::vector<std::uint64_t> numbers(count);
+    for (int i = 0; i < count; ++i) {
+        numbers[i] = 1000000000ULL + static_cast<std::uint64_t>(i) * 7919;
+    }
+    std::vector<std::uint64_t> numberHits(numbers);
+    std::shuffle(numberHits.begin(), numberHits.end(), random);
+    timeUnorderedIds(numbers, numberHits);
+    timeFlatIds(numbers, numberHits);
+}
+
+/*
+****************************************************************************
+***************************** FLAT SET BENCHMARK END ***********************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+************************** BLOOM FILTER BENCHMARK START ********************
+****************************************************************************
+*/
+
+static const char benchmarkBloomFile[] = "benchmark.bloom";
+
+/*
+Function Name: timeBloomFilter
+Purpose: Fills a filter file sized for a given false positive rate with credit card numbers, then checks as many numbers that were never added and counts how many it fails to rule out.
+Meaning of Parameters:
+  - double rate: The false positive rate to size the filter for.
+  - const std::vector<std::string>& keys: The keys to add.
+  - const std::vector<std::string>& missing: Keys that were not added.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeBloomFilter(double rate, const std::vector<std::string>& keys, const std::vector<std::string>& missing) {
+    std::remove(benchmarkBloomFile);
+    BloomFilter filter(benchmarkBloomFile, rate);
+    filter.create(keys.size());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        filter.add(keys[i]);
+    }
+    double addSeconds = secondsSince(start);
+
+    std::size_t possibleHits = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        possibleHits += filter.mightContain(missing[i]) ? 1 : 0;
+    }
+    double checkSeconds = secondsSince(start);
+    BloomFilterStats stats = filter.stats();
+    std::printf("  sized for %5.3f%%  %7.1f ms add %7.1f ms check %6.1f bytes/key, %u hashes, %.3f%% false positives (expected %.3f%%)\n",
+                rate * 100, addSeconds * 1e3, checkSeconds * 1e3, stats.bitCount / 8.0 / keys.size(), stats.hashCount,
+                100.0 * possibleHits / missing.size(), stats.expectedRate * 100);
+}
+
+/*
+Function Name: benchmarkBloomFilter
+Purpose: Times the credit card filter at two false positive rates and checks that the rate it delivers matches the one it was sized for.
+Meaning of Parameters:
+  - int count: How many card numbers to add, and how many absent ones to check.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkBloomFilter(int count) {
+    std::cout << "Bloom filter (" << count << " credit cards, as many absent ones checked):\n";
+    std::vector<std::string> keys(count);
+    std::vector<std::string> missing(count);
+    for (int i = 0; i < count; ++i) {
+        keys[i] = syntheticCard(i);
+        missing[i] = syntheticCard(count + i);
+    }
+    timeBloomFilter(0.01, keys, missing);
+    timeBloomFilter(0.001, keys, missing);
+    std::remove(benchmarkBloomFile);
+}
+
+/*
+****************************************************************************
+*************************** BLOOM FILTER BENCHMARK END *********************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+************************** THREAD POOL BENCHMARK START *********************
+****************************************************************************
+*/
+
+static const std::size_t benchmarkProductCount = 64;
+static const std::size_t purchasesPerTask = 64;
+
+// One pool task: buys one unit of each of purchasesPerTask products in turn, starting at `first`
+struct PurchaseTask {
+    InventoryCount* inventory;
+    std::size_t first;
+};
+
+/*
+Function Name: buyProducts
+Purpose: Runs one PurchaseTask on a pool worker.
+Meaning of Parameters:
+  - void* argument: The PurchaseTask.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void buyProducts(void* argument) {
+    PurchaseTask* task = static_cast<PurchaseTask*>(argument);
+    for (std::size_t i = 0; i < purchasesPerTask; ++i) {
+        task->inventory[(task->first + i) % benchmarkProductCount].take(1);
+    }
+}
+
+/*
+Function Name: timeThreadPool
+Purpose: Runs the purchase tasks on a pool of the given size against shared per-product counts, and checks that no unit was lost or taken twice.
+Meaning of Parameters:
+  - std::size_t threadCount: The pool size; 0 uses one thread per CPU core.
+  - int taskCount: How many tasks to submit.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeThreadPool(std::size_t threadCount, int taskCount) {
+    const int stock = 1 << 30;
+    std::vector<InventoryCount> inventory(benchmarkProductCount, InventoryCount(stock));
+    std::vector<PurchaseTask> tasks(taskCount);
+    WorkStealingPool pool(threadCount);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < taskCount; ++i) {
+        tasks[i].inventory = inventory.data();
+        tasks[i].first = static_cast<std::size_t>(i);
+        PoolTask task;
+        task.run = buyProducts;
+        task.argument = &tasks[i];
+        pool.submit(task);
+    }
+    pool.wait();
+    double seconds = secondsSince(start);
+
+    std::uint64_t taken = 0;
+    for (std::size_t i = 0; i < inventory.size(); ++i) {
+        taken += static_cast<std::uint64_t>(stock - inventory[i]);
+    }
+    PoolStats stats = pool.stats();
+    std::printf("  %3zu thread(s) %7.1f ms %10.0f tasks/s, %llu stolen, %s\n", stats.threads, seconds * 1e3, taskCount / seconds,
+                static_cast<unsigned long long>(stats.stolen), (taken == taskCount * purchasesPerTask) ? "inventory exact" : "INVENTORY MISMATCH");
+}
+
+/*
+Function Name: benchmarkThreadPool
+Purpose: Times the work-stealing pool with one thread and with one per CPU core, running purchases that all draw on the same few products.
+Meaning of Parameters:
+  - int count: How many tasks to run.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkThreadPool(int count) {
+    std::cout << "Work-stealing pool (" << count << " tasks of " << purchasesPerTask << " purchases across " << benchmarkProductCount
+              << " products):\n";
+    timeThreadPool(1, count);
+    timeThreadPool(0, count);
+}
+
+/*
+****************************************************************************
+*************************** THREAD POOL BENCHMARK END **********************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+************************ TRANSACTION LOG BENCHMARK START *******************
+****************************************************************************
+*/
+
+static const char benchmarkTransactionFile[] = "benchmark_transactions.txt";
+
+/*
+Function Name: appendRecords
+Purpose: Appends copies of a record to a transaction log one at a time, as one purchase after another on a server thread would.
+Meaning of Parameters:
+  - TransactionLog* log: The log.
+  - int count: How many records to append.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void appendRecords(TransactionLog* log, int count) {
+    std::string record = "Transaction 1\n\tTransaction ID: Transaction1000000\n\tUser ID: 1000000000\n\tProducts Purchased:\n"
+                         "\t\tProduct ID: 10000\n\t\tProduct Name: Benchmark\n\t\tQuantity: 1\n\tTotal Amount: $1.00\n\n";
+    for (int i = 0; i < count; ++i) {
+        log->append(record, 0);
+    }
+}
+
+/*
+Function Name: timeTransactionLog
+Purpose: Appends records from several threads at once to a fresh log, each durable before its append returns, and reports how the log grouped them into commits.
+Meaning of Parameters:
+  - int threadCount: How many threads append.
+  - int recordsPerThread: How many records each thread appends.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void timeTransactionLog(int threadCount, int recordsPerThread) {
+    std::remove(benchmarkTransactionFile);
+    TransactionLog log(benchmarkTransactionFile);
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < threadCount; ++i) {
+        threads.push_back(std::thread(appendRecords, &log, recordsPerThread));
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+    double seconds = secondsSince(start);
+    log.close();
+
+    TransactionLogStats stats = log.stats();
+    std::printf("  %3d thread(s) %8.1f ms %9.0f records/s, %llu fdatasyncs\n", threadCount, seconds * 1e3, stats.appends / seconds,
+                static_cast<unsigned long long>(stats.commits));
+    std::cout << "    records per commit: " << stats.batchSizes.describe() << "\n"
+              << "    latency (us): " << stats.commitLatency.describe() << "\n";
+    std::remove(benchmarkTransactionFile);
+}
+
+/*
+Function Name: benchmarkTransactionLog
+Purpose: Times durable appends to the transaction log from one thread, where every record pays for its own fdatasync, and from several, where records that arrive during a commit share the next one.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkTransactionLog() {
+    const int records = 2000;
+    std::cout << "Transaction log group commit (" << records << " records, writev + fdatasync per commit):\n";
+    timeTransactionLog(1, records);
+    timeTransactionLog(8, records / 8);
+    timeTransactionLog(32, records / 32);
+}
+
+/*
+****************************************************************************
+************************* TRANSACTION LOG BENCHMARK END ********************
+****************************************************************************
+*/
+
+/*
+****************************************************************************
+************************* DURABLE FILE BENCHMARK START *********************
+****************************************************************************
+*/
+
+static const char benchmarkRewriteFile[] = "benchmark_rewrite.txt";
+
+/*
+Function Name: sampleProductText
+Purpose: Formats a product file of the given size, in the layout of "products.txt".
+Meaning of Parameters:
+  - int count: How many product records to format.
+Description of Return Values:
+  - Returns one formatted record per product.
+*/
+static std::vector<std::string> sampleProductText(int count) {
+    std::vector<std::string> records(count);
+    for (int i = 0; i < count; ++i) {
+        records[i] = "Product " + std::to_string(i + 1) + "\n\tProduct ID: " + std::to_string(10000 + i) +
+                     "\n\tProduct Name: Benchmark product\n\tPrice: $4.99\n\tInventory: 1000\n";
+    }
+    return records;
+}
+
+/*
+Function Name: timeTruncatingRewrite
+Purpose: Rewrites a file the way the data files used to be saved: truncated in place and streamed into record by record, with no sync.
+Meaning of Parameters:
+  - const std::vector<std::string>& records: The records to write.
+  - int rewrites: How many times to rewrite the file.
+Description of Return Values:
+  - Returns the average time of one rewrite in microseconds.
+*/
+static double timeTruncatingRewrite(const std::vector<std::string>& records, int rewrites) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < rewrites; ++pass) {
+        std::ofstream outfile(benchmarkRewriteFile, std::ios::trunc);
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            outfile << records[i];
+        }
+    }
+    return secondsSince(start) * 1e6 / rewrites;
+}
+
+/*
+Function Name: timeDurableReplace
+Purpose: Rewrites a file through replaceFile: formatted into one buffer, written once to a temporary file, synced, renamed and the directory synced.
+Meaning of Parameters:
+  - const std::vector<std::string>& records: The records to write.
+  - int rewrites: How many times to rewrite the file.
+Description of Return Values:
+  - Returns the average time of one rewrite in microseconds.
+*/
+static double timeDurableReplace(const std::vector<std::string>& records, int rewrites) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < rewrites; ++pass) {
+        std::string contents;
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            contents += records[i];
+        }
+        replaceFile(benchmarkRewriteFile, contents);
+    }
+    return secondsSince(start) * 1e6 / rewrites;
+}
+
+/*
+Function Name: benchmarkDurableFile
+Purpose: Times rewriting a small product file, as every purchase does, and a large one both ways: truncating in place, and replacing the file crash-safely.
+Meaning of Parameters:
+  - int count: How many records the large file holds.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void benchmarkDurableFile(int count) {
+    std::cout << "Data file rewrite (truncate in place vs temporary file + fdatasync + rename + directory fsync):\n";
+    std::vector<std::string> small = sampleProductText(50);
+    std::vector<std::string> large = sampleProductText(count);
+    std::printf("  %-28s %10.1f us %10.1f us\n", "50 records", timeTruncatingRewrite(small, 500), timeDurableReplace(small, 500));
+    std::printf("  %-28s %10.1f us %10.1f us\n", (std::to_string(count) + " records").c_str(), timeTruncatingRewrite(large, 10),
+                timeDurableReplace(large, 10));
+    std::remove(benchmarkRewriteFile);
+}
+
+/*
+****************************************************************************
+************************** DURABLE FILE BENCHMARK END **********************
+****************************************************************************
+*/
+
+/*
+Function Name: main
+Purpose: Runs the benchmarks. They write their scratch files into the current directory and remove them afterwards.
+Meaning of Parameters:
+  - int argc: The number of command line arguments.
+  - char* argv[]: An optional record count; the default is 200000.
+Description of Return Values:
+  - Returns 0 when the benchmarks have run.
+*/
+int main(int argc, char* argv[]) {
+    int count = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    if (count <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [record count]\n";
+        return 1;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    benchmarkRecordParser(count);
+    benchmarkRewardRules();
+    benchmarkRewardBatch();
+    benchmarkMoney();
+    benchmarkIdGenerator();
+    benchmarkRecordIds(count);
+    benchmarkFlatSet(count);
+    benchmarkBloomFilter(count);
+    benchmarkThreadPool(count);
+    benchmarkTransactionLog();
+    benchmarkDurableFile(count);
+    return 0;
+}
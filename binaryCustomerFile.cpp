@@ -0,0 +1,405 @@
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include "binaryCustomerFile.h"
+#include "customerStore.h"
+#include "durableFile.h"
+
+/*
+****************************************************************************
+*********************** BINARY CUSTOMER FILE START *************************
+****************************************************************************
+*/
+
+static const char binaryCustomerMagic[4] = { 'C', 'R', 'B', 'N' };
+static const std::uint32_t binaryCustomerVersion = 1;
+
+/*
+Function Name: copyFixedField
+Purpose: Copies a text value into a fixed-width, zero-padded field of a binary customer record.
+Meaning of Parameters:
+  - char* field: The destination field.
+  - std::size_t width: The width of the destination field in bytes.
+  - const std::string& value: The text to store.
+Description of Return Values:
+  - Returns `true` if the value fits in the field.
+  - Returns `false` if the value is longer than the field; the field is left unchanged in that case.
+*/
+static bool copyFixedField(char* field, std::size_t width, const std::string& value) {
+    if (value.size() > width) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::memset(field, 0, width);
+    std::memcpy(field, value.data(), value.size());
+    return true;
+}
+
+/*
+Function Name: readFixedField
+Purpose: Reads a text value back out of a fixed-width, zero-padded field of a binary customer record.
+Meaning of Parameters:
+  - const char* field: The source field.
+  - std::size_t width: The width of the source field in bytes.
+Description of Return Values:
+  - Returns the stored text without its padding.
+*/
+static std::string readFixedField(const char* field, std::size_t width) {
+    return std::string(field, strnlen(field, width));
+}
+
+/*
+Function Name: toBinarySlot
+Purpose: Converts a customer record into its fixed-width binary layout.
+Meaning of Parameters:
+  - const CustomerRecord& record: The record to convert.
+  - BinaryCustomerSlot& slot: Receives the binary layout.
+Description of Return Values:
+  - Returns `true` if every text field fits its fixed width.
+  - Returns `false` and outputs an error message if a field is too long.
+*/
+static bool toBinarySlot(const CustomerRecord& record, BinaryCustomerSlot& slot) {
+    std::memset(&slot, 0, sizeof(slot));
+    bool fits = copyFixedField(slot.userID, sizeof(slot.userID), formatId(record.userID)) &&
+                copyFixedField(slot.username, sizeof(slot.username), record.username) &&
+                copyFixedField(slot.firstName, sizeof(slot.firstName), record.firstName) &&
+                copyFixedField(slot.lastName, sizeof(slot.lastName), record.lastName) &&
+                copyFixedField(slot.creditCard, sizeof(slot.creditCard), record.creditCard);
+    if (!fits) {
+        std::cerr << "Error: Customer " << formatId(record.userID) << " has a field too long for the binary format.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    slot.customerNumber = record.customerNumber;
+    slot.age = record.age;
+    slot.rewardPoints = record.rewardPoints;
+    return true;
+}
+
+/*
+Function Name: fromBinarySlot
+Purpose: Converts a fixed-width binary customer record back into a customer record.
+Meaning of Parameters:
+  - const BinaryCustomerSlot& slot: The binary layout to convert.
+Description of Return Values:
+  - Returns the equivalent customer record.
+*/
+static CustomerRecord fromBinarySlot(const BinaryCustomerSlot& slot) {
+    CustomerRecord record;
+    record.customerNumber = slot.customerNumber;
+    parseCustomerId(readFixedField(slot.userID, sizeof(slot.userID)), record.userID);
+    record.username = readFixedField(slot.username, sizeof(slot.username));
+    record.firstName = readFixedField(slot.firstName, sizeof(slot.firstName));
+    record.lastName = readFixedField(slot.lastName, sizeof(slot.lastName));
+    record.age = slot.age;
+    record.creditCard = readFixedField(slot.creditCard, sizeof(slot.creditCard));
+    record.rewardPoints = slot.rewardPoints;
+    record.deleted = (slot.flags & binaryCustomerDeleted) != 0;
+    return record;
+}
+
+/*
+Function Name: slotOffset
+Purpose: Computes the byte offset of a record slot in the binary customer file.
+Meaning of Parameters:
+  - std::size_t slot: The zero-based record number.
+Description of Return Values:
+  - Returns the offset of the first byte of that record.
+*/
+static off_t slotOffset(std::size_t slot) {
+    return static_cast<off_t>(sizeof(BinaryCustomerHeader) + slot * sizeof(BinaryCustomerSlot));
+}
+
+/*
+Method Name: ~BinaryCustomerFile
+Purpose: Closes the file descriptor when the binary customer file goes out of scope.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+BinaryCustomerFile::~BinaryCustomerFile() {
+    close();
+}
+
+/*
+Method Name: open
+Purpose: Opens an existing binary customer file for reading and in-place updates, and validates its header.
+Meaning of Parameters:
+  - const std::string& fileName: The binary customer file, normally "customers.bin".
+Description of Return Values:
+  - Returns `true` if the file was opened and its header is valid.
+  - Returns `false` and outputs an error message if the file cannot be opened or is not a customer file of this version.
+*/
+bool BinaryCustomerFile::open(const std::string& fileName) {
+    close();
+    fd = ::open(fileName.c_str(), O_RDWR);
+    BinaryCustomerHeader header;
+    if (fd < 0 || ::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        std::cerr << "Error: Could not open " << fileName << " file.\n";
+        close();
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    bool valid = std::memcmp(header.magic, binaryCustomerMagic, sizeof(header.magic)) == 0 &&
+                 header.version == binaryCustomerVersion &&
+                 header.recordSize == sizeof(BinaryCustomerSlot);
+    if (!valid) {
+        std::cerr << "Error: " << fileName << " is not a version " << binaryCustomerVersion << " customer file.\n";
+        close();
+        return false;
+    } else {
+        recordCount = header.recordCount;
+    }
+
+    return true;
+}
+
+/*
+Method Name: create
+Purpose: Writes a new binary customer file holding the given records, replacing any existing file, and leaves it open.
+Meaning of Parameters:
+  - const std::string& fileName: The binary customer file to write.
+  - const std::vector<CustomerRecord>& records: The customer records to store, in slot order. Records flagged `deleted` are left out.
+Description of Return Values:
+  - Returns `true` if the file was written and reopened.
+  - Returns `false` and outputs an error message if a record does not fit the format or the file cannot be written.
+*/
+bool BinaryCustomerFile::create(const std::string& fileName, const std::vector<CustomerRecord>& records) {
+    std::vector<BinaryCustomerSlot> slots;
+    BinaryCustomerSlot slot;
+    slots.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (records[i].deleted) {
+            continue;
+        } else if (!toBinarySlot(records[i], slot)) {
+            return false;
+        } else {
+            slots.push_back(slot);
+        }
+    }
+
+    BinaryCustomerHeader header;
+    std::memcpy(header.magic, binaryCustomerMagic, sizeof(header.magic));
+    header.version = binaryCustomerVersion;
+    header.recordSize = sizeof(BinaryCustomerSlot);
+    header.recordCount = static_cast<std::uint32_t>(slots.size());
+
+    std::string contents(reinterpret_cast<const char*>(&header), sizeof(header));
+    contents.append(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(BinaryCustomerSlot));
+    if (!replaceFile(fileName, contents)) {
+        return false;
+    } else {
+        return open(fileName);
+    }
+}
+
+/*
+Method Name: readAll
+Purpose: Reads every record from the open binary customer file.
+Meaning of Parameters:
+  - std::vector<CustomerRecord>& records: Receives the records in slot order; any previous contents are replaced.
+Description of Return Values:
+  - Returns `true` if all records were read.
+  - Returns `false` if the file is not open or is shorter than its header claims.
+*/
+bool BinaryCustomerFile::readAll(std::vector<CustomerRecord>& records) const {
+    std::vector<BinaryCustomerSlot> slots(recordCount);
+    std::size_t bytes = slots.size() * sizeof(BinaryCustomerSlot);
+    if (fd < 0 || ::pread(fd, slots.data(), bytes, slotOffset(0)) != static_cast<ssize_t>(bytes)) {
+        std::cerr << "Error: Binary customer file is truncated or not open.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    records.clear();
+    records.reserve(slots.size());
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        records.push_back(fromBinarySlot(slots[i]));
+    }
+    return true;
+}
+
+/*
+Method Name: append
+Purpose: Writes a new record after the last slot and bumps the record count in the header.
+Meaning of Parameters:
+  - const CustomerRecord& record: The customer record to add.
+Description of Return Values:
+  - Returns `true` if the record and the new count were written.
+  - Returns `false` and outputs an error message if the record does not fit the format or a write fails.
+*/
+bool BinaryCustomerFile::append(const CustomerRecord& record) {
+    BinaryCustomerSlot slot;
+    if (fd < 0 || !toBinarySlot(record, slot)) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::uint32_t newCount = recordCount + 1;
+    bool written = ::pwrite(fd, &slot, sizeof(slot), slotOffset(recordCount)) == static_cast<ssize_t>(sizeof(slot)) &&
+                   ::pwrite(fd, &newCount, sizeof(newCount), offsetof(BinaryCustomerHeader, recordCount)) == static_cast<ssize_t>(sizeof(newCount));
+    if (!written) {
+        std::cerr << "Error: Could not append to the binary customer file.\n";
+        return false;
+    } else {
+        recordCount = newCount;
+    }
+    return true;
+}
+
+/*
+Method Name: writeRewardPoints
+Purpose: Updates one customer's reward balance in place with a single 4-byte positional write.
+Meaning of Parameters:
+  - std::size_t slot: The zero-based record number of the customer.
+  - int rewardPoints: The new reward point balance.
+Description of Return Values:
+  - Returns `true` if the balance was written.
+  - Returns `false` and outputs an error message if the slot is out of range or the write fails.
+*/
+bool BinaryCustomerFile::writeRewardPoints(std::size_t slot, int rewardPoints) {
+    std::int32_t value = rewardPoints;
+    off_t offset = slotOffset(slot) + static_cast<off_t>(offsetof(BinaryCustomerSlot, rewardPoints));
+    if (fd < 0 || slot >= recordCount || ::pwrite(fd, &value, sizeof(value), offset) != static_cast<ssize_t>(sizeof(value))) {
+        std::cerr << "Error: Could not update reward points in the binary customer file.\n";
+        return false;
+    } else {
+        return true;
+    }
+}
+
+/*
+Method Name: markDeleted
+Purpose: Marks one customer as removed by setting the tombstone bit in its flags with a single 4-byte positional write. The slot stays in place until the file is compacted.
+Meaning of Parameters:
+  - std::size_t slot: The zero-based record number of the customer.
+Description of Return Values:
+  - Returns `true` if the flag was written.
+  - Returns `false` and outputs an error message if the slot is out of range or the write fails.
+*/
+bool BinaryCustomerFile::markDeleted(std::size_t slot) {
+    std::uint32_t flags = binaryCustomerDeleted;
+    off_t offset = slotOffset(slot) + static_cast<off_t>(offsetof(BinaryCustomerSlot, flags));
+    if (fd < 0 || slot >= recordCount || ::pwrite(fd, &flags, sizeof(flags), offset) != static_cast<ssize_t>(sizeof(flags))) {
+        std::cerr << "Error: Could not remove the customer from the binary customer file.\n";
+        return false;
+    } else {
+        return true;
+    }
+}
+
+/*
+Method Name: close
+Purpose: Closes the binary customer file if it is open.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void BinaryCustomerFile::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    recordCount = 0;
+}
+
+/*
+Method Name: isOpen
+Purpose: Reports whether a binary customer file is currently open.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the file is open.
+*/
+bool BinaryCustomerFile::isOpen() const {
+    return fd >= 0;
+}
+
+/*
+Function Name: importCustomersToBinary
+Purpose: Converts a text customer file in the Account::toString layout into a binary customer file, after folding the reward ledger into it.
+Meaning of Parameters:
+  - const std::string& textFileName: The text customer file to read, normally "customers.txt".
+  - const std::string& binaryFileName: The binary customer file to create, normally "customers.bin".
+Description of Return Values:
+  - Returns `true` if every record was converted.
+  - Returns `false` and outputs an error message if the text file cannot be read or the binary file cannot be written.
+*/
+bool importCustomersToBinary(const std::string& textFileName, const std::string& binaryFileName) {
+    CustomerStore textStore;
+    if (!textStore.load(textFileName)) {
+        std::cerr << "Error: Could not open " << textFileName << " file.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    // Fold pending reward ledger entries into the text file first, so they are neither lost nor replayed again after an export
+    if (textStore.openLedger("rewardsLedger.txt") && !textStore.save()) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    BinaryCustomerFile binaryFile;
+    if (!binaryFile.create(binaryFileName, textStore.all())) {
+        return false;
+    } else {
+        std::cout << "Imported " << textStore.size() << " customers into " << binaryFileName << ".\n";
+    }
+    return true;
+}
+
+/*
+Function Name: exportCustomersToText
+Purpose: Converts a binary customer file back into the text layout produced by Account::toString.
+Meaning of Parameters:
+  - const std::string& binaryFileName: The binary customer file to read, normally "customers.bin".
+  - const std::string& textFileName: The text customer file to write, normally "customers.txt".
+Description of Return Values:
+  - Returns `true` if every record was written.
+  - Returns `false` and outputs an error message if the binary file cannot be read or the text file cannot be written.
+*/
+bool exportCustomersToText(const std::string& binaryFileName, const std::string& textFileName) {
+    BinaryCustomerFile binaryFile;
+    std::vector<CustomerRecord> records;
+    if (!binaryFile.open(binaryFileName) || !binaryFile.readAll(records)) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::string contents;
+    std::size_t exported = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        contents += records[i].deleted ? "" : formatCustomerRecord(records[i]);
+        exported += records[i].deleted ? 0 : 1;
+    }
+    if (!replaceFile(textFileName, contents)) {
+        return false;
+    } else {
+        std::cout << "Exported " << exported << " customers to " << textFileName << ".\n";
+    }
+    return true;
+}
+
+/*
+****************************************************************************
+************************ BINARY CUSTOMER FILE END **************************
+****************************************************************************
+*/
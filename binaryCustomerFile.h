@@ -0,0 +1,63 @@
+#ifndef BINARYCUSTOMERFILE_H
+#define BINARYCUSTOMERFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct CustomerRecord;
+
+/* Declarations for the fixed-width binary customer file (customers.bin) */
+
+// File header. All integers are stored in host byte order.
+struct BinaryCustomerHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint32_t recordCount;
+};
+
+// One customer record. Text fields are padded with '\0' and are not terminated when full.
+struct BinaryCustomerSlot {
+    char userID[16];
+    char username[16];
+    char firstName[16];
+    char lastName[16];
+    char creditCard[16];
+    std::int32_t customerNumber;
+    std::int32_t age;
+    std::int32_t rewardPoints;
+    std::uint32_t flags;
+};
+
+// Bits of BinaryCustomerSlot::flags
+static const std::uint32_t binaryCustomerDeleted = 1; // Tombstone: the customer was removed
+
+static_assert(sizeof(BinaryCustomerHeader) == 16, "binary customer header must be 16 bytes");
+static_assert(sizeof(BinaryCustomerSlot) == 96, "binary customer record must be 96 bytes");
+
+class BinaryCustomerFile {
+public:
+    BinaryCustomerFile() = default;
+    BinaryCustomerFile(const BinaryCustomerFile&) = delete;
+    BinaryCustomerFile& operator=(const BinaryCustomerFile&) = delete;
+    ~BinaryCustomerFile();
+
+    bool open(const std::string& fileName);
+    bool create(const std::string& fileName, const std::vector<CustomerRecord>& records);
+    bool readAll(std::vector<CustomerRecord>& records) const;
+    bool append(const CustomerRecord& record);
+    bool writeRewardPoints(std::size_t slot, int rewardPoints);
+    bool markDeleted(std::size_t slot);
+    void close();
+    bool isOpen() const;
+
+private:
+    int fd = -1;
+    std::uint32_t recordCount = 0;
+};
+
+bool importCustomersToBinary(const std::string& textFileName, const std::string& binaryFileName);
+bool exportCustomersToText(const std::string& binaryFileName, const std::string& textFileName);
+
+#endif // BINARYCUSTOMERFILE_H
@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "bloomFilter.h"
+
+/*
+****************************************************************************
+**************************** BLOOM FILTER START ****************************
+****************************************************************************
+*/
+
+// The layout of the start of a filter file; the bits follow it, 64 to a word
+struct BloomFilterHeader {
+    char magic[8];
+    std::uint64_t bitCount;
+    std::uint64_t capacity;
+    std::uint64_t keyCount;
+    std::uint64_t queries;
+    std::uint64_t possibleHits;
+    std::uint64_t falsePositives;
+    std::uint32_t hashCount;
+    std::uint32_t ratePerMillion;
+};
+
+static const char bloomMagic[8] = { 'B', 'L', 'O', 'O', 'M', '0', '1', '\n' };
+static const std::uint64_t minimumCapacity = 65536;
+static const double ln2 = 0.69314718055994530942;
+
+/*
+Function Name: mixHash
+Purpose: Scrambles a 64-bit value (the splitmix64 finaliser).
+Meaning of Parameters:
+  - std::uint64_t value: The value to scramble.
+Description of Return Values:
+  - Returns the scrambled value; every input bit affects every output bit.
+*/
+static std::uint64_t mixHash(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/*
+Function Name: hashText
+Purpose: Hashes a key 8 bytes at a time. The hash is stored implicitly in every filter file, so it must never change.
+Meaning of Parameters:
+  - std::string_view text: The key.
+Description of Return Values:
+  - Returns the 64-bit hash.
+*/
+static std::uint64_t hashText(std::string_view text) {
+    std::uint64_t hash = 0x9E3779B97F4A7C15ULL ^ text.size();
+    for (std::size_t i = 0; i < text.size(); i += sizeof(std::uint64_t)) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, text.data() + i, std::min(sizeof(word), text.size() - i));
+        hash = mixHash(hash ^ word);
+    }
+    return hash;
+}
+
+/*
+Function Name: bitPosition
+Purpose: Picks the i-th bit for a key by double hashing: h1 + i * h2, scaled onto the filter with a multiply instead of a division.
+Meaning of Parameters:
+  - std::uint64_t hash: The key's hash (h1).
+  - std::uint64_t step: The second hash (h2), derived from the first.
+  - std::uint32_t i: Which of the filter's hash functions this is.
+  - std::uint64_t bitCount: The number of bits in the filter.
+Description of Return Values:
+  - Returns a bit number below bitCount.
+*/
+static std::uint64_t bitPosition(std::uint64_t hash, std::uint64_t step, std::uint32_t i, std::uint64_t bitCount) {
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(hash + i * step) * bitCount) >> 64);
+}
+
+/*
+Method Name: BloomFilter
+Purpose: Names the filter's file and the false positive rate to size it for. Nothing is mapped until open or create.
+Meaning of Parameters:
+  - const std::string& fileName: The filter file, e.g. "usernames.bloom".
+  - double falsePositiveRate: The rate to size a new filter for, e.g. 0.01; an existing file keeps the rate it was built with.
+Description of Return Values:
+  - None.
+*/
+BloomFilter::BloomFilter(const std::string& fileName, double falsePositiveRate) : fileName(fileName), falsePositiveRate(0.01) {
+    setFalsePositiveRate(falsePositiveRate);
+}
+
+/*
+Method Name: ~BloomFilter
+Purpose: Unmaps the filter; the kernel writes any changed pages back to the file.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+BloomFilter::~BloomFilter() {
+    close();
+}
+
+/*
+Method Name: map
+Purpose: Maps an open filter file shared and checks its header.
+Meaning of Parameters:
+  - int fd: The file, open for reading and writing.
+  - std::size_t size: The size of the file.
+Description of Return Values:
+  - Returns `true` if the file holds a filter whose size matches its header.
+  - Returns `false` otherwise; nothing stays mapped in that case.
+*/
+bool BloomFilter::map(int fd, std::size_t size) {
+    void* mapped = (size >= sizeof(BloomFilterHeader)) ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (mapped == MAP_FAILED) {
+        return false;
+    } else {
+        header = static_cast<BloomFilterHeader*>(mapped);
+        bits = reinterpret_cast<std::uint64_t*>(header + 1);
+        mappedSize = size;
+    }
+
+    if (std::memcmp(header->magic, bloomMagic, sizeof(bloomMagic)) != 0 || header->bitCount == 0 || header->bitCount % 64 != 0 ||
+        header->hashCount == 0 || size != sizeof(BloomFilterHeader) + header->bitCount / 8) {
+        close();
+        return false;
+    } else {
+        return true;
+    }
+}
+
+/*
+Method Name: open
+Purpose: Maps the filter file and checks that it holds exactly the keys the caller expects. A file that is missing, damaged, out of date or filled past its capacity is replaced by an empty filter with room for twice as many keys, in which case the caller must add every key again.
+Meaning of Parameters:
+  - std::uint64_t keyCount: How many keys the filter should hold, e.g. the number of customer records.
+Description of Return Values:
+  - Returns `true` if the filter in the file can be used as it is.
+  - Returns `false` if it was recreated empty, or could not be created at all (every query then answers "maybe").
+*/
+bool BloomFilter::open(std::uint64_t keyCount) {
+    close();
+    struct stat info;
+    int fd = ::open(fileName.c_str(), O_RDWR);
+    bool mapped = fd >= 0 && ::fstat(fd, &info) == 0 && map(fd, static_cast<std::size_t>(info.st_size));
+    if (fd >= 0) {
+        ::close(fd);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (mapped) {
+        setFalsePositiveRate(header->ratePerMillion / 1e6);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (mapped && header->keyCount == keyCount && keyCount <= header->capacity) {
+        return true;
+    } else {
+        create(keyCount * 2);
+        return false;
+    }
+}
+
+/*
+Method Name: create
+Purpose: Replaces the filter file with an empty filter sized for the configured false positive rate: m = -n ln(p) / ln(2)^2 bits and k = (m / n) ln(2) hash functions. The bits start out as a hole in the file, so nothing is written until keys are added.
+Meaning of Parameters:
+  - std::uint64_t capacity: How many keys the filter is sized for; at least 65536.
+Description of Return Values:
+  - Returns `true` if the new filter is mapped.
+  - Returns `false` if the file could not be written or mapped; every query then answers "maybe".
+*/
+bool BloomFilter::create(std::uint64_t capacity) {
+    close();
+    BloomFilterHeader fresh;
+    std::memset(&fresh, 0, sizeof(fresh));
+    std::memcpy(fresh.magic, bloomMagic, sizeof(bloomMagic));
+    fresh.capacity = std::max(capacity, minimumCapacity);
+    fresh.bitCount = static_cast<std::uint64_t>(std::ceil(-static_cast<double>(fresh.capacity) * std::log(falsePositiveRate) / (ln2 * ln2)));
+    fresh.bitCount = (fresh.bitCount + 63) / 64 * 64;
+    fresh.hashCount = static_cast<std::uint32_t>(std::max(1.0, std::round(static_cast<double>(fresh.bitCount) / fresh.capacity * ln2)));
+    fresh.ratePerMillion = static_cast<std::uint32_t>(std::lround(falsePositiveRate * 1e6));
+    std::size_t size = sizeof(BloomFilterHeader) + fresh.bitCount / 8;
+
+    int fd = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    bool created = fd >= 0 && ::ftruncate(fd, static_cast<off_t>(size)) == 0 &&
+                   ::pwrite(fd, &fresh, sizeof(fresh), 0) == static_cast<ssize_t>(sizeof(fresh)) && map(fd, size);
+    if (fd >= 0) {
+        ::close(fd);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    return created;
+}
+
+/*
+Method Name: setFalsePositiveRate
+Purpose: Sets the false positive rate the next create sizes the filter for; the current filter is not changed.
+Meaning of Parameters:
+  - double rate: The rate, kept between one in a million and one in two.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void BloomFilter::setFalsePositiveRate(double rate) {
+    falsePositiveRate = std::min(std::max(rate, 1e-6), 0.5);
+}
+
+/*
+Method Name: add
+Purpose: Sets a key's bits.
+Meaning of Parameters:
+  - std::string_view key: The key.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void BloomFilter::add(std::string_view key) {
+    if (header == nullptr) {
+        return;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::uint64_t hash = hashText(key);
+    std::uint64_t step = mixHash(hash) | 1;
+    for (std::uint32_t i = 0; i < header->hashCount; ++i) {
+        std::uint64_t bit = bitPosition(hash, step, i, header->bitCount);
+        bits[bit / 64] |= std::uint64_t(1) << (bit % 64);
+    }
+    ++header->keyCount;
+}
+
+/*
+Method Name: mightContain
+Purpose: Checks a key's bits and counts the query.
+Meaning of Parameters:
+  - std::string_view key: The key.
+Description of Return Values:
+  - Returns `false` if the key was certainly never added.
+  - Returns `true` if it may have been, or if no filter is mapped.
+*/
+bool BloomFilter::mightContain(std::string_view key) {
+    if (header == nullptr) {
+        return true;
+    } else {
+        ++header->queries;
+    }
+
+    std::uint64_t hash = hashText(key);
+    std::uint64_t step = mixHash(hash) | 1;
+    // The for loop stops at the first clear bit, which for a key not in a sparse filter is usually the first one
+    for (std::uint32_t i = 0; i < header->hashCount; ++i) {
+        std::uint64_t bit = bitPosition(hash, step, i, header->bitCount);
+        if ((bits[bit / 64] & (std::uint64_t(1) << (bit % 64))) == 0) {
+            return false;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    ++header->possibleHits;
+    return true;
+}
+
+/*
+Method Name: recordFalsePositive
+Purpose: Counts a possible hit that the exact check ruled out, for the stats.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void BloomFilter::recordFalsePositive() {
+    if (header != nullptr) {
+        ++header->falsePositives;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: stats
+Purpose: Reports the filter's size, fill and screening counters.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the stats; all zero except the configured rate if no filter is mapped. The expected rate is (1 - e^(-kn/m))^k for the n keys held now.
+*/
+BloomFilterStats BloomFilter::stats() const {
+    BloomFilterStats result;
+    result.configuredRate = falsePositiveRate;
+    if (header == nullptr) {
+        return result;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    result.capacity = header->capacity;
+    result.keyCount = header->keyCount;
+    result.bitCount = header->bitCount;
+    result.hashCount = header->hashCount;
+    result.queries = header->queries;
+    result.possibleHits = header->possibleHits;
+    result.falsePositives = header->falsePositives;
+    double filled = 1.0 - std::exp(-static_cast<double>(header->hashCount) * header->keyCount / header->bitCount);
+    result.expectedRate = std::pow(filled, header->hashCount);
+    return result;
+}
+
+/*
+Method Name: file
+Purpose: Gives the name of the filter file, for reports.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the file name.
+*/
+const std::string& BloomFilter::file() const {
+    return fileName;
+}
+
+/*
+Method Name: close
+Purpose: Unmaps the filter if it is mapped.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void BloomFilter::close() {
+    if (header != nullptr) {
+        ::munmap(header, mappedSize);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    header = nullptr;
+    bits = nullptr;
+    mappedSize = 0;
+}
+
+/*
+****************************************************************************
+***************************** BLOOM FILTER END *****************************
+****************************************************************************
+*/
@@ -0,0 +1,56 @@
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/* Declarations for the memory-mapped Bloom filters that screen usernames and credit card numbers for uniqueness */
+
+struct BloomFilterHeader;
+
+// What a filter holds and how well it has screened so far; the counters are kept in the file across runs.
+struct BloomFilterStats {
+    std::uint64_t capacity = 0;       // How many keys the filter was sized for
+    std::uint64_t keyCount = 0;       // How many keys have been added
+    std::uint64_t bitCount = 0;
+    std::uint32_t hashCount = 0;
+    double configuredRate = 0;        // The false positive rate the filter was sized for, at capacity
+    double expectedRate = 0;          // The false positive rate expected with the keys it holds now
+    std::uint64_t queries = 0;        // Every mightContain call
+    std::uint64_t possibleHits = 0;   // Queries the filter could not rule out
+    std::uint64_t falsePositives = 0; // Possible hits the exact check then ruled out
+};
+
+// A Bloom filter kept in a file and mapped shared, so it is loaded by the first lookups that touch its pages rather
+// than by reading it, and every added key is written back by the kernel. A "no" from mightContain is certain; a
+// "maybe" has to be confirmed by an exact check. Keys can be added but never removed, so removed customers stay in
+// the filter and are ruled out by the exact check. If the file cannot be mapped, every query answers "maybe".
+class BloomFilter {
+public:
+    BloomFilter(const std::string& fileName, double falsePositiveRate);
+    BloomFilter(const BloomFilter&) = delete;
+    BloomFilter& operator=(const BloomFilter&) = delete;
+    ~BloomFilter();
+
+    bool open(std::uint64_t keyCount);
+    bool create(std::uint64_t capacity);
+    void setFalsePositiveRate(double rate);
+    void add(std::string_view key);
+    bool mightContain(std::string_view key);
+    void recordFalsePositive();
+    BloomFilterStats stats() const;
+    const std::string& file() const;
+    void close();
+
+private:
+    std::string fileName;
+    double falsePositiveRate;
+    BloomFilterHeader* header = nullptr; // The start of the mapping; the bits follow it
+    std::uint64_t* bits = nullptr;
+    std::size_t mappedSize = 0;
+
+    bool map(int fd, std::size_t size);
+};
+
+#endif // BLOOMFILTER_H
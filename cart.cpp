@@ -0,0 +1,236 @@
+#include <iostream>
+#include "cart.h"
+#include "globals.h"
+
+/*
+****************************************************************************
+****************************** CART START **********************************
+****************************************************************************
+*/
+
+/*
+Method Name: reservedQuantity
+Purpose: Adds up how much of a product the earlier line items in the cart already take.
+Meaning of Parameters:
+  - ProductId productID: The product.
+Description of Return Values:
+  - Returns the total quantity of that product already in the cart.
+*/
+int Cart::reservedQuantity(ProductId productID) const {
+    int reserved = 0;
+    for (std::size_t i = 0; i < lineItems.size(); ++i) {
+        reserved += (lineItems[i].productID == productID) ? lineItems[i].quantity : 0;
+    }
+    return reserved;
+}
+
+/*
+Method Name: takeLineItem
+Purpose: Deducts one line item from its product's inventory as one atomic take.
+Meaning of Parameters:
+  - std::size_t index: The line item's position in the cart.
+Description of Return Values:
+  - Returns `true` if the product still exists and had enough left.
+  - Returns `false` if it was removed after the line item was added or ran short.
+*/
+bool Cart::takeLineItem(std::size_t index) {
+    ProductRecord* record = productCatalog.find(lineItems[index].productID);
+    return record != nullptr && record->inventory.take(lineItems[index].quantity);
+}
+
+/*
+Method Name: putBackLineItem
+Purpose: Returns one deducted line item to its product's inventory.
+Meaning of Parameters:
+  - std::size_t index: The line item's position in the cart.
+Description of Return Values:
+  - This method does not return a value. A product removed since the deduction has no inventory to return to.
+*/
+void Cart::putBackLineItem(std::size_t index) {
+    ProductRecord* record = productCatalog.find(lineItems[index].productID);
+    if (record != nullptr) {
+        record->inventory += lineItems[index].quantity;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: problem
+Purpose: Checks a line item against the in-memory product catalog without printing anything, for callers that report the problem their own way.
+Meaning of Parameters:
+  - ProductId productID: The product.
+  - int quantity: How many units to buy.
+Description of Return Values:
+  - Returns an empty string if the product exists and has enough inventory left once the rest of the cart is taken into account.
+  - Returns the reason the line item cannot be added otherwise.
+*/
+std::string Cart::problem(ProductId productID, int quantity) const {
+    const ProductRecord* record = productCatalog.find(productID);
+    if (record == nullptr) {
+        return "Product with ID " + idDigits(productID) + " not found.";
+    } else if (quantity <= 0) {
+        return "Error: Quantity must be at least 1.";
+    } else if (quantity > record->inventory - reservedQuantity(productID)) {
+        return "Error: Not enough inventory for product ID " + idDigits(productID) + ".";
+    } else {
+        return "";
+    }
+}
+
+/*
+Method Name: add
+Purpose: Adds a line item after checking it with problem. Nothing is written and no inventory is deducted until commitInventory.
+Meaning of Parameters:
+  - ProductId productID: The product.
+  - int quantity: How many units to buy.
+Description of Return Values:
+  - Returns `true` if the product exists and has enough inventory left once the rest of the cart is taken into account.
+  - Returns `false` and outputs an error message otherwise; the cart is unchanged.
+*/
+bool Cart::add(ProductId productID, int quantity) {
+    const ProductRecord* record = productCatalog.find(productID);
+    std::string reason = problem(productID, quantity);
+    if (!reason.empty()) {
+        std::cerr << reason << "\n";
+        return false;
+    } else if (record == nullptr) {
+        std::cerr << "Product with ID " << idDigits(productID) << " not found.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    CartItem item;
+    item.productID = productID;
+    item.quantity = quantity;
+    item.price = record->price;
+    lineItems.push_back(item);
+    return true;
+}
+
+/*
+Method Name: commitInventory
+Purpose: Deducts every line item from the product catalog and writes "products.txt" once for the whole cart. Each deduction is an atomic take on the product's own count, so concurrent purchases of other products are never held up, and one that empties a product first makes this one fail cleanly.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if every line item was deducted and the inventory was written, or queued under a write-behind policy.
+  - Returns `false` and outputs an error message if a product was removed or ran short after the cart was filled, or the file could not be written; the in-memory deductions are undone in that case.
+*/
+bool Cart::commitInventory() {
+    std::size_t taken = 0;
+    // The while loop stops at the first line item whose product is gone or no longer has enough left
+    while (taken < lineItems.size() && takeLineItem(taken)) {
+        ++taken;
+    }
+
+    if (taken == lineItems.size() && persistenceQueue.saveProducts()) {
+        std::cout << "\nInventory updated successfully for " << lineItems.size() << " line item(s).\n";
+        return true;
+    } else if (taken < lineItems.size() && productCatalog.find(lineItems[taken].productID) == nullptr) {
+        std::cerr << "Error: Product ID " << idDigits(lineItems[taken].productID) << " is no longer available.\n";
+    } else if (taken < lineItems.size()) {
+        std::cerr << "Error: Not enough inventory left for product ID " << idDigits(lineItems[taken].productID) << ".\n";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    for (std::size_t i = 0; i < taken; ++i) {
+        putBackLineItem(i);
+    }
+    return false;
+}
+
+/*
+Method Name: returnInventory
+Purpose: Puts back every line item deducted by a successful commitInventory, for a purchase that failed after its inventory was committed, and writes "products.txt" again.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. A failed write is reported by the save.
+*/
+void Cart::returnInventory() {
+    for (std::size_t i = 0; i < lineItems.size(); ++i) {
+        putBackLineItem(i);
+    }
+    persistenceQueue.saveProducts();
+}
+
+/*
+Method Name: total
+Purpose: Totals the price of every line item.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the cart total, exact to the cent.
+*/
+Money Cart::total() const {
+    Money totalAmount;
+    for (std::size_t i = 0; i < lineItems.size(); ++i) {
+        totalAmount += lineItems[i].price * lineItems[i].quantity;
+    }
+    return totalAmount;
+}
+
+/*
+Method Name: rewardAmount
+Purpose: Totals the line items with each one scaled by its product's reward multiplier, for working out the points the cart earns.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the weighted total in the units RewardRules::points takes (see RewardRules::weigh).
+*/
+std::int64_t Cart::rewardAmount() const {
+    std::int64_t weightedAmount = 0;
+    for (std::size_t i = 0; i < lineItems.size(); ++i) {
+        weightedAmount += rewardRules.weigh(lineItems[i].price * lineItems[i].quantity, lineItems[i].productID);
+    }
+    return weightedAmount;
+}
+
+/*
+Method Name: empty
+Purpose: Reports whether anything has been added to the cart.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the cart has no line items.
+*/
+bool Cart::empty() const {
+    return lineItems.empty();
+}
+
+/*
+Method Name: productIDs
+Purpose: Lists the product of every line item, in the order they were added, for the transaction record.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns one product ID per line item.
+*/
+std::vector<ProductId> Cart::productIDs() const {
+    std::vector<ProductId> ids;
+    for (std::size_t i = 0; i < lineItems.size(); ++i) {
+        ids.push_back(lineItems[i].productID);
+    }
+    return ids;
+}
+
+/*
+Method Name: items
+Purpose: Gives read access to the line items.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the line items in the order they were added.
+*/
+const std::vector<CartItem>& Cart::items() const {
+    return lineItems;
+}
+
+/*
+****************************************************************************
+******************************* CART END ***********************************
+****************************************************************************
+*/
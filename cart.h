@@ -0,0 +1,37 @@
+#ifndef CART_H
+#define CART_H
+
+#include <string>
+#include <vector>
+#include "money.h"
+#include "recordId.h"
+
+/* Declarations for the shopping cart that collects a purchase's line items before they are committed together */
+
+struct CartItem {
+    ProductId productID{};
+    int quantity = 0;
+    Money price;
+};
+
+class Cart {
+public:
+    std::string problem(ProductId productID, int quantity) const;
+    bool add(ProductId productID, int quantity);
+    bool commitInventory();
+    void returnInventory();
+    Money total() const;
+    std::int64_t rewardAmount() const;
+    bool empty() const;
+    std::vector<ProductId> productIDs() const;
+    const std::vector<CartItem>& items() const;
+
+private:
+    std::vector<CartItem> lineItems;
+
+    int reservedQuantity(ProductId productID) const;
+    bool takeLineItem(std::size_t index);
+    void putBackLineItem(std::size_t index);
+};
+
+#endif // CART_H
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <string>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "server.h"
+
+/*
+****************************************************************************
+***************************** CLIENT START *********************************
+****************************************************************************
+*/
+
+/*
+Function Name: connectToServer
+Purpose: Connects to a server started with app --serve.
+Meaning of Parameters:
+  - const std::string& socketPath: The server's socket path.
+Description of Return Values:
+  - Returns the connected socket's file descriptor.
+  - Returns -1 and outputs an error message if the server cannot be reached.
+*/
+int connectToServer(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    int fd = -1;
+    if (!socketPath.empty() && socketPath.size() < sizeof(address.sun_path)) {
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Error: Unable to connect to " << socketPath << ": " << std::strerror(errno) << "\n";
+        close(fd);
+        return -1;
+    } else {
+        return fd;
+    }
+}
+
+/*
+Function Name: sendRequest
+Purpose: Sends one request line, then reads the server's reply line.
+Meaning of Parameters:
+  - int fd: The connected socket.
+  - const std::string& request: The request, without its newline.
+  - std::string& pending: Bytes received past the end of earlier replies; kept between calls.
+  - std::string& reply: Receives the reply, without its newline.
+Description of Return Values:
+  - Returns `true` if a reply was received.
+  - Returns `false` if the connection was lost.
+*/
+bool sendRequest(int fd, const std::string& request, std::string& pending, std::string& reply) {
+    std::string line = request + "\n";
+    std::size_t written = 0;
+    while (written < line.size()) {
+        ssize_t sent = send(fd, line.data() + written, line.size() - written, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        } else {
+            written += static_cast<std::size_t>(sent);
+        }
+    }
+
+    char buffer[4096];
+    std::size_t newline = pending.find('\n');
+    // The while loop reads until a whole reply line has arrived
+    while (newline == std::string::npos) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            return false;
+        } else {
+            pending.append(buffer, static_cast<std::size_t>(received));
+            newline = pending.find('\n');
+        }
+    }
+    reply = pending.substr(0, newline);
+    pending.erase(0, newline + 1);
+    return true;
+}
+
+/*
+Function Name: main
+Purpose: Sends requests to a server started with app --serve and prints each reply, for use from scripts. Usage:
+  client [--socket <path>] <request words ...>   sends one request made of the words;
+  client [--socket <path>]                       sends each line read from standard input.
+Meaning of Parameters:
+  - int argc: The number of command line arguments.
+  - char* argv[]: The command line arguments.
+Description of Return Values:
+  - Returns 0 if every reply was OK, 1 if any was ERR, or 2 if the server could not be reached or hung up.
+*/
+int main(int argc, char* argv[]) {
+    bool socketGiven = (argc > 2 && std::string(argv[1]) == "--socket");
+    std::string socketPath = socketGiven ? argv[2] : defaultSocketPath;
+    int first = socketGiven ? 3 : 1;
+    std::string request;
+    for (int i = first; i < argc; ++i) {
+        request += (i > first) ? std::string(" ") + argv[i] : std::string(argv[i]);
+    }
+
+    int fd = connectToServer(socketPath);
+    int status = (fd < 0) ? 2 : 0;
+    std::string pending;
+    std::string reply;
+    bool fromInput = (first == argc);
+    // The while loop sends the single request from the command line, or every line of standard input
+    while (status != 2 && ((fromInput && std::getline(std::cin, request)) || (!fromInput && !request.empty()))) {
+        if (sendRequest(fd, request, pending, reply)) {
+            std::cout << reply << "\n";
+            status = (reply.compare(0, 2, "OK") == 0) ? status : 1;
+        } else {
+            std::cerr << "Error: The server closed the connection.\n";
+            status = 2;
+        }
+        request.clear();
+    }
+    close(fd);
+    return status;
+}
+
+/*
+****************************************************************************
+****************************** CLIENT END **********************************
+****************************************************************************
+*/
@@ -0,0 +1,1054 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include "customerStore.h"
+#include "durableFile.h"
+#include "mappedFile.h"
+#include "recordIndex.h"
+#include "recordParser.h"
+#include "tombstoneLog.h"
+#include "utility.h"
+
+/*
+****************************************************************************
+************************* CUSTOMER STORE START *****************************
+****************************************************************************
+*/
+
+/*
+Function Name: formatCustomerRecord
+Purpose: Converts a customer record into the text layout used by the "customers.txt" file.
+Meaning of Parameters:
+  - const CustomerRecord& record: The customer record to format.
+Description of Return Values:
+  - Returns the formatted record, starting with the "Customer N" header line and ending with a newline.
+*/
+std::string formatCustomerRecord(const CustomerRecord& record) {
+    return "Customer " + std::to_string(record.customerNumber) + "\n" +
+           "\tID: " + formatId(record.userID) + "\n" +
+           "\tUser name: " + record.username + "\n" +
+           "\tFirst Name: " + record.firstName + "\n" +
+           "\tLast Name: " + record.lastName + "\n" +
+           "\tAge: " + std::to_string(record.age) + "\n" +
+           "\tCredit Card: " + record.creditCard + "\n" +
+           "\tTotal Reward Points: " + std::to_string(record.rewardPoints) + "\n";
+}
+
+// Number of ledger entries after which the ledger is folded into a new customer file snapshot
+static const std::size_t ledgerCompactionThreshold = 1000;
+
+/*
+Function Name: writeCustomerSnapshot
+Purpose: Replaces the customer file with a complete new one through replaceFile, so neither readers nor a crash ever see a half-written file.
+Meaning of Parameters:
+  - const std::string& fileName: The customer file to replace, normally "customers.txt".
+  - const std::vector<CustomerRecord>& records: The customer records to write, in order.
+  - std::uint64_t sequence: The last reward ledger entry reflected in the records; written as a "Ledger Sequence" line when non-zero.
+Description of Return Values:
+  - Returns `true` if the new file is in place; its record index ("customers.idx") is rewritten to match.
+  - Returns `false` and outputs an error message if it could not be written; the old file is left untouched in that case.
+*/
+static bool writeCustomerSnapshot(const std::string& fileName, const std::vector<CustomerRecord>& records, std::uint64_t sequence) {
+    std::string contents = (sequence > 0) ? "Ledger Sequence: " + std::to_string(sequence) + "\n" : "";
+    std::vector<RecordLocation> locations(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        std::string text = formatCustomerRecord(records[i]);
+        locations[i].id = formatId(records[i].userID);
+        locations[i].offset = contents.size();
+        locations[i].length = static_cast<std::uint32_t>(text.size());
+        contents += text;
+    }
+
+    if (!replaceFile(fileName, contents)) {
+        return false;
+    } else {
+        writeRecordIndex(fileName, locations);
+    }
+    return true;
+}
+
+/*
+Function Name: loggedBalances
+Purpose: Copies the customer records with each balance as of the last reward ledger entry written for it. A snapshot that ends at a ledger sequence number must leave out changes made in memory whose entries are still to be written, or replaying those entries over the snapshot would count them twice.
+Meaning of Parameters:
+  - const std::vector<CustomerRecord>& records: The live customer records.
+Description of Return Values:
+  - Returns the copy.
+*/
+static std::vector<CustomerRecord> loggedBalances(const std::vector<CustomerRecord>& records) {
+    std::vector<CustomerRecord> logged(records);
+    for (std::size_t i = 0; i < logged.size(); ++i) {
+        logged[i].rewardPoints -= logged[i].unloggedPoints;
+        logged[i].unloggedPoints = 0;
+    }
+    return logged;
+}
+
+/*
+Function Name: compactCustomerSnapshot
+Purpose: Runs on the background compaction thread: writes a snapshot of the customer records, then deletes the ledger and removal log segments it replaces.
+Meaning of Parameters:
+  - std::string fileName: The customer file to replace.
+  - std::vector<CustomerRecord> records: A copy of the live customer records taken when the compaction started.
+  - std::uint64_t sequence: The last ledger entry reflected in the copy.
+  - std::vector<std::string> segmentNames: The rotated ledger and removal log segments that the snapshot makes redundant.
+Description of Return Values:
+  - This function does not return a value. If the snapshot cannot be written the segments are kept, so nothing is lost.
+*/
+static void compactCustomerSnapshot(std::string fileName, std::vector<CustomerRecord> records, std::uint64_t sequence, std::vector<std::string> segmentNames) {
+    if (writeCustomerSnapshot(fileName, records, sequence)) {
+        for (std::size_t i = 0; i < segmentNames.size(); ++i) {
+            std::remove(segmentNames[i].c_str());
+        }
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Function Name: applyCustomerField
+Purpose: Stores a single "Key: value" field read from "customers.txt" into the matching attribute of a customer record.
+Meaning of Parameters:
+  - CustomerRecord& record: The record being filled in.
+  - std::string_view line: A trimmed line from the customer file.
+Description of Return Values:
+  - This function does not return a value. Lines that do not match a known field are ignored.
+*/
+static void applyCustomerField(CustomerRecord& record, std::string_view line) {
+    std::string_view value;
+    if (fieldValue(line, "ID:", value)) {
+        parseCustomerId(value, record.userID);
+    } else if (fieldValue(line, "User name:", value)) {
+        record.username.assign(value);
+    } else if (fieldValue(line, "First Name:", value)) {
+        record.firstName.assign(value);
+    } else if (fieldValue(line, "Last Name:", value)) {
+        record.lastName.assign(value);
+    } else if (fieldValue(line, "Age:", value)) {
+        parseNumber(value, record.age);
+    } else if (fieldValue(line, "Credit Card:", value)) {
+        record.creditCard.assign(value);
+    } else if (fieldValue(line, "Total Reward Points:", value)) {
+        parseNumber(value, record.rewardPoints);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Function Name: parseCustomerRecords
+Purpose: Parses customer records out of a buffer holding customer file text, copying only the field values that are kept.
+Meaning of Parameters:
+  - std::string_view text: The whole customer file, or the text of a single record.
+  - std::vector<CustomerRecord>& records: Receives the records, appended in file order.
+  - std::uint64_t& sequence: Receives the "Ledger Sequence" value if the text starts with one; otherwise left unchanged.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void parseCustomerRecords(std::string_view text, std::vector<CustomerRecord>& records, std::uint64_t& sequence) {
+    RecordParser parser(text);
+    std::string_view line;
+    std::string_view value;
+    std::size_t first = records.size();
+    // The while loop starts a new record at every "Customer N" header and routes the following field lines into it.
+    while (parser.nextLine(line)) {
+        if (fieldValue(line, "Customer", value)) {
+            records.push_back(CustomerRecord());
+            parseNumber(value, records.back().customerNumber);
+        } else if (records.size() > first) {
+            applyCustomerField(records.back(), line);
+        } else if (fieldValue(line, "Ledger Sequence:", value)) {
+            parseNumber(value, sequence);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: lookupCustomerRecord
+Purpose: Reads a single customer straight from the customer file through its record index, without loading the whole file. Balance changes still in the reward ledger are added on top.
+Meaning of Parameters:
+  - const std::string& fileName: The text customer file, normally "customers.txt".
+  - const std::string& ledgerFileName: The reward ledger, normally "rewardsLedger.txt".
+  - CustomerId userID: The customer to look up.
+  - CustomerRecord& record: Receives the customer record if it is found.
+Description of Return Values:
+  - Returns `true` if the customer exists.
+  - Returns `false` if the customer ID is not in the file, has been removed, or the file could not be read.
+*/
+bool lookupCustomerRecord(const std::string& fileName, const std::string& ledgerFileName, CustomerId userID, CustomerRecord& record) {
+    RecordLocation location;
+    std::string text;
+    std::string idText = formatId(userID);
+    if (isTombstoned(fileName, idText) || !findRecordLocation(fileName, "Customer", idText, location) ||
+        !readRecordAt(fileName, location, text)) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::vector<CustomerRecord> found;
+    std::uint64_t sequence = 0;
+    parseCustomerRecords(text, found, sequence);
+    record = found.empty() ? CustomerRecord() : found.front();
+
+    // The snapshot sequence is on the first line of the file when a ledger has been folded into it
+    std::string_view contents;
+    std::string_view line;
+    mappedFileContents(fileName, contents);
+    RecordParser(contents).nextLine(line);
+    parseCustomerRecords(line, found, sequence);
+    record.rewardPoints += sumLedgerDeltas(ledgerFileName + ".old", userID, sequence) +
+                           sumLedgerDeltas(ledgerFileName, userID, sequence);
+    return true;
+}
+
+/*
+Function Name: readRemovedIDs
+Purpose: Reads the customer IDs in a removal log.
+Meaning of Parameters:
+  - const std::string& fileName: The removal log or a segment of it. A missing log counts as empty.
+  - std::unordered_set<CustomerId>& ids: Receives the removed IDs; existing contents are kept.
+Description of Return Values:
+  - This function does not return a value. Lines that are not customer IDs are skipped.
+*/
+static void readRemovedIDs(const std::string& fileName, std::unordered_set<CustomerId>& ids) {
+    std::unordered_set<std::string> lines;
+    CustomerId id{};
+    readTombstones(fileName, lines);
+    for (std::unordered_set<std::string>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+        if (parseCustomerId(*it, id)) {
+            ids.insert(id);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: eraseKeyPosition
+Purpose: Removes one record's entry from a username or credit card hash index, leaving other records with the same hash.
+Meaning of Parameters:
+  - std::unordered_multimap<std::size_t, std::size_t>& keys: The index.
+  - std::size_t hash: The hash of the record's key.
+  - std::size_t position: The record's position in the record list.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void eraseKeyPosition(std::unordered_multimap<std::size_t, std::size_t>& keys, std::size_t hash, std::size_t position) {
+    typedef std::unordered_multimap<std::size_t, std::size_t>::iterator KeyIterator;
+    std::pair<KeyIterator, KeyIterator> matches = keys.equal_range(hash);
+    for (KeyIterator it = matches.first; it != matches.second; ++it) {
+        if (it->second == position) {
+            keys.erase(it);
+            return;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Method Name: ~CustomerStore
+Purpose: Waits for any background compaction to finish before the store goes away.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+CustomerStore::~CustomerStore() {
+    waitForCompaction();
+}
+
+/*
+Method Name: load
+Purpose: Parses the customer file once and builds the hash index from customer ID to record. Call openLedger afterwards to apply logged balance changes.
+Meaning of Parameters:
+  - const std::string& fileName: The customer file to read, normally "customers.txt".
+Description of Return Values:
+  - Returns `true` if the file was read.
+  - Returns `false` if the file could not be opened; the store is left empty in that case.
+*/
+bool CustomerStore::load(const std::string& fileName) {
+    waitForCompaction();
+    this->fileName = fileName;
+    binaryFile.close();
+    ledger.close();
+    snapshotSequence = 0;
+    records.clear();
+    index.clear();
+    removedIDs.clear();
+    deadRecords = 0;
+
+    std::string_view contents;
+    if (!mappedFileContents(fileName, contents)) {
+        return false;
+    } else {
+        parseCustomerRecords(contents, records, snapshotSequence);
+    }
+
+    // Records named in the removal log (or a segment left by an unfinished compaction) stay hidden
+    readRemovedIDs(tombstoneFileName(fileName), removedIDs);
+    readRemovedIDs(tombstoneFileName(fileName) + ".old", removedIDs);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].deleted = removedIDs.count(records[i].userID) > 0;
+        deadRecords += records[i].deleted ? 1 : 0;
+    }
+
+    reindex();
+    return true;
+}
+
+/*
+Method Name: loadBinary
+Purpose: Reads every record from a fixed-width binary customer file and keeps the file open so balance changes can be written in place.
+Meaning of Parameters:
+  - const std::string& fileName: The binary customer file to read, normally "customers.bin".
+Description of Return Values:
+  - Returns `true` if the file was opened and read.
+  - Returns `false` if the file could not be opened or read; the store is left empty in that case.
+*/
+bool CustomerStore::loadBinary(const std::string& fileName) {
+    waitForCompaction();
+    this->fileName = fileName;
+    ledger.close();
+    records.clear();
+    index.clear();
+    removedIDs.clear();
+    deadRecords = 0;
+
+    if (!binaryFile.open(fileName) || !binaryFile.readAll(records)) {
+        binaryFile.close();
+        records.clear();
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    // Removed records keep their slots, flagged, until the file is compacted
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        deadRecords += records[i].deleted ? 1 : 0;
+    }
+    reindex();
+    return true;
+}
+
+/*
+Method Name: openLedger
+Purpose: Switches the text customer file to ledger mode: applies every logged balance change not yet in the customer file, then records future changes by appending to the ledger instead of rewriting the customer file.
+Meaning of Parameters:
+  - const std::string& ledgerFileName: The ledger file, normally "rewardsLedger.txt".
+Description of Return Values:
+  - Returns `true` if the ledger was replayed and opened for appending.
+  - Returns `false` if the store uses the binary file (which already updates balances in place) or the ledger could not be opened.
+*/
+bool CustomerStore::openLedger(const std::string& ledgerFileName) {
+    if (binaryFile.isOpen()) {
+        return false;
+    } else {
+        this->ledgerFileName = ledgerFileName;
+    }
+
+    // A leftover segment means the last compaction did not finish; it holds older entries than the live ledger
+    std::string segmentName = ledgerFileName + ".old";
+    std::uint64_t lastSequence = snapshotSequence;
+    std::size_t segmentEntries = replayLedger(segmentName, lastSequence);
+    std::size_t pendingEntries = replayLedger(ledgerFileName, lastSequence);
+
+    if (!ledger.open(ledgerFileName, lastSequence, pendingEntries)) {
+        return false;
+    } else if (segmentEntries > 0 || pendingEntries >= ledgerCompactionThreshold) {
+        return save();
+    } else {
+        std::remove(segmentName.c_str());
+    }
+    return true;
+}
+
+/*
+Method Name: replayLedger
+Purpose: Applies the balance changes in one ledger file that are newer than the customer file snapshot.
+Meaning of Parameters:
+  - const std::string& ledgerFile: The ledger file or segment to read. A missing file is treated as empty.
+  - std::uint64_t& lastSequence: The highest sequence number seen so far; entries at or below it are skipped and it is raised as entries are applied.
+Description of Return Values:
+  - Returns the number of entries applied. Entries for customers that no longer exist still count, so they are folded away by the next compaction.
+*/
+std::size_t CustomerStore::replayLedger(const std::string& ledgerFile, std::uint64_t& lastSequence) {
+    std::ifstream infile(ledgerFile);
+    std::string line;
+    RewardLedgerEntry entry;
+    std::size_t applied = 0;
+
+    // The while loop applies each well-formed entry newer than the last one seen to the matching customer's balance.
+    while (std::getline(infile, line)) {
+        if (!parseLedgerEntry(line, entry) || entry.sequence <= lastSequence) {
+            continue;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+
+        CustomerRecord* record = find(entry.userID);
+        if (record != nullptr) {
+            record->rewardPoints += entry.delta;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+        lastSequence = entry.sequence;
+        ++applied;
+    }
+    return applied;
+}
+
+/*
+Method Name: save
+Purpose: Rewrites the customer file (text or binary) from the live in-memory records. This compacts away removed records, and folds and empties the reward ledger and the removal log.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the file was written.
+  - Returns `false` and outputs an error message if the file could not be written.
+*/
+bool CustomerStore::save() {
+    waitForCompaction();
+    dropDeadRecords();
+    snapshotSequence = ledger.isOpen() ? ledger.lastSequence() : snapshotSequence;
+    std::string removedLog = tombstoneFileName(fileName);
+    bool written = false;
+    if (binaryFile.isOpen()) {
+        written = binaryFile.create(fileName, records);
+    } else if (ledger.isOpen()) {
+        written = writeCustomerSnapshot(fileName, loggedBalances(records), snapshotSequence);
+    } else {
+        written = writeCustomerSnapshot(fileName, records, snapshotSequence);
+    }
+
+    // The rewritten file leaves the removed records out, on either format, so their IDs are no longer removed
+    if (!written) {
+        return false;
+    } else {
+        std::remove(removedLog.c_str());
+        std::remove((removedLog + ".old").c_str());
+        removedIDs.clear();
+    }
+
+    if (ledger.isOpen()) {
+        std::remove((ledgerFileName + ".old").c_str());
+        return ledger.reset();
+    } else {
+        return true;
+    }
+}
+
+/*
+Method Name: startCompaction
+Purpose: Moves the current ledger and removal log aside and writes a new customer file snapshot without the removed records on a background thread, so checkout and removals do not wait for the rewrite.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. If a segment from a failed compaction is still present, the store is saved synchronously instead so the segment is not overwritten.
+*/
+void CustomerStore::startCompaction() {
+    waitForCompaction();
+    std::string ledgerSegment = ledgerFileName + ".old";
+    std::string removedSegment = tombstoneFileName(fileName) + ".old";
+    if ((ledger.isOpen() && fileExists(ledgerSegment)) || fileExists(removedSegment)) {
+        save();
+        return;
+    } else if (ledger.isOpen() && !ledger.rotate(ledgerSegment)) {
+        return;
+    } else {
+        std::rename(tombstoneFileName(fileName).c_str(), removedSegment.c_str());
+    }
+
+    snapshotSequence = ledger.isOpen() ? ledger.lastSequence() : snapshotSequence;
+    dropDeadRecords();
+    std::vector<std::string> segmentNames = { ledgerSegment, removedSegment };
+    compactor = std::thread(compactCustomerSnapshot, fileName, loggedBalances(records), snapshotSequence, segmentNames);
+}
+
+/*
+Method Name: compactIfNeeded
+Purpose: Starts a compaction once the share of removed records still in the file passes the dead record threshold.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. The binary file is compacted synchronously; the text file on the background thread.
+*/
+void CustomerStore::compactIfNeeded() {
+    if (static_cast<double>(deadRecords) <= deadRecordThreshold * static_cast<double>(records.size())) {
+        return;
+    } else if (binaryFile.isOpen()) {
+        save();
+    } else {
+        startCompaction();
+    }
+}
+
+/*
+Method Name: dropDeadRecords
+Purpose: Erases removed records from memory before the file is rewritten without them.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. The index is rebuilt if anything was erased.
+*/
+void CustomerStore::dropDeadRecords() {
+    if (deadRecords == 0) {
+        return;
+    } else {
+        deadRecords = 0;
+    }
+
+    std::vector<CustomerRecord> live;
+    live.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (!records[i].deleted) {
+            live.push_back(records[i]);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    records.swap(live);
+    reindex();
+}
+
+/*
+Method Name: setDeadRecordThreshold
+Purpose: Sets how large a share of the records may be removed-but-not-compacted before the customer file is rewritten.
+Meaning of Parameters:
+  - double ratio: The share, between 0 and 1. 0 rewrites the file on every removal.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void CustomerStore::setDeadRecordThreshold(double ratio) {
+    deadRecordThreshold = ratio;
+}
+
+/*
+Method Name: waitForCompaction
+Purpose: Waits for a running background compaction to finish. Called before anything else writes the customer file.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void CustomerStore::waitForCompaction() {
+    if (compactor.joinable()) {
+        compactor.join();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: appendText
+Purpose: Appends one customer record to the end of the text customer file.
+Meaning of Parameters:
+  - const CustomerRecord& record: The record to append.
+Description of Return Values:
+  - Returns `true` if the record was written. The record index is extended when it was current; otherwise it is rebuilt on its next use.
+  - Returns `false` and outputs an error message if the file could not be opened.
+*/
+bool CustomerStore::appendText(const CustomerRecord& record) {
+    waitForCompaction();
+    std::ofstream outfile(fileName, std::ios::app);
+    if (!outfile.is_open()) {
+        std::cerr << "Error: Could not open " << fileName << " file.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::string text = formatCustomerRecord(record);
+    outfile << text;
+    outfile.close();
+    appendRecordIndex(fileName, formatId(record.userID), static_cast<std::uint32_t>(text.size()));
+    return true;
+}
+
+/*
+Method Name: append
+Purpose: Adds a new customer record to the index and appends it to the end of the customer file.
+Meaning of Parameters:
+  - const CustomerRecord& record: The new customer record.
+Description of Return Values:
+  - Returns `true` if the record was appended to the file.
+  - Returns `false` and outputs an error message if the file could not be opened; the record is not indexed in that case.
+*/
+bool CustomerStore::append(const CustomerRecord& record) {
+    std::unique_lock<std::shared_mutex> exclusive(storeLock);
+    // A reused ID must not stay hidden by an old entry in the removal log
+    if (removedIDs.count(record.userID) > 0 && !save()) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    bool written = binaryFile.isOpen() ? binaryFile.append(record) : appendText(record);
+    if (!written) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    index[record.userID] = records.size();
+    records.push_back(record);
+    indexKeys(records.size() - 1);
+    return true;
+}
+
+/*
+Method Name: remove
+Purpose: Removes a customer record by hiding it from the index and recording a tombstone, instead of rewriting the customer file. The text file logs the ID in "customers.removed.txt"; the binary file flags the slot in place.
+Meaning of Parameters:
+  - CustomerId userID: The customer to remove.
+Description of Return Values:
+  - Returns `true` if the record existed and the removal was recorded.
+  - Returns `false` if the customer ID is not in the index or the tombstone could not be written.
+*/
+bool CustomerStore::remove(CustomerId userID) {
+    std::unique_lock<std::shared_mutex> exclusive(storeLock);
+    std::unordered_map<CustomerId, std::size_t>::const_iterator it = index.find(userID);
+    if (it == index.end()) {
+        return false;
+    } else if (binaryFile.isOpen() ? !binaryFile.markDeleted(it->second) : !appendTombstone(tombstoneFileName(fileName), formatId(userID))) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    records[it->second].deleted = true;
+    unindexKeys(it->second);
+    removedIDs.insert(userID);
+    index.erase(it);
+    ++deadRecords;
+    compactIfNeeded();
+    return true;
+}
+
+/*
+Method Name: recordLock
+Purpose: Picks the record lock that guards a customer's balance. The ID is scrambled first so neighbouring IDs spread across the locks.
+Meaning of Parameters:
+  - CustomerId userID: The customer.
+Description of Return Values:
+  - Returns one of the recordLockCount record locks; the same customer always gets the same one.
+*/
+std::mutex& CustomerStore::recordLock(CustomerId userID) const {
+    return recordLocks[(static_cast<std::uint64_t>(userID) * 0x9E3779B97F4A7C15ULL) >> 58];
+}
+
+/*
+Method Name: logRewardChange
+Purpose: Writes a balance change that needs only the store lock shared: the binary format's in-place write or a ledger append.
+Meaning of Parameters:
+  - CustomerId userID: The customer whose balance changed.
+  - int delta: The signed number of points added or removed.
+  - const std::string& reason: A one-word reason for the ledger.
+  - const std::string& reference: The transaction ID or reward product ID behind the change, for the ledger.
+  - bool& rewrite: Set to `true` if the customer file must now be rewritten, because there is no ledger or the ledger is due for compaction.
+Description of Return Values:
+  - Returns `true` if the change was written, or is left for the rewrite.
+  - Returns `false` if the customer ID is not in the index or the write failed.
+*/
+bool CustomerStore::logRewardChange(CustomerId userID, int delta, const std::string& reason, const std::string& reference, bool& rewrite) {
+    std::shared_lock<std::shared_mutex> shared(storeLock);
+    std::unordered_map<CustomerId, std::size_t>::const_iterator it = index.find(userID);
+    if (it == index.end()) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    // The change stops counting as unlogged here; the shared store lock keeps a snapshot from being copied before
+    // the ledger entry below is written
+    std::unique_lock<std::mutex> recordGuard(recordLock(userID));
+    records[it->second].unloggedPoints -= delta;
+    if (binaryFile.isOpen() && !binaryFile.writeRewardPoints(it->second, records[it->second].rewardPoints)) {
+        records[it->second].unloggedPoints += delta;
+        return false;
+    } else if (binaryFile.isOpen() || !ledger.isOpen()) {
+        rewrite = rewrite || !binaryFile.isOpen();
+        return true;
+    } else {
+        recordGuard.unlock();
+    }
+
+    std::unique_lock<std::mutex> ledgerGuard(ledgerLock);
+    bool appended = ledger.append(userID, delta, reason, reference);
+    rewrite = ledger.pendingEntries() >= ledgerCompactionThreshold;
+    ledgerGuard.unlock();
+    // A change whose entry was not written still counts as unlogged, so it can be retried
+    if (!appended) {
+        recordGuard.lock();
+        records[it->second].unloggedPoints += delta;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    return appended;
+}
+
+/*
+Method Name: persistRewardPoints
+Purpose: Records a change to one customer's reward balance, which has already been applied in memory. The binary format updates the 4-byte balance in place; with a ledger open the change is appended to it; otherwise the text file is rewritten.
+Meaning of Parameters:
+  - CustomerId userID: The customer whose balance changed.
+  - int delta: The signed number of points added or removed.
+  - const std::string& reason: A one-word reason for the ledger, e.g. "purchase" or "redeem".
+  - const std::string& reference: The transaction ID or reward product ID behind the change, for the ledger.
+Description of Return Values:
+  - Returns `true` if the change was written.
+  - Returns `false` if the customer ID is not in the index or the write failed.
+*/
+bool CustomerStore::persistRewardPoints(CustomerId userID, int delta, const std::string& reason, const std::string& reference) {
+    bool rewrite = false;
+    if (!logRewardChange(userID, delta, reason, reference, rewrite)) {
+        return false;
+    } else if (!rewrite) {
+        return true;
+    } else {
+        return rewriteAfterRewardChanges();
+    }
+}
+
+/*
+Method Name: persistRewardChanges
+Purpose: Records a batch of reward balance changes, which have already been applied in memory, the same way as persistRewardPoints. The text file is rewritten, or the ledger compacted, at most once for the whole batch.
+Meaning of Parameters:
+  - const std::vector<RewardLedgerEntry>& changes: The changes in the order they were made; their sequence numbers are ignored.
+  - std::vector<RewardLedgerEntry>& unwritten: Receives, in order, the changes that could not be written and should be retried. Changes for customers removed since are dropped rather than returned.
+Description of Return Values:
+  - Returns `true` if every change was written, or dropped with its customer.
+  - Returns `false` if a write failed; the other changes are still written.
+*/
+bool CustomerStore::persistRewardChanges(const std::vector<RewardLedgerEntry>& changes, std::vector<RewardLedgerEntry>& unwritten) {
+    bool rewrite = false;
+    unwritten.clear();
+    for (std::size_t i = 0; i < changes.size(); ++i) {
+        if (!logRewardChange(changes[i].userID, changes[i].delta, changes[i].reason, changes[i].reference, rewrite) && contains(changes[i].userID)) {
+            unwritten.push_back(changes[i]);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+
+    // Without a ledger the rewrite is the only write the changes get, so if it fails none of them were written
+    if (rewrite && !ledger.isOpen() && !rewriteAfterRewardChanges()) {
+        unwritten.clear();
+        for (std::size_t i = 0; i < changes.size(); ++i) {
+            restoreUnloggedPoints(changes[i].userID, changes[i].delta);
+            unwritten.push_back(changes[i]);
+        }
+    } else if (rewrite && ledger.isOpen()) {
+        rewriteAfterRewardChanges();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    return unwritten.empty();
+}
+
+/*
+Method Name: restoreUnloggedPoints
+Purpose: Counts a balance change as unlogged again after the write that recorded it failed, so the retry finds the balances as they were before it.
+Meaning of Parameters:
+  - CustomerId userID: The customer whose change was not written.
+  - int delta: The signed number of points in the change.
+Description of Return Values:
+  - This method does not return a value. A customer removed since is skipped.
+*/
+void CustomerStore::restoreUnloggedPoints(CustomerId userID, int delta) {
+    std::shared_lock<std::shared_mutex> shared(storeLock);
+    std::unordered_map<CustomerId, std::size_t>::const_iterator it = index.find(userID);
+    if (it != index.end()) {
+        std::lock_guard<std::mutex> recordGuard(recordLock(userID));
+        records[it->second].unloggedPoints += delta;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: rewriteAfterRewardChanges
+Purpose: Finishes recording balance changes that logRewardChange could not write on their own: rewrites the text file when there is no ledger, or starts compacting a ledger that has grown past its threshold.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the file was rewritten or nothing more was needed.
+  - Returns `false` if the rewrite failed.
+*/
+bool CustomerStore::rewriteAfterRewardChanges() {
+    // Rewriting or compacting copies every record, so it needs the store to itself; another thread may have started the compaction already
+    std::unique_lock<std::shared_mutex> exclusive(storeLock);
+    if (!ledger.isOpen()) {
+        return save();
+    } else if (ledger.pendingEntries() >= ledgerCompactionThreshold) {
+        startCompaction();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    return true;
+}
+
+/*
+Method Name: addRewardPoints
+Purpose: Adds a signed number of points to a customer's balance in memory, holding only that customer's record lock. Call persistRewardPoints afterwards to write the change.
+Meaning of Parameters:
+  - CustomerId userID: The customer.
+  - int delta: The points to add; negative to take points away.
+  - int& balance: Receives the new balance.
+Description of Return Values:
+  - Returns `true` if the balance was changed.
+  - Returns `false` if the customer does not exist.
+*/
+bool CustomerStore::addRewardPoints(CustomerId userID, int delta, int& balance) {
+    std::shared_lock<std::shared_mutex> shared(storeLock);
+    std::lock_guard<std::mutex> recordGuard(recordLock(userID));
+    std::unordered_map<CustomerId, std::size_t>::const_iterator it = index.find(userID);
+    if (it == index.end()) {
+        return false;
+    } else {
+        records[it->second].rewardPoints += delta;
+        records[it->second].unloggedPoints += delta;
+        balance = records[it->second].rewardPoints;
+        return true;
+    }
+}
+
+/*
+Method Name: spendRewardPoints
+Purpose: Takes points from a customer's balance in memory only if the balance covers them, checking and deducting under the customer's record lock so two redemptions cannot spend the same points. Call persistRewardPoints afterwards to write the change.
+Meaning of Parameters:
+  - CustomerId userID: The customer.
+  - int points: The points to take.
+  - int& balance: Receives the balance afterwards, or the unchanged balance if it was too low; -1 if the customer does not exist.
+Description of Return Values:
+  - Returns `true` if the points were taken.
+  - Returns `false` if the customer does not exist or has too few points.
+*/
+bool CustomerStore::spendRewardPoints(CustomerId userID, int points, int& balance) {
+    std::shared_lock<std::shared_mutex> shared(storeLock);
+    std::lock_guard<std::mutex> recordGuard(recordLock(userID));
+    std::unordered_map<CustomerId, std::size_t>::const_iterator it = index.find(userID);
+    balance = (it == index.end()) ? -1 : records[it->second].rewardPoints;
+    if (it == index.end() || balance < points) {
+        return false;
+    } else {
+        records[it->second].rewardPoints -= points;
+        records[it->second].unloggedPoints -= points;
+        balance -= points;
+        return true;
+    }
+}
+
+/*
+Method Name: contains
+Purpose: Checks whether a customer exists, for threads that must not hold on to a record pointer.
+Meaning of Parameters:
+  - CustomerId userID: The customer.
+Description of Return Values:
+  - Returns `true` if the customer exists and has not been removed.
+*/
+bool CustomerStore::contains(CustomerId userID) const {
+    std::shared_lock<std::shared_mutex> shared(storeLock);
+    return index.count(userID) > 0;
+}
+
+/*
+Method Name: copyRecord
+Purpose: Copies a customer's record under its record lock, for threads that must not hold on to a record pointer.
+Meaning of Parameters:
+  - CustomerId userID: The customer.
+  - CustomerRecord& record: Receives the copy.
+Description of Return Values:
+  - Returns `true` if the customer exists; `false` otherwise, leaving `record` unchanged.
+*/
+bool CustomerStore::copyRecord(CustomerId userID, CustomerRecord& record) const {
+    std::shared_lock<std::shared_mutex> shared(storeLock);
+    std::lock_guard<std::mutex> recordGuard(recordLock(userID));
+    std::unordered_map<CustomerId, std::size_t>::const_iterator it = index.find(userID);
+    if (it == index.end()) {
+        return false;
+    } else {
+        record = records[it->second];
+        return true;
+    }
+}
+
+/*
+Method Name: find
+Purpose: Looks up a customer record by its customer ID.
+Meaning of Parameters:
+  - CustomerId userID: The customer to look up.
+Description of Return Values:
+  - Returns a pointer to the record if it exists, or `nullptr` if it does not.
+*/
+CustomerRecord* CustomerStore::find(CustomerId userID) {
+    std::unordered_map<CustomerId, std::size_t>::const_iterator it = index.find(userID);
+    if (it == index.end()) {
+        return nullptr;
+    } else {
+        return &records[it->second];
+    }
+}
+
+/*
+Method Name: find (const)
+Purpose: Looks up a customer record by its customer ID without allowing modification.
+Meaning of Parameters:
+  - CustomerId userID: The customer to look up.
+Description of Return Values:
+  - Returns a pointer to the record if it exists, or `nullptr` if it does not.
+*/
+const CustomerRecord* CustomerStore::find(CustomerId userID) const {
+    std::unordered_map<CustomerId, std::size_t>::const_iterator it = index.find(userID);
+    if (it == index.end()) {
+        return nullptr;
+    } else {
+        return &records[it->second];
+    }
+}
+
+/*
+Method Name: findByKey
+Purpose: Looks a username or credit card up through its hash index. Only the records whose key has the same hash are compared, usually one.
+Meaning of Parameters:
+  - const std::unordered_multimap<std::size_t, std::size_t>& keys: usernameIndex or creditCardIndex.
+  - const std::string& key: The username or card number.
+  - bool creditCard: `true` to compare credit cards, `false` to compare usernames.
+Description of Return Values:
+  - Returns a pointer to the record if a customer who has not been removed has this key, or `nullptr` otherwise.
+*/
+const CustomerRecord* CustomerStore::findByKey(const std::unordered_multimap<std::size_t, std::size_t>& keys, const std::string& key, bool creditCard) const {
+    typedef std::unordered_multimap<std::size_t, std::size_t>::const_iterator KeyIterator;
+    std::pair<KeyIterator, KeyIterator> matches = keys.equal_range(std::hash<std::string>()(key));
+    for (KeyIterator it = matches.first; it != matches.second; ++it) {
+        const CustomerRecord& record = records[it->second];
+        if (!record.deleted && (creditCard ? record.creditCard : record.username) == key) {
+            return &record;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return nullptr;
+}
+
+/*
+Method Name: findByUsername
+Purpose: Looks up a customer by username through the username index, for confirming the possible hits of the username Bloom filter.
+Meaning of Parameters:
+  - const std::string& username: The username.
+Description of Return Values:
+  - Returns a pointer to the record if a customer who has not been removed has this username, or `nullptr` otherwise. While other threads may add or remove customers, only compare it with `nullptr`.
+*/
+const CustomerRecord* CustomerStore::findByUsername(const std::string& username) const {
+    std::shared_lock<std::shared_mutex> shared(storeLock);
+    return findByKey(usernameIndex, username, false);
+}
+
+/*
+Method Name: findByCreditCard
+Purpose: Looks up a customer by credit card number through the credit card index, like findByUsername.
+Meaning of Parameters:
+  - const std::string& creditCard: The card number, as "XXXX-XXXX-XXXX".
+Description of Return Values:
+  - Returns a pointer to the record if a customer who has not been removed has this card, or `nullptr` otherwise.
+*/
+const CustomerRecord* CustomerStore::findByCreditCard(const std::string& creditCard) const {
+    std::shared_lock<std::shared_mutex> shared(storeLock);
+    return findByKey(creditCardIndex, creditCard, true);
+}
+
+/*
+Method Name: all
+Purpose: Gives read access to every customer record in file order. Removed records stay in the list, flagged `deleted`, until the next compaction.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns a reference to the record list.
+*/
+const std::vector<CustomerRecord>& CustomerStore::all() const {
+    return records;
+}
+
+/*
+Method Name: dataFile
+Purpose: Reports which file the store was loaded from.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the name of the text or binary customer file backing the store.
+*/
+const std::string& CustomerStore::dataFile() const {
+    return fileName;
+}
+
+/*
+Method Name: size
+Purpose: Reports how many customer records are currently indexed.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the number of live records in the store; removed records awaiting compaction are not counted.
+*/
+std::size_t CustomerStore::size() const {
+    return index.size();
+}
+
+/*
+Method Name: reindex
+Purpose: Rebuilds the hash indexes from customer ID, username and credit card to position in the record list, leaving out removed records.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. It replaces the contents of the indexes.
+*/
+void CustomerStore::reindex() {
+    index.clear();
+    usernameIndex.clear();
+    creditCardIndex.clear();
+    index.reserve(records.size());
+    usernameIndex.reserve(records.size());
+    creditCardIndex.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (!records[i].deleted) {
+            index[records[i].userID] = i;
+            indexKeys(i);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Method Name: indexKeys
+Purpose: Adds a record's username and credit card to their hash indexes.
+Meaning of Parameters:
+  - std::size_t position: The record's position in the record list.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void CustomerStore::indexKeys(std::size_t position) {
+    usernameIndex.emplace(std::hash<std::string>()(records[position].username), position);
+    creditCardIndex.emplace(std::hash<std::string>()(records[position].creditCard), position);
+}
+
+/*
+Method Name: unindexKeys
+Purpose: Takes a removed record's username and credit card out of their hash indexes, so they can be used again without a false match.
+Meaning of Parameters:
+  - std::size_t position: The record's position in the record list.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void CustomerStore::unindexKeys(std::size_t position) {
+    eraseKeyPosition(usernameIndex, std::hash<std::string>()(records[position].username), position);
+    eraseKeyPosition(creditCardIndex, std::hash<std::string>()(records[position].creditCard), position);
+}
+
+/*
+****************************************************************************
+************************** CUSTOMER STORE END ******************************
+****************************************************************************
+*/
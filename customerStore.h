@@ -0,0 +1,104 @@
+#ifndef CUSTOMERSTORE_H
+#define CUSTOMERSTORE_H
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <cstdint>
+#include "binaryCustomerFile.h"
+#include "recordId.h"
+#include "rewardLedger.h"
+
+/* Declarations for the in-memory customer index backed by customers.txt or customers.bin */
+
+struct CustomerRecord {
+    int customerNumber = 0;
+    CustomerId userID{};
+    std::string username;
+    std::string firstName;
+    std::string lastName;
+    int age = 0;
+    std::string creditCard;
+    int rewardPoints = 0;
+    int unloggedPoints = 0; // The part of rewardPoints changed in memory whose ledger entry is not written yet
+    bool deleted = false;   // Removed, but still in the file until the next compaction
+};
+
+// The store can be shared by the server's worker threads through contains, copyRecord, addRewardPoints,
+// spendRewardPoints, persistRewardPoints, persistRewardChanges, append, remove and the findBy lookups. Balance changes and lookups take
+// the store lock shared plus one of 64 record locks picked by customer ID, so requests for different customers
+// rarely wait on each other; adding, removing and compacting records take the store lock exclusively. find, save
+// and the loaders take no locks and are for single-threaded callers only.
+class CustomerStore {
+public:
+    CustomerStore() = default;
+    ~CustomerStore();
+
+    bool load(const std::string& fileName);
+    bool loadBinary(const std::string& fileName);
+    bool openLedger(const std::string& ledgerFileName);
+    bool save();
+    bool append(const CustomerRecord& record);
+    bool remove(CustomerId userID);
+    bool persistRewardPoints(CustomerId userID, int delta, const std::string& reason, const std::string& reference);
+    bool persistRewardChanges(const std::vector<RewardLedgerEntry>& changes, std::vector<RewardLedgerEntry>& unwritten);
+    bool addRewardPoints(CustomerId userID, int delta, int& balance);
+    bool spendRewardPoints(CustomerId userID, int points, int& balance);
+    bool contains(CustomerId userID) const;
+    bool copyRecord(CustomerId userID, CustomerRecord& record) const;
+    void waitForCompaction();
+    void setDeadRecordThreshold(double ratio);
+    CustomerRecord* find(CustomerId userID);
+    const CustomerRecord* find(CustomerId userID) const;
+    const CustomerRecord* findByUsername(const std::string& username) const;
+    const CustomerRecord* findByCreditCard(const std::string& creditCard) const;
+    const std::vector<CustomerRecord>& all() const;
+    const std::string& dataFile() const;
+    std::size_t size() const;
+
+private:
+    static const std::size_t recordLockCount = 64;
+
+    std::string fileName = "customers.txt";
+    BinaryCustomerFile binaryFile; // Open only when the store was loaded from customers.bin
+    RewardLedger ledger;           // Open only when balance changes are logged instead of rewritten
+    std::string ledgerFileName;
+    std::uint64_t snapshotSequence = 0; // Last ledger entry already folded into the customer file
+    std::thread compactor;
+    std::vector<CustomerRecord> records;
+    std::unordered_map<CustomerId, std::size_t> index;
+    // Hash of each username and credit card to the positions of the records holding it, so a possible hit of the
+    // Bloom filters is confirmed exactly without scanning the records or keeping a copy of every string
+    std::unordered_multimap<std::size_t, std::size_t> usernameIndex;
+    std::unordered_multimap<std::size_t, std::size_t> creditCardIndex;
+    std::unordered_set<CustomerId> removedIDs; // IDs removed since the customer file was last rewritten
+    std::size_t deadRecords = 0;
+    double deadRecordThreshold = 0.25;          // Compact once this fraction of the records are removed
+    mutable std::shared_mutex storeLock;              // Exclusive while records are added, removed or compacted
+    mutable std::mutex recordLocks[recordLockCount];  // Guard the balances, striped by customer ID
+    std::mutex ledgerLock;                            // One append at a time to the reward ledger. Binary balance writes go to
+                                                      // the customer's own slot and need only its record lock
+
+    std::mutex& recordLock(CustomerId userID) const;
+    bool logRewardChange(CustomerId userID, int delta, const std::string& reason, const std::string& reference, bool& rewrite);
+    bool rewriteAfterRewardChanges();
+    void restoreUnloggedPoints(CustomerId userID, int delta);
+    bool appendText(const CustomerRecord& record);
+    std::size_t replayLedger(const std::string& ledgerFile, std::uint64_t& lastSequence);
+    void startCompaction();
+    void compactIfNeeded();
+    void dropDeadRecords();
+    void reindex();
+    void indexKeys(std::size_t position);
+    void unindexKeys(std::size_t position);
+    const CustomerRecord* findByKey(const std::unordered_multimap<std::size_t, std::size_t>& keys, const std::string& key, bool creditCard) const;
+};
+
+std::string formatCustomerRecord(const CustomerRecord& record);
+bool lookupCustomerRecord(const std::string& fileName, const std::string& ledgerFileName, CustomerId userID, CustomerRecord& record);
+
+#endif // CUSTOMERSTORE_H
@@ -10,6 +10,7 @@
 #include <cctype>
 #include <iomanip>
 #include "customers.h"
+#include "durableFile.h"
 #include "globals.h"
 #include "utility.h"
 
@@ -38,7 +39,7 @@ Description of Methods:
 */
 class Account {
 public:
-    std::string userID;
+    CustomerId userID;
     std::string username;
     std::string firstName;
     std::string lastName;
@@ -72,6 +73,27 @@ public:
         return capitalizedName;
     }
 
+    /*
+    Method Name: toRecord
+    Purpose: Copies the customer information into a record that can be stored in the customer index.
+    Meaning of Parameters:
+    - int customerNumber: The customer number to include in the record.
+    Description of Return Values:
+    - Returns a CustomerRecord holding the ID, username, capitalized first and last name, age, credit card, and total reward points.
+    */
+    CustomerRecord toRecord(int customerNumber) const {
+        CustomerRecord record;
+        record.customerNumber = customerNumber;
+        record.userID = userID;
+        record.username = username;
+        record.firstName = capitalize(firstName);
+        record.lastName = capitalize(lastName);
+        record.age = age;
+        record.creditCard = creditCard;
+        record.rewardPoints = rewardPoints;
+        return record;
+    }
+
     /*
     Method Name: toString
     Purpose: Converts customer information into a formatted string representation.
@@ -81,32 +103,24 @@ public:
     - Returns a formatted string containing customer details, including their ID, username, first and last name (capitalized), age, credit card, and total reward points.
     */
     std::string toString(int customerNumber) const {
-        return "Customer " + std::to_string(customerNumber) + "\n" +
-               "\tID: " + userID + "\n" +
-               "\tUser name: " + username + "\n" +
-               "\tFirst Name: " + capitalize(firstName) + "\n" +
-               "\tLast Name: " + capitalize(lastName) + "\n" +
-               "\tAge: " + std::to_string(age) + "\n" +
-               "\tCredit Card: " + creditCard + "\n" +
-               "\tTotal Reward Points: " + std::to_string(rewardPoints) + "\n";
+        return formatCustomerRecord(toRecord(customerNumber));
     }
 
     /*
     Method Name: saveAccountToFile
-    Purpose: Appends the current customer's information to the "customers.txt" file.
+    Purpose: Appends the current customer's information to the "customers.txt" file and the in-memory customer index.
     Meaning of Parameters:
     - int customerNumber: The customer number to include in the saved data.
     Description of Return Values:
-    - This method does not return a value. It writes the customer's data to the file or outputs an error message if the file cannot be opened.
+    - Returns `true` if the customer's data was written.
+    - Returns `false` if it could not be; the customer store outputs the error message.
     */
-    void saveAccountToFile(int customerNumber) const {
-        std::ofstream outfile("customers.txt", std::ios::app);
-        if (outfile.is_open()) {
-            outfile << toString(customerNumber); // Save this specific account's data
-            outfile.close();
+    bool saveAccountToFile(int customerNumber) const {
+        if (customerStore.append(toRecord(customerNumber))) {
             std::cout << "Account saved successfully.\n";
+            return true;
         } else {
-            std::cerr << "Error: Could not open customers.txt file.\n";
+            return false;
         }
     }
     /*
@@ -137,37 +151,34 @@ public:
     Meaning of Parameters:
     - int count: The new customer count to be written to the file.
     Description of Return Values:
-    - This function does not return a value. It writes the updated count to the file if it is successfully opened.
+    - This function does not return a value. It replaces the file with the updated count, or outputs an error message and keeps the old count.
     */
     static void updateCustomerCount(int count) {
-        std::ofstream outfile("customer_count.txt");
-        if (outfile.is_open()) {
-            outfile << count;
-            outfile.close();
-        }
-        else {
-            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-        }
+        replaceFile("customer_count.txt", std::to_string(count));
     }
 };
 
 /*
 Function Name: generateUserID
-Purpose: Generates a unique customer ID by appending "CustID" to a random 10-digit number.
+Purpose: Generates a unique customer ID from the next 10-digit number of the customer ID generator.
 Meaning of Parameters:
   - None.
 Description of Return Values:
-  - Returns a string containing the newly generated unique customer ID.
-  - Ensures the ID does not already exist in the `customerIDs` set.
+  - Returns the newly generated unique customer ID.
+  - Returns CustomerId() (0) if the generator cannot issue one; it outputs the error.
 */
-std::string generateUserID() {
-    std::srand(std::time(nullptr));
-    std::string newID;
+CustomerId generateUserID() {
+    std::uint64_t number = 0;
+    // The generator never repeats itself; the do-while loop only skips an ID that was picked at random before it existed
     do {
-        newID = "CustID" + std::to_string(1000000000 + std::rand() % 9000000000);
-    } while (customerIDs.find(newID) != customerIDs.end());
-    customerIDs.insert(newID);
-    return newID;
+        if (!customerIdGenerator.nextNumber(number)) {
+            return CustomerId();
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    } while (customerIDs.contains(static_cast<CustomerId>(number)));
+    customerIDs.insert(static_cast<CustomerId>(number));
+    return static_cast<CustomerId>(number);
 }
 
 // Customer Validation Start
@@ -186,76 +197,112 @@ bool validateAge(int age) {
 }
 
 /*
-Function Name: validateCreditCard
-Purpose: Validates the format and uniqueness of a credit card number.
+Function Name: usernameTaken
+Purpose: Checks whether a customer already has a username. The username filter rules out almost every new name on its own; only a possible hit is confirmed against the customer store.
 Meaning of Parameters:
-  - std::string& cardNumber: The credit card number to validate, provided as a string (expected in the format XXXX-XXXX-XXXX).
-  - std::unordered_set<std::string>& existingCards: A set of strings containing existing credit card numbers to check for duplicates.
+  - const std::string& username: The username to check.
 Description of Return Values:
-  - Returns `true` if the credit card number is valid in format and does not already exist in the provided set.
-  - Returns `false` if the format is incorrect or if the card number already exists.
+  - Returns `true` if a customer who has not been removed has this username.
+  - Returns `false` otherwise; a possible hit that turns out not to be one is counted in the filter's stats.
 */
-bool validateCreditCard(const std::string& cardNumber, const std::unordered_set<std::string>& existingCards) {
-    if (existingCards.find(cardNumber) != existingCards.end()) {
-        std::cerr << "Invalid credit card format or card already exists.\n";
+static bool usernameTaken(const std::string& username) {
+    if (!usernameFilter.mightContain(username)) {
         return false;
+    } else if (customerStore.findByUsername(username) != nullptr) {
+        return true;
     } else {
-        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        usernameFilter.recordFalsePositive();
+        return false;
     }
+}
 
-    if (cardNumber.size() != 14 || cardNumber[4] != '-' || cardNumber[9] != '-') {
-        std::cerr << "Invalid credit card format.\n";
+/*
+Function Name: creditCardTaken
+Purpose: Checks whether a customer already has a credit card number, consulting the credit card filter first like usernameTaken.
+Meaning of Parameters:
+  - const std::string& cardNumber: The card number to check.
+Description of Return Values:
+  - Returns `true` if a customer who has not been removed has this card.
+  - Returns `false` otherwise; a possible hit that turns out not to be one is counted in the filter's stats.
+*/
+static bool creditCardTaken(const std::string& cardNumber) {
+    if (!creditCardFilter.mightContain(cardNumber)) {
         return false;
+    } else if (customerStore.findByCreditCard(cardNumber) != nullptr) {
+        return true;
+    } else {
+        creditCardFilter.recordFalsePositive();
+        return false;
+    }
+}
+
+/*
+Function Name: creditCardProblem
+Purpose: Checks the format and uniqueness of a credit card number without printing anything, for callers that report the problem their own way.
+Meaning of Parameters:
+  - const std::string& cardNumber: The credit card number to check (expected in the format XXXX-XXXX-XXXX).
+Description of Return Values:
+  - Returns an empty string if the card number is valid in format and no customer has it yet.
+  - Returns the reason it was rejected otherwise.
+*/
+std::string creditCardProblem(const std::string& cardNumber) {
+    if (creditCardTaken(cardNumber)) {
+        return "Invalid credit card format or card already exists.";
+    } else if (cardNumber.size() != 14 || cardNumber[4] != '-' || cardNumber[9] != '-') {
+        return "Invalid credit card format.";
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
     // Validates that all characters in the credit card number are digits except for hyphens at positions 4 and 9.
     for (int i = 0; i < 14; ++i) {
-        if (i == 4 || i == 9) {
-            continue;
-        } else {
-            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-        }
-        if (!std::isdigit(cardNumber[i])) {
-            std::cerr << "Invalid credit card format.\n";
-            return false;
+        if (i != 4 && i != 9 && !std::isdigit(cardNumber[i])) {
+            return "Invalid credit card format.";
         } else {
             ; // Null Statement: to satisify requirement that every if block has a corresponding else.
         }
     }
 
     if (cardNumber[0] == '0') {
-        std::cerr << "Invalid credit card format: Card number cannot start with 0.\n";
-        return false;
+        return "Invalid credit card format: Card number cannot start with 0.";
     } else {
-        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        return "";
     }
-
-    return true;
 }
 
 /*
-Function Name: validateUsername
-Purpose: Validates the format and uniqueness of a username.
+Function Name: validateCreditCard
+Purpose: Validates the format and uniqueness of a credit card number.
 Meaning of Parameters:
-  - const std::string& username: The username to validate, provided as a string.
-  - const std::unordered_set<std::string>& existingUsernames: A set containing existing usernames to check for duplicates.
+  - std::string& cardNumber: The credit card number to validate, provided as a string (expected in the format XXXX-XXXX-XXXX).
 Description of Return Values:
-  - Returns `true` if the username is valid in format and does not already exist in the provided set.
-  - Returns `false` if the format is incorrect or if the username already exists.
+  - Returns `true` if the credit card number is valid in format and no customer has it yet.
+  - Returns `false` and outputs the reason if the format is incorrect or if the card number already exists.
 */
-bool validateUsername(const std::string& username, const std::unordered_set<std::string>& existingUsernames) {
-    if (existingUsernames.find(username) != existingUsernames.end()) {
-        std::cerr << "Invalid username or username already exists.\n";
+bool validateCreditCard(const std::string& cardNumber) {
+    std::string problem = creditCardProblem(cardNumber);
+    if (!problem.empty()) {
+        std::cerr << problem << "\n";
         return false;
     } else {
-        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        return true;
     }
+}
 
-    if (username.size() != 10 || username.substr(0, 2) != "U_") {
-        std::cerr << "Invalid format: Username must start with 'U_' and be exactly 10 characters long.\n";
-        return false;
+/*
+Function Name: usernameProblem
+Purpose: Checks the format and uniqueness of a username without printing anything, for callers that report the problem their own way.
+Meaning of Parameters:
+  - const std::string& username: The username to check.
+Description of Return Values:
+  - Returns an empty string if the username is valid in format and no customer has it yet.
+  - Returns the reason it was rejected otherwise.
+*/
+std::string usernameProblem(const std::string& username) {
+    if (usernameTaken(username)) {
+        return "Invalid username or username already exists.";
+    } else if (username.size() != 10 || username.substr(0, 2) != "U_") {
+        return "Invalid format: Username must start with 'U_' and be exactly 10 characters long.";
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
@@ -269,21 +316,35 @@ bool validateUsername(const std::string& username, const std::unordered_set<std:
         } else if (std::isdigit(username[i])) {
             digitCount++;
         } else {
-            std::cerr << "Invalid format: Username can only contain letters and numbers after 'U_'.\n";
-            return false;
+            return "Invalid format: Username can only contain letters and numbers after 'U_'.";
         }
     }
 
     // Validates that the username (after 'U_') follows one of the allowed letter-to-digit combinations: 
     // 5 letters and 3 digits, 6 letters and 2 digits, 7 letters and 1 digit, or 8 letters and 0 digits.
-    if ((letterCount == 5 && digitCount == 3) ||
-        (letterCount == 6 && digitCount == 2) ||
-        (letterCount == 7 && digitCount == 1) ||
-        (letterCount == 8 && digitCount == 0)) {
-        return true;
+    if (letterCount + digitCount == 8 && digitCount <= 3 && letterCount >= 5) {
+        return "";
     } else {
-        std::cerr << "Invalid format: Username must follow one of the required letter-number combinations after 'U_'.\n";
+        return "Invalid format: Username must follow one of the required letter-number combinations after 'U_'.";
+    }
+}
+
+/*
+Function Name: validateUsername
+Purpose: Validates the format and uniqueness of a username.
+Meaning of Parameters:
+  - const std::string& username: The username to validate, provided as a string.
+Description of Return Values:
+  - Returns `true` if the username is valid in format and no customer has it yet.
+  - Returns `false` and outputs the reason if the format is incorrect or if the username already exists.
+*/
+bool validateUsername(const std::string& username) {
+    std::string problem = usernameProblem(username);
+    if (!problem.empty()) {
+        std::cerr << problem << "\n";
         return false;
+    } else {
+        return true;
     }
 }
 
@@ -302,13 +363,45 @@ bool validateName(const std::string& name) {
 //Customer validation end
 
 //Creates an account instance start
+/*
+Function Name: createAccount
+Purpose: Saves a new customer account from details that have already been validated, and reserves its username and credit card.
+Meaning of Parameters:
+  - const std::string& username: The validated username.
+  - const std::string& firstName: The validated first name.
+  - const std::string& lastName: The validated last name.
+  - int age: The validated age.
+  - const std::string& creditCard: The validated credit card number.
+Description of Return Values:
+  - Returns the new customer's ID.
+  - Returns CustomerId() (0) and outputs an error message if no customer ID could be issued or the account could not be written.
+*/
+CustomerId createAccount(const std::string& username, const std::string& firstName, const std::string& lastName, int age, const std::string& creditCard) {
+    int customerNumber = Account::readCustomerCount();
+    Account account(username, firstName, lastName, age, creditCard);
+    if (account.userID == CustomerId() || !account.saveAccountToFile(customerNumber)) {
+        std::cerr << "Account not created.\n";
+        return CustomerId();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    //Updates the count in the customer_count.txt and stores the value dynamically
+    int newCount = customerNumber + 1;
+    Account::updateCustomerCount(newCount);
+
+    usernameFilter.add(username);
+    creditCardFilter.add(creditCard);
+    return account.userID;
+}
+
 /*
 Function Name: addAccount
 Purpose: Collects user input to create a new customer account, validates the input, and saves the account information to a file.
 Meaning of Parameters:
   - None.
 Description of Return Values:
-  - This function does not return a value. It performs operations such as input validation, file updates, and updating in-memory sets of existing usernames and credit cards.
+  - This function does not return a value. It performs operations such as input validation, file updates, and updating the username and credit card filters.
 */
 void addAccount() {
     std::string username, firstName, lastName, creditCard;
@@ -324,16 +417,7 @@ void addAccount() {
 
     creditCard = creditCardCreation();
 
-    int customerNumber = Account::readCustomerCount();
-    Account account(username, firstName, lastName, age, creditCard);
-    account.saveAccountToFile(customerNumber);
-
-    //Updates the count in the customer_count.txt and stores the value dynamically
-    int newCount = customerNumber + 1;
-    Account::updateCustomerCount(newCount);
-
-    existingUsernames.insert(username);
-    existingCreditCards.insert(creditCard);
+    createAccount(username, firstName, lastName, age, creditCard);
 }
 
 /*
@@ -350,7 +434,7 @@ std::string userNameCreation()
 
     std::cout << "Enter a username that starts with 'U_' and is a maximum of 10 characters (including 'U_'): ";
     std::cin >> username;
-    if (!validateUsername(username, existingUsernames)) {
+    if (!validateUsername(username)) {
         return userNameCreation();
     } else {
         return username;
@@ -437,7 +521,7 @@ std::string creditCardCreation()
 
     std::cout << "Enter credit card (xxxx-xxxx-xxxx format): ";
     std::cin >> creditCard;
-    if (!validateCreditCard(creditCard, existingCreditCards)) {
+    if (!validateCreditCard(creditCard)) {
         std::cerr << "Invalid credit card format or card already exists.\n";
         return creditCardCreation();
     } else {
@@ -456,112 +540,51 @@ Description of Return Values:
 void displayCustomerInfo(const std::string& customerID) {
     customersTxtChecker();
 
-    std::ifstream infile("customers.txt");
-
-    std::string line;
-    std::string fullCustomerID = "ID: CustID" + customerID; // Add "CustID" prefix to the input number
-    bool found = false;
-    int lineCounter = 0;
-
-    // The while loop reads each line of the "customers.txt" file, trims it, and checks if it matches the fullCustomerID;
-    // if a match is found, it prints the customer's details (the matching line and the next 6 lines) and stops further reading.
-    while (std::getline(infile, line)) {
-        
-        line = trim(line);
-        // Check for the matching customer ID line
-        if (line == fullCustomerID) {
-            found = true;
-            std::cout << "Customer Details:\n";
-            std::cout << "\t"<< line << "\n"; // Print the customer ID line
-
-            // Print the following 6 lines to display all details
-            for (int i = 0; i < 6; ++i) {
-                if (std::getline(infile, line)) {
-                    std::cout << line << "\n";
-                }
-            }
-            break;
-        }
-        else {
-            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-        }
-    }
-
-    infile.close();
+    CustomerId id{};
+    const CustomerRecord* record = parseCustomerId(customerID, id) ? customerStore.find(id) : nullptr;
 
-    if (!found) {
-        std::cerr << "Customer with " << fullCustomerID << " not found.\n";
+    if (record == nullptr) {
+        std::cerr << "Customer with ID: CustID" << customerID << " not found.\n";
+        return;
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
+
+    // Print everything after the "Customer N" header line
+    std::string details = formatCustomerRecord(*record);
+    std::cout << "Customer Details:\n";
+    std::cout << details.substr(details.find('\n') + 1);
 }
 
 /*
 Function Name: removeAccount
 Purpose: Removes a customer account from the "customers.txt" file based on the provided account ID and updates the customer count.
 Meaning of Parameters:
-  - const std::string& accountID: The ID of the account to be removed from the file.
+  - const std::string& accountID: The ID of the account to be removed from the file, as typed ("CustID##########").
 Description of Return Values:
-  - This function does not return a value. It updates the "customers.txt" file by removing the specified account and rewrites the file, or outputs error messages if issues occur.
+  - Returns `true` if the removal was recorded in "customers.removed.txt" (the customer file is compacted later).
+  - Returns `false` and outputs an error message if the account does not exist or the removal could not be written.
 */
-void removeAccount(const std::string& accountID) {
-    std::ifstream inFile("customers.txt");
-    if (!inFile) {
-        std::cerr << "Error opening file for reading.\n";
-        return;
-    } else {
-        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-    }
-
-    std::vector<std::string> fileContents;
-    std::string line;
-    bool accountFound = false;
-    bool skip = false;
-
-    // Read each line and decide whether to keep or skip it
-    while (getline(inFile, line)) {
-        if (!skip && line.find("ID: " + accountID) != std::string::npos) {
-            // Start skipping lines for the account to remove
-            accountFound = true;
-            skip = true;
-        } else {
-            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-        }
-        if (skip) {
-            // Keep skipping until we reach a new customer or end of account data
-            if (line.empty() || line.find("Customer") != std::string::npos) {
-                skip = false;  // Stop skipping at the end of the account
-            }
-        } else {
-            fileContents.push_back(line); // Add the line if not skipping
-        }
-    }
-    inFile.close();
-
-    if (!accountFound) {
+bool removeAccount(const std::string& accountID) {
+    CustomerId id{};
+    if (!parseCustomerId(accountID, id) || !customerStore.contains(id)) {
         std::cout << "Account ID not found.\n";
-        return;
+        return false;
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    // Rewrite the file with remaining accounts
-    std::ofstream outFile("customers.txt", std::ios::trunc);
-    if (!outFile) {
+    // Hide the record and log its removal; the file is only rewritten once enough records are removed
+    if (!customerStore.remove(id)) {
         std::cerr << "Error opening file for writing.\n";
-        return;
+        return false;
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    for (size_t i = 0; i < fileContents.size(); ++i) {
-        const std::string& contentLine = fileContents[i];
-        outFile << contentLine << "\n";
-    }
-
-    outFile.close();
     deincrement_count("customer_count.txt");
     std::cout << "Account removed successfully.\n";
+    return true;
 }
 
 /*
@@ -575,153 +598,104 @@ Description of Return Values:
 */
 bool validateCustomerID(const std::string& customerID) {
     customersTxtChecker();
-    std::ifstream infile("customers.txt");
-    if (!infile.is_open()) {
-        std::cerr << "Error: Could not open customers.txt file.\n";
-        return false;
+
+    CustomerId id{};
+    if (parseCustomerId(trim(customerID), id) && customerStore.find(id) != nullptr) {
+        std::cout << "\nCustomer ID '" << customerID << "' found.\n";
+        return true;
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    std::string line;
-    std::string fullCustomerID = "ID: CustID" + customerID;
-    fullCustomerID = trim(fullCustomerID);  // Trim any extra spaces from the fullCustomerID if needed
-
-    // The while loop reads each line from the "customers.txt" file, trims it, and checks if it matches the fullCustomerID;
-    // if a match is found, it outputs a success message and returns true, otherwise, it continues searching until the end of the file.
-    while (std::getline(infile, line)) {
-        line = trim(line);  // Trim each line before checking
-        if (line == fullCustomerID) { // Exact match comparison
-            std::cout << "\nCustomer ID '" << customerID << "' found.\n";
-            return true;
-        } else {
-            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-        }
-    }
-
     std::cout << "\nCustomer ID '" << customerID << "' not found.\n";
     return false;
 }
 
 /*
 Function Name: calculateRewardPoints
-Purpose: Calculates reward points based on the total transaction amount.
+Purpose: Calculates reward points based on the total transaction amount, using the configured reward rules with no product multipliers.
 Meaning of Parameters:
-  - double totalAmount: The total amount of the transaction, used to compute reward points.
+  - Money totalAmount: The total amount of the transaction, used to compute reward points.
 Description of Return Values:
   - Returns an integer representing the total reward points earned based on the transaction amount.
 */
-int calculateRewardPoints(double totalAmount){
-    int fullChunks = static_cast<int>(totalAmount / 5);
-    double remainder = totalAmount - (fullChunks*5);
-    int rewardPoints = (fullChunks*10) + static_cast<int>((remainder/5) * 10); 
+int calculateRewardPoints(Money totalAmount){
+    return rewardRules.points(totalAmount, totalAmount.cents() * rewardScale);
+}
 
-    return rewardPoints;
+/*
+Function Name: calculateRewardPoints (batch)
+Purpose: Calculates reward points for a whole array of transaction totals at once, for re-scoring history after the reward rules change. Uses SSE2 or AVX2 when the CPU has them.
+Meaning of Parameters:
+  - const Money* totalAmounts: The transaction totals.
+  - int* rewardPoints: Receives the reward points for each total; must have room for `count` values.
+  - std::size_t count: How many totals there are.
+Description of Return Values:
+  - This function does not return a value. Each result equals calculateRewardPoints for the same total.
+*/
+void calculateRewardPoints(const Money* totalAmounts, int* rewardPoints, std::size_t count) {
+    rewardRules.pointsBatch(totalAmounts, rewardPoints, count);
 }
 
 /*
 Function Name: readAndModifyCustomerRewards
-Purpose: Reads customer data from the "customers.txt" file, updates reward points for a specified customer, and returns the updated lines.
+Purpose: Looks up a customer in the in-memory customer index and updates their reward points. Safe to call from several threads at once.
 Meaning of Parameters:
-  - const std::string& customerID: The ID of the customer whose reward points are to be modified.
+  - CustomerId customerID: The customer whose reward points are to be modified.
   - int newRewardPoints: The reward points to be added or subtracted from the customer's total.
   - bool& customerFound: A reference variable indicating whether the specified customer ID was found.
   - int menuFlag: Determines the operation. If `menuFlag` is 5, reward points are added; otherwise, they are subtracted.
 Description of Return Values:
-  - Returns a `std::vector<std::string>` containing the updated lines of the "customers.txt" file.
-  - If the customer is not found, the lines remain unchanged, and `customerFound` is set to false.
+  - Returns the customer's updated reward point total.
+  - Returns -1 if the customer is not found, and `customerFound` is set to false.
 */
-std::vector<std::string> readAndModifyCustomerRewards(const std::string& customerID, int newRewardPoints, bool& customerFound, int menuFlag) {
-    std::ifstream infile("customers.txt");
-    std::vector<std::string> lines;
-    customerFound = false;
-
-    customersTxtChecker();
-
-    std::string line;
-    // The while loop reads each line from the "customers.txt" file, searches for a customer matching the given ID, and updates the reward points if found; it stores all lines in a vector, modifying only the relevant customer's details.
-    while (getline(infile, line)) {
-        if (line.find("ID: CustID" + customerID) != std::string::npos) {
-            lines.push_back(line); // Customer ID line
-            getline(infile, line); // Username line
-            lines.push_back(line);
-            getline(infile, line); // First Name line
-            lines.push_back(line);
-            getline(infile, line); // Last Name line
-            lines.push_back(line);
-            getline(infile, line); // Age line
-            lines.push_back(line);
-            getline(infile, line); // Credit Card line
-            lines.push_back(line);
-
-            // Modify the Total Reward Points line
-            getline(infile, line);
-            int currentRewardPoints = 0;
-
-            size_t pos = line.find(":");
-            if (pos != std::string::npos){
-                std::string currentPointsStr = line.substr(pos+1);
-                currentRewardPoints = std::stoi(currentPointsStr);
-            } else {
-                ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-            }
-
-            int updatedRewardPoints = customerRewardUpdatePath(menuFlag, currentRewardPoints, newRewardPoints);
-            std::stringstream ss;
-            ss << "\tTotal Reward Points: " << updatedRewardPoints;
-            lines.push_back(ss.str());
-
-            customerFound = true;
-        } else {
-            lines.push_back(line);
-        }
-    }
-
-    infile.close();
-    return lines;
+int readAndModifyCustomerRewards(CustomerId customerID, int newRewardPoints, bool& customerFound, int menuFlag) {
+    int balance = -1;
+    // Only this customer's record lock is held, so server threads updating other customers carry on
+    customerFound = customerStore.addRewardPoints(customerID, customerRewardUpdatePath(menuFlag, 0, newRewardPoints), balance);
+    return balance;
 }
 
 /*
 Function Name: writeUpdatedCustomerData
-Purpose: Writes updated customer data back to the "customers.txt" file.
+Purpose: Records a customer's reward balance change through the persistence queue and the customer store, which append it to the reward ledger or write it back to the customer file.
 Meaning of Parameters:
-  - const std::vector<std::string>& lines: A vector containing the updated lines to be written to the file.
+  - CustomerId customerID: The customer whose reward points changed.
+  - int delta: The signed number of points added or removed.
+  - int menuFlag: The menu option behind the change. 5 is logged as a "purchase"; anything else as a "redeem".
+  - const std::string& reference: The transaction ID or reward product ID behind the change.
 Description of Return Values:
   - This function does not return a value. It writes the updated customer data to the file and confirms success with a console message.
 */
-void writeUpdatedCustomerData(const std::vector<std::string>& lines) {
-    std::ofstream outfile("customers.txt");
-
-    customersTxtChecker();
-
-    // Expanded loop for writing each line to the file
-    for (std::size_t i = 0; i < lines.size(); ++i) {
-        outfile << lines[i] << "\n";
+void writeUpdatedCustomerData(CustomerId customerID, int delta, int menuFlag, const std::string& reference) {
+    std::string reason = (menuFlag == 5) ? "purchase" : "redeem";
+    if (persistenceQueue.persistRewardPoints(customerID, delta, reason, reference)) {
+        std::cout << "\nCustomer data updated successfully.\n";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
-
-    outfile.close();
-    std::cout << "\nCustomer data updated successfully.\n";
 }
 
 /*
 Function Name: updateCustomerRewards
-Purpose: Updates the reward points for a specified customer and writes the changes back to the "customers.txt" file.
+Purpose: Updates the reward points for a specified customer and records the change in the reward ledger or the customer file.
 Meaning of Parameters:
-  - const std::string& customerID: The ID of the customer whose reward points are to be updated.
+  - CustomerId customerID: The customer whose reward points are to be updated.
   - int newRewardPoints: The reward points to be added or subtracted.
   - int menuFlag: Determines the operation. If `menuFlag` is 5, reward points are added; otherwise, they are subtracted.
+  - const std::string& reference: The transaction ID (purchases) or reward product ID (redemptions) recorded with the change.
 Description of Return Values:
   - This function does not return a value. It updates the customer's reward points if the customer is found or outputs an error message if the customer does not exist.
 */
-void updateCustomerRewards(const std::string& customerID, int newRewardPoints, int menuFlag) {
+void updateCustomerRewards(CustomerId customerID, int newRewardPoints, int menuFlag, const std::string& reference) {
     bool customerFound;
-    std::vector<std::string> lines = readAndModifyCustomerRewards(customerID, newRewardPoints, customerFound, menuFlag);
+    readAndModifyCustomerRewards(customerID, newRewardPoints, customerFound, menuFlag);
 
     if (customerFound) {
-        writeUpdatedCustomerData(lines);
-        std::cout << "\n" << newRewardPoints << " Reward points updated successfully for customer ID: " << customerID << "\n";
+        writeUpdatedCustomerData(customerID, customerRewardUpdatePath(menuFlag, 0, newRewardPoints), menuFlag, reference);
+        std::cout << "\n" << newRewardPoints << " Reward points updated successfully for customer ID: " << idDigits(customerID) << "\n";
     } else {
-        std::cerr << "\nCustomer with ID " << customerID << " not found.\n";
+        std::cerr << "\nCustomer with ID " << idDigits(customerID) << " not found.\n";
     }
 }
 
@@ -2,19 +2,27 @@
 #define CUSTOMERS_H
 
 /* Declarations for customer-related classes and functions */
+class Money;
+enum class CustomerId : std::uint64_t;
 
 void customersTxtChecker();
 bool validateCustomerID(const std::string& customerID);
 void deincrement_count(const std::string& fileName);
 void addAccount();
-void removeAccount(const std::string& accountID);
+CustomerId createAccount(const std::string& username, const std::string& firstName, const std::string& lastName, int age, const std::string& creditCard);
+bool validateAge(int age);
+bool validateName(const std::string& name);
+std::string usernameProblem(const std::string& username);
+std::string creditCardProblem(const std::string& cardNumber);
+bool removeAccount(const std::string& accountID);
 void displayCustomerInfo(const std::string& customerID);
-std::string generateUserID();
+CustomerId generateUserID();
 bool validateCustomerID(const std::string& customerID);
-int calculateRewardPoints(double totalAmount);
-std::vector<std::string> readAndModifyCustomerRewards(const std::string& customerID, int newRewardPoints, bool& customerFound, int menuFlag);
-void writeUpdatedCustomerData(const std::vector<std::string>& lines);
-void updateCustomerRewards(const std::string& customerID, int newRewardPoints, int menuFlag);
+int calculateRewardPoints(Money totalAmount);
+void calculateRewardPoints(const Money* totalAmounts, int* rewardPoints, std::size_t count);
+int readAndModifyCustomerRewards(CustomerId customerID, int newRewardPoints, bool& customerFound, int menuFlag);
+void writeUpdatedCustomerData(CustomerId customerID, int delta, int menuFlag, const std::string& reference);
+void updateCustomerRewards(CustomerId customerID, int newRewardPoints, int menuFlag, const std::string& reference);
 int customerRewardUpdatePath(int menuFlag, int currentRewardPoints, int newRewardPoints);
 std::string userNameCreation();
 std::string firstNameCreation();
@@ -0,0 +1,135 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include "durableFile.h"
+
+/*
+****************************************************************************
+*************************** DURABLE FILE START *****************************
+****************************************************************************
+*/
+
+/*
+Function Name: replacementFileName
+Purpose: Names the temporary file a replacement of a data file is written to.
+Meaning of Parameters:
+  - const std::string& fileName: The data file.
+Description of Return Values:
+  - Returns the file name with ".tmp" appended, which keeps it in the same directory and so on the same file system. The name is the same every time so recovery can find it; replacements of one file must therefore not run concurrently.
+*/
+std::string replacementFileName(const std::string& fileName) {
+    return fileName + ".tmp";
+}
+
+/*
+Function Name: writeContents
+Purpose: Writes a whole buffer to a file, finishing any partial write.
+Meaning of Parameters:
+  - int fd: The file.
+  - std::string_view contents: The bytes to write.
+Description of Return Values:
+  - Returns `true` if every byte was written.
+  - Returns `false` if a write failed; errno says why.
+*/
+static bool writeContents(int fd, std::string_view contents) {
+    std::size_t done = 0;
+    while (done < contents.size()) {
+        ssize_t written = ::write(fd, contents.data() + done, contents.size() - done);
+        if (written < 0 && errno != EINTR) {
+            return false;
+        } else {
+            done += (written > 0) ? static_cast<std::size_t>(written) : 0;
+        }
+    }
+    return true;
+}
+
+/*
+Function Name: syncDirectory
+Purpose: Syncs the directory holding a file, so a rename into it survives a crash.
+Meaning of Parameters:
+  - const std::string& fileName: The file whose directory is synced.
+Description of Return Values:
+  - Returns `true` if the directory was synced.
+  - Returns `false` if it could not be opened or synced; errno says why.
+*/
+static bool syncDirectory(const std::string& fileName) {
+    std::size_t slash = fileName.find_last_of('/');
+    std::string directory = (slash == std::string::npos) ? "." : fileName.substr(0, (slash == 0) ? 1 : slash);
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    bool synced = fd >= 0 && ::fsync(fd) == 0;
+    int error = errno;
+    if (fd >= 0) {
+        ::close(fd);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    errno = error;
+    return synced;
+}
+
+/*
+Function Name: replaceFile
+Purpose: Replaces a data file with new contents so that a crash leaves either the old file or the new one, never a mix. The contents are written with one write to the temporary file, synced with fdatasync (which also syncs the file size), renamed over the data file, and the directory is synced so the rename itself is durable.
+Meaning of Parameters:
+  - const std::string& fileName: The data file to replace or create. The caller must be its only writer while this runs.
+  - std::string_view contents: Its complete new contents.
+Description of Return Values:
+  - Returns `true` once the new contents are durable under the real name.
+  - Returns `false` and outputs an error message otherwise. The old file is untouched if the rename was not reached.
+*/
+bool replaceFile(const std::string& fileName, std::string_view contents) {
+    std::string tempName = replacementFileName(fileName);
+    int fd = ::open(tempName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    bool written = fd >= 0 && writeContents(fd, contents) && ::fdatasync(fd) == 0;
+    int error = errno;
+    if (fd >= 0) {
+        ::close(fd);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (!written || std::rename(tempName.c_str(), fileName.c_str()) != 0) {
+        error = written ? errno : error;
+        std::cerr << "Error: Could not write " << fileName << " file: " << std::strerror(error) << "\n";
+        std::remove(tempName.c_str());
+        return false;
+    } else if (!syncDirectory(fileName)) {
+        std::cerr << "Error: Could not sync the directory of " << fileName << ": " << std::strerror(errno) << "\n";
+        return false;
+    } else {
+        return true;
+    }
+}
+
+/*
+Function Name: removeInterruptedReplacements
+Purpose: Looks for temporary files left by replacements that a crash cut short, and removes them. Such a file never reached the rename, so the data file still holds its last complete contents and the temporary file may be incomplete.
+Meaning of Parameters:
+  - const std::vector<std::string>& fileNames: The data files whose temporary files to look for.
+Description of Return Values:
+  - Returns the number of temporary files removed; each is reported on std::cerr.
+*/
+std::size_t removeInterruptedReplacements(const std::vector<std::string>& fileNames) {
+    std::size_t removed = 0;
+    for (std::size_t i = 0; i < fileNames.size(); ++i) {
+        std::string tempName = replacementFileName(fileNames[i]);
+        if (std::remove(tempName.c_str()) == 0) {
+            std::cerr << "Warning: Removed " << tempName << ", left by an interrupted write; " << fileNames[i]
+                      << " keeps its last complete contents.\n";
+            ++removed;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return removed;
+}
+
+/*
+****************************************************************************
+**************************** DURABLE FILE END ******************************
+****************************************************************************
+*/
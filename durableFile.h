@@ -0,0 +1,21 @@
+#ifndef DURABLEFILE_H
+#define DURABLEFILE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* Declarations for replacing whole data files without ever leaving a half-written one behind */
+
+// A file is replaced by writing the new contents to "<file>.tmp" in the same directory, syncing it, renaming it over
+// the old file and syncing the directory. A crash at any point leaves either the complete old file or the complete
+// new one under the real name; at worst a stray temporary file, which removeInterruptedReplacements clears up.
+// The temporary name is fixed so that recovery can find it, which means each file may only have one writer at a time:
+// callers must hold the lock that guards the file's contents (or run on the persistence queue's writer thread) while
+// replacing it. Two concurrent replacements of the same file would write into the same temporary file.
+
+std::string replacementFileName(const std::string& fileName);
+bool replaceFile(const std::string& fileName, std::string_view contents);
+std::size_t removeInterruptedReplacements(const std::vector<std::string>& fileNames);
+
+#endif // DURABLEFILE_H
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cstring>
+#include "flatSet.h"
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+/*
+****************************************************************************
+****************************** FLAT SET START ******************************
+****************************************************************************
+*/
+
+static const std::size_t groupWidth = 16;
+static const std::int8_t emptyControl = -128; // The top bit is set, so it never equals a 7-bit hash
+
+/*
+Function Name: mixHash
+Purpose: Scrambles a 64-bit value (the splitmix64 finaliser), so keys that differ in a few bytes land far apart.
+Meaning of Parameters:
+  - std::uint64_t value: The value to scramble.
+Description of Return Values:
+  - Returns the scrambled value; every input bit affects every output bit.
+*/
+static std::uint64_t mixHash(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/*
+Function Name: matchGroup
+Purpose: Compares the 16 control bytes of a group against one value; with SSE2 this is a single compare.
+Meaning of Parameters:
+  - const std::int8_t* group: The first control byte of the group.
+  - std::int8_t control: The value to look for.
+Description of Return Values:
+  - Returns a bit mask with bit i set when control byte i equals the value.
+*/
+static std::uint32_t matchGroup(const std::int8_t* group, std::int8_t control) {
+#if defined(__x86_64__)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(control))));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < groupWidth; ++i) {
+        mask |= (group[i] == control) ? (std::uint32_t(1) << i) : 0;
+    }
+    return mask;
+#endif
+}
+
+/*
+Method Name: FlatSet
+Purpose: Creates an empty set. No memory is allocated until the first key is inserted or reserve is called.
+Meaning of Parameters:
+  - std::size_t keyWidth: The longest key the set holds, in bytes, from 1 to maxKeyWidth; e.g. 16 for usernames and card numbers, 8 for IDs.
+Description of Return Values:
+  - None.
+*/
+FlatSet::FlatSet(std::size_t keyWidth) : keyWidth(std::min(std::max<std::size_t>(keyWidth, 1), maxKeyWidth)) {
+}
+
+/*
+Method Name: insert
+Purpose: Adds a text key, such as a username or credit card number.
+Meaning of Parameters:
+  - std::string_view key: The key.
+Description of Return Values:
+  - Returns `true` if the key was added.
+  - Returns `false` if it was already in the set, or is longer than the key width and cannot be stored.
+*/
+bool FlatSet::insert(std::string_view key) {
+    char padded[maxKeyWidth] = {};
+    if (key.size() > keyWidth) {
+        return false;
+    } else {
+        std::memcpy(padded, key.data(), key.size());
+        return insertPadded(padded);
+    }
+}
+
+/*
+Method Name: contains
+Purpose: Checks whether a text key is in the set.
+Meaning of Parameters:
+  - std::string_view key: The key.
+Description of Return Values:
+  - Returns `true` if the key is in the set; a key longer than the key width never is.
+*/
+bool FlatSet::contains(std::string_view key) const {
+    char padded[maxKeyWidth] = {};
+    std::size_t slot = 0;
+    if (key.size() > keyWidth || keyCount == 0) {
+        return false;
+    } else {
+        std::memcpy(padded, key.data(), key.size());
+        return findSlot(padded, hashKey(padded), slot);
+    }
+}
+
+/*
+Method Name: insertNumber
+Purpose: Adds a number, stored as its 8 bytes; backs insert for the ID types.
+Meaning of Parameters:
+  - std::uint64_t number: The number.
+Description of Return Values:
+  - Returns `true` if the number was added, `false` if it was already in the set.
+*/
+bool FlatSet::insertNumber(std::uint64_t number) {
+    char padded[maxKeyWidth] = {};
+    std::memcpy(padded, &number, sizeof(number));
+    return insertPadded(padded);
+}
+
+/*
+Method Name: containsNumber
+Purpose: Checks whether a number is in the set; backs contains for the ID types.
+Meaning of Parameters:
+  - std::uint64_t number: The number.
+Description of Return Values:
+  - Returns `true` if the number is in the set.
+*/
+bool FlatSet::containsNumber(std::uint64_t number) const {
+    char padded[maxKeyWidth] = {};
+    std::size_t slot = 0;
+    std::memcpy(padded, &number, sizeof(number));
+    return keyCount != 0 && findSlot(padded, hashKey(padded), slot);
+}
+
+/*
+Method Name: insertPadded
+Purpose: Adds a padded key, first growing the table if it would pass 7/8 full.
+Meaning of Parameters:
+  - const char* key: The key, padded with zero bytes to maxKeyWidth.
+Description of Return Values:
+  - Returns `true` if the key was added, `false` if it was already in the set.
+*/
+bool FlatSet::insertPadded(const char* key) {
+    if ((keyCount + 1) * 8 > controls.size() * 7) {
+        rehash(std::max(controls.size() * 2, groupWidth));
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::uint64_t hash = hashKey(key);
+    std::size_t slot = 0;
+    if (findSlot(key, hash, slot)) {
+        return false;
+    } else {
+        controls[slot] = static_cast<std::int8_t>(hash & 0x7F);
+        std::memcpy(keys.data() + slot * keyWidth, key, keyWidth);
+        ++keyCount;
+        return true;
+    }
+}
+
+/*
+Method Name: findSlot
+Purpose: Probes the table for a key, one group of 16 slots at a time, starting from the group its hash picks.
+Meaning of Parameters:
+  - const char* key: The key, padded with zero bytes to maxKeyWidth.
+  - std::uint64_t hash: The key's hash from hashKey.
+  - std::size_t& slot: Receives the slot holding the key, or else the first empty slot on its probe path.
+Description of Return Values:
+  - Returns `true` if the key was found, `false` if it is not in the set. The table must not be empty.
+*/
+bool FlatSet::findSlot(const char* key, std::uint64_t hash, std::size_t& slot) const {
+    std::int8_t tag = static_cast<std::int8_t>(hash & 0x7F);
+    std::size_t group = (hash >> 7) & groupMask;
+    std::size_t step = 0;
+    // The while loop moves 1, 2, 3, ... groups on from the last one, which visits every group when there is a
+    // power of two of them. The table is never full, so a group with an empty slot always ends the search.
+    while (true) {
+        const std::int8_t* groupControls = controls.data() + group * groupWidth;
+        std::uint32_t matches = matchGroup(groupControls, tag);
+        while (matches != 0) {
+            std::size_t candidate = group * groupWidth + __builtin_ctz(matches);
+            if (std::memcmp(keys.data() + candidate * keyWidth, key, keyWidth) == 0) {
+                slot = candidate;
+                return true;
+            } else {
+                matches &= matches - 1;
+            }
+        }
+
+        std::uint32_t empties = matchGroup(groupControls, emptyControl);
+        if (empties != 0) {
+            slot = group * groupWidth + __builtin_ctz(empties);
+            return false;
+        } else {
+            ++step;
+            group = (group + step) & groupMask;
+        }
+    }
+}
+
+/*
+Method Name: hashKey
+Purpose: Hashes a padded key by mixing its bytes as two 64-bit words. Reading both words whole, zero padding included, lets the copies compile to plain loads.
+Meaning of Parameters:
+  - const char* key: The key, padded with zero bytes to maxKeyWidth.
+Description of Return Values:
+  - Returns the hash; its low 7 bits go in the control byte and the rest pick the first group to probe.
+*/
+std::uint64_t FlatSet::hashKey(const char* key) const {
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+    std::memcpy(&low, key, sizeof(low));
+    std::memcpy(&high, key + sizeof(low), sizeof(high));
+    return mixHash(low ^ mixHash(high + 0x9E3779B97F4A7C15ULL));
+}
+
+/*
+Method Name: rehash
+Purpose: Moves every key into a new table of the given size.
+Meaning of Parameters:
+  - std::size_t slotCount: The new number of slots; a power of two, at least 16 and more than the number of keys.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void FlatSet::rehash(std::size_t slotCount) {
+    std::vector<std::int8_t> oldControls(slotCount, emptyControl);
+    std::vector<char> oldKeys(slotCount * keyWidth);
+    controls.swap(oldControls);
+    keys.swap(oldKeys);
+    groupMask = slotCount / groupWidth - 1;
+
+    // The for loop reinserts every full slot; the keys are known to be distinct, so each lands in the first empty slot found.
+    char padded[maxKeyWidth] = {};
+    std::size_t slot = 0;
+    for (std::size_t i = 0; i < oldControls.size(); ++i) {
+        if (oldControls[i] != emptyControl) {
+            std::memcpy(padded, oldKeys.data() + i * keyWidth, keyWidth);
+            findSlot(padded, hashKey(padded), slot);
+            controls[slot] = oldControls[i];
+            std::memcpy(keys.data() + slot * keyWidth, oldKeys.data() + i * keyWidth, keyWidth);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Method Name: reserve
+Purpose: Grows the table once so the given number of keys fits without growing again while it fills.
+Meaning of Parameters:
+  - std::size_t count: How many keys the set should hold.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void FlatSet::reserve(std::size_t count) {
+    std::size_t slotCount = groupWidth;
+    while (slotCount * 7 < count * 8) {
+        slotCount *= 2;
+    }
+
+    if (slotCount > controls.size()) {
+        rehash(slotCount);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: clear
+Purpose: Removes every key and keeps the table's memory for refilling.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void FlatSet::clear() {
+    std::fill(controls.begin(), controls.end(), emptyControl);
+    keyCount = 0;
+}
+
+/*
+Method Name: size
+Purpose: Reports how many keys are in the set.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the number of keys.
+*/
+std::size_t FlatSet::size() const {
+    return keyCount;
+}
+
+/*
+Method Name: memoryBytes
+Purpose: Reports how much memory the set holds, for the benchmarks.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the bytes of the control and key arrays plus the set itself.
+*/
+std::size_t FlatSet::memoryBytes() const {
+    return sizeof(*this) + controls.capacity() + keys.capacity();
+}
+
+/*
+****************************************************************************
+******************************* FLAT SET END *******************************
+****************************************************************************
+*/
@@ -0,0 +1,66 @@
+#ifndef FLATSET_H
+#define FLATSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "recordId.h"
+
+/* Declarations for the flat hash set behind the global ID, username and credit card tables */
+
+// An open-addressing hash set of short keys, laid out like a Swiss table: every key is stored inline in a
+// fixed-width slot, next to a one-byte control array holding 7 bits of its hash. A lookup compares a group of
+// 16 control bytes at once and only touches the key slots whose bits match, so there are no nodes to allocate
+// and no pointers to chase. Text keys shorter than the width are padded with zero bytes, so they must not hold
+// any themselves. Nothing is ever erased; records that are removed keep their ID, username and card reserved.
+class FlatSet {
+public:
+    static const std::size_t maxKeyWidth = 16;
+
+    explicit FlatSet(std::size_t keyWidth);
+
+    bool insert(std::string_view key);
+    bool contains(std::string_view key) const;
+
+    // The ID sets hold the 8 bytes of the ID's number, so they need a key width of at least 8
+    bool insert(CustomerId id) {
+        return insertNumber(static_cast<std::uint64_t>(id));
+    }
+    bool insert(ProductId id) {
+        return insertNumber(static_cast<std::uint64_t>(id));
+    }
+    bool insert(TransactionId id) {
+        return insertNumber(static_cast<std::uint64_t>(id));
+    }
+    bool contains(CustomerId id) const {
+        return containsNumber(static_cast<std::uint64_t>(id));
+    }
+    bool contains(ProductId id) const {
+        return containsNumber(static_cast<std::uint64_t>(id));
+    }
+    bool contains(TransactionId id) const {
+        return containsNumber(static_cast<std::uint64_t>(id));
+    }
+
+    void reserve(std::size_t count);
+    void clear();
+    std::size_t size() const;
+    std::size_t memoryBytes() const;
+
+private:
+    std::size_t keyWidth;
+    std::size_t keyCount = 0;
+    std::size_t groupMask = 0;          // The number of 16-slot groups, less one; always a power of two less one
+    std::vector<std::int8_t> controls;  // One per slot: emptyControl, or the low 7 bits of the key's hash
+    std::vector<char> keys;             // keyWidth bytes per slot
+
+    bool insertNumber(std::uint64_t number);
+    bool containsNumber(std::uint64_t number) const;
+    bool insertPadded(const char* key);
+    bool findSlot(const char* key, std::uint64_t hash, std::size_t& slot) const;
+    std::uint64_t hashKey(const char* key) const;
+    void rehash(std::size_t slotCount);
+};
+
+#endif // FLATSET_H
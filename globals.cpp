@@ -1,8 +1,129 @@
 #include "globals.h"
+#include "transactions.h"
 
-// Define global variables used throughout program
-std::unordered_set<std::string> customerIDs;
-std::unordered_set<std::string> productIDs;
-std::unordered_set<std::string> transactionIDs;
-std::unordered_set<std::string> existingUsernames;
-std::unordered_set<std::string> existingCreditCards;
+// Define global variables used throughout program; IDs are keyed on their 8-byte number
+FlatSet customerIDs(sizeof(std::uint64_t));
+FlatSet productIDs(sizeof(std::uint64_t));
+FlatSet transactionIDs(sizeof(std::uint64_t));
+
+// Define the uniqueness filters: file, false positive rate a new filter is sized for (see --rebuild-filters)
+BloomFilter usernameFilter("usernames.bloom", 0.01);
+BloomFilter creditCardFilter("creditcards.bloom", 0.01);
+
+// Define the record stores shared by the menu operations
+CustomerStore customerStore;
+ProductCatalog productCatalog;
+RewardsCatalog rewardsCatalog;
+RewardRules rewardRules;
+
+// Define the ID generators: prefix, first number, how many numbers, block reserved per state file write, state file
+IdGenerator customerIdGenerator("CustID", 1000000000ULL, 9000000000ULL, 256, "customer_id_state.txt");
+IdGenerator productIdGenerator("Prod", 10000, 90000, 1, "product_id_state.txt");
+IdGenerator transactionIdGenerator("Transaction", 1000000, 9000000, 4096, "transaction_id_state.txt");
+
+// Define the persistence queue last, so it is destroyed first and writes what it holds while the stores and the
+// transaction log still exist
+TransactionLog transactionLog("transactions.txt");
+PersistenceQueue persistenceQueue;
+
+/*
+Function Name: rehydrateGlobalSets
+Purpose: Refills the uniqueness sets from the persisted data at startup, so duplicate checks and ID generation hold across runs and not just within one session.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value. Customers and products are taken from the already loaded stores; transaction IDs are read in one pass over "transactions.txt". Each set is sized up front so it never rehashes while filling. The username and credit card filters are mapped from their files and only rebuilt if out of date.
+*/
+void rehydrateGlobalSets() {
+    const std::vector<CustomerRecord>& customers = customerStore.all();
+    customerIDs.clear();
+    customerIDs.reserve(customers.size());
+    for (std::size_t i = 0; i < customers.size(); ++i) {
+        if (!customers[i].deleted) {
+            customerIDs.insert(customers[i].userID);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+
+    // Reward items share the Prod##### ID space with catalog products
+    const std::vector<ProductRecord>& products = productCatalog.all();
+    const std::vector<RewardRecord>& rewards = rewardsCatalog.all();
+    productIDs.clear();
+    productIDs.reserve(products.size() + rewards.size());
+    for (std::size_t i = 0; i < products.size(); ++i) {
+        productIDs.insert(products[i].productID);
+    }
+    for (std::size_t i = 0; i < rewards.size(); ++i) {
+        productIDs.insert(rewards[i].productID);
+    }
+
+    transactionIDs.clear();
+    transactionIDs.reserve(static_cast<std::size_t>(readTransactionCount()));
+    loadTransactionIDs("transactions.txt", transactionIDs);
+    openCustomerFilters();
+}
+
+/*
+Function Name: fillCustomerFilter
+Purpose: Adds the username or credit card number of every customer record to a newly created filter. Removed records are added too, so the filter's key count matches the number of records in the store.
+Meaning of Parameters:
+  - BloomFilter& filter: The filter to fill.
+  - bool usernames: `true` to add usernames, `false` to add credit card numbers.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void fillCustomerFilter(BloomFilter& filter, bool usernames) {
+    const std::vector<CustomerRecord>& customers = customerStore.all();
+    for (std::size_t i = 0; i < customers.size(); ++i) {
+        filter.add(usernames ? customers[i].username : customers[i].creditCard);
+    }
+}
+
+/*
+Function Name: openCustomerFilters
+Purpose: Maps the username and credit card filters, refilling from the customer store any that is missing or does not hold one key per customer record.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value. A filter that cannot be written at all answers "maybe" to every query, so every check falls through to the customer store.
+*/
+void openCustomerFilters() {
+    std::size_t count = customerStore.all().size();
+    if (!usernameFilter.open(count)) {
+        fillCustomerFilter(usernameFilter, true);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (!creditCardFilter.open(count)) {
+        fillCustomerFilter(creditCardFilter, false);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Function Name: rebuildCustomerFilters
+Purpose: Recreates both customer filters from the customer store, optionally for a new false positive rate. This also resets their stats.
+Meaning of Parameters:
+  - double falsePositiveRate: The rate to size the filters for, e.g. 0.001; 0 or less keeps the rate each was built with.
+Description of Return Values:
+  - Returns `true` if both filters were written.
+  - Returns `false` if either could not be; it then answers "maybe" to every query.
+*/
+bool rebuildCustomerFilters(double falsePositiveRate) {
+    std::size_t count = customerStore.all().size();
+    if (falsePositiveRate > 0) {
+        usernameFilter.setFalsePositiveRate(falsePositiveRate);
+        creditCardFilter.setFalsePositiveRate(falsePositiveRate);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    bool usernamesCreated = usernameFilter.create(count * 2);
+    bool cardsCreated = creditCardFilter.create(count * 2);
+    fillCustomerFilter(usernameFilter, true);
+    fillCustomerFilter(creditCardFilter, false);
+    return usernamesCreated && cardsCreated;
+}
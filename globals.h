@@ -1,15 +1,50 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
-#include <unordered_set>
 #include <string>
+#include "bloomFilter.h"
+#include "customerStore.h"
+#include "flatSet.h"
+#include "productCatalog.h"
+#include "rewardsCatalog.h"
+#include "rewardRules.h"
+#include "idGenerator.h"
+#include "persistenceQueue.h"
+#include "recordId.h"
+#include "transactionLog.h"
 
 // Global data for consistency checks and tracking
 
-extern std::unordered_set<std::string> customerIDs;
-extern std::unordered_set<std::string> existingUsernames;
-extern std::unordered_set<std::string> existingCreditCards;
-extern std::unordered_set<std::string> productIDs;
-extern std::unordered_set<std::string> transactionIDs;
+extern FlatSet customerIDs;
+extern FlatSet productIDs;
+extern FlatSet transactionIDs;
+
+// Usernames and credit card numbers are screened by Bloom filters kept in files; a possible hit is confirmed against customerStore
+
+extern BloomFilter usernameFilter;
+extern BloomFilter creditCardFilter;
+
+// In-memory record stores loaded once at startup
+
+extern CustomerStore customerStore;
+extern ProductCatalog productCatalog;
+extern RewardsCatalog rewardsCatalog;
+extern RewardRules rewardRules;
+
+// ID generators; each keeps its key and issued count in a small state file
+
+extern IdGenerator customerIdGenerator;
+extern IdGenerator productIdGenerator;
+extern IdGenerator transactionIdGenerator;
+
+// The group-committed "transactions.txt", and the queue that writes store changes to the data files straight
+// through or write-behind (see --serve)
+
+extern TransactionLog transactionLog;
+extern PersistenceQueue persistenceQueue;
+
+void rehydrateGlobalSets();
+void openCustomerFilters();
+bool rebuildCustomerFilters(double falsePositiveRate);
 
 #endif // GLOBALS_H
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include "idGenerator.h"
+#include "durableFile.h"
+#include "recordParser.h"
+
+/*
+****************************************************************************
+**************************** ID GENERATOR START ****************************
+****************************************************************************
+*/
+
+static const unsigned feistelRounds = 6;
+
+/*
+Function Name: mixBits
+Purpose: Scrambles a 64-bit value (the splitmix64 finaliser), used as the Feistel round function.
+Meaning of Parameters:
+  - std::uint64_t value: The value to scramble.
+Description of Return Values:
+  - Returns the scrambled value; every input bit affects every output bit.
+*/
+static std::uint64_t mixBits(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/*
+Method Name: IdGenerator
+Purpose: Sets up a generator for a range of numbers. Nothing is read until the first ID is asked for, so tools that never create records do not touch the state file.
+Meaning of Parameters:
+  - const std::string& prefix: The prefix of the IDs the numbers become, e.g. "CustID"; used in error messages.
+  - std::uint64_t first: The smallest number handed out.
+  - std::uint64_t count: How many numbers the range holds.
+  - std::uint64_t blockSize: How many numbers to reserve with each write of the state file.
+  - const std::string& stateFileName: The file holding the key and count, e.g. "customer_id_state.txt".
+Description of Return Values:
+  - None.
+*/
+IdGenerator::IdGenerator(const std::string& prefix, std::uint64_t first, std::uint64_t count, std::uint64_t blockSize, const std::string& stateFileName)
+    : prefix(prefix), first(first), count(count), blockSize(std::max<std::uint64_t>(blockSize, 1)), stateFileName(stateFileName) {
+    // The while loop finds the smallest even number of bits that covers the range, split into two Feistel halves
+    while ((std::uint64_t(1) << (2 * halfBits)) < count) {
+        ++halfBits;
+    }
+}
+
+/*
+Method Name: ~IdGenerator
+Purpose: Writes back the exact count on a normal exit, so the unused part of the reserved block is not skipped next time.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+IdGenerator::~IdGenerator() {
+    if (loaded && reservedEnd > nextIndex) {
+        saveState(nextIndex);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: load
+Purpose: Reads the key and count from the state file, or picks a new random key if there is no state file yet.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the generator is ready.
+  - Returns `false` and outputs an error message if the state file exists but has no valid key; a new key could repeat earlier IDs.
+*/
+bool IdGenerator::load() {
+    std::string buffer;
+    if (!readWholeFile(stateFileName, buffer)) {
+        std::random_device random;
+        key = (static_cast<std::uint64_t>(random()) << 32) ^ random();
+        nextIndex = 0;
+        reservedEnd = 0;
+        loaded = true;
+        return true;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    RecordParser parser(buffer);
+    std::string_view line;
+    std::string_view value;
+    bool keyFound = false;
+    while (parser.nextLine(line)) {
+        if (fieldValue(line, "Key:", value)) {
+            keyFound = parseNumber(value, key);
+        } else if (fieldValue(line, "Next:", value)) {
+            parseNumber(value, nextIndex);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+
+    if (!keyFound) {
+        std::cerr << "Error: " << stateFileName << " has no valid key. No new " << prefix << " IDs can be issued.\n";
+        return false;
+    } else {
+        reservedEnd = nextIndex;
+        loaded = true;
+        return true;
+    }
+}
+
+/*
+Method Name: saveState
+Purpose: Writes the key and a count to the state file.
+Meaning of Parameters:
+  - std::uint64_t savedIndex: The count to record; the next run starts handing out IDs from it.
+Description of Return Values:
+  - Returns `true` if the file was written.
+  - Returns `false` and outputs an error message otherwise.
+*/
+bool IdGenerator::saveState(std::uint64_t savedIndex) const {
+    return replaceFile(stateFileName, "Key: " + std::to_string(key) + "\nNext: " + std::to_string(savedIndex) + "\n");
+}
+
+/*
+Method Name: round
+Purpose: The keyed Feistel round function.
+Meaning of Parameters:
+  - std::uint64_t half: One half of the value being permuted.
+  - unsigned roundNumber: Which round this is; each round uses a different subkey.
+Description of Return Values:
+  - Returns a value that fits in one half.
+*/
+std::uint64_t IdGenerator::round(std::uint64_t half, unsigned roundNumber) const {
+    std::uint64_t subkey = key + (roundNumber + 1) * 0x9E3779B97F4A7C15ULL;
+    return mixBits(half ^ subkey) & ((std::uint64_t(1) << halfBits) - 1);
+}
+
+/*
+Method Name: permute
+Purpose: Maps an index to the position of its ID in the range. A Feistel network is a bijection on 2 * halfBits bits; results that fall past the end of the range are permuted again until they land inside it, which keeps it a bijection on the range itself.
+Meaning of Parameters:
+  - std::uint64_t index: The index, below the size of the range.
+Description of Return Values:
+  - Returns a position below the size of the range; different indexes always give different positions.
+*/
+std::uint64_t IdGenerator::permute(std::uint64_t index) const {
+    std::uint64_t mask = (std::uint64_t(1) << halfBits) - 1;
+    std::uint64_t value = index;
+    // The do-while loop walks the permutation's cycle; on average it runs fewer than 4 times for these ranges.
+    do {
+        std::uint64_t left = value >> halfBits;
+        std::uint64_t right = value & mask;
+        for (unsigned r = 0; r < feistelRounds; ++r) {
+            std::uint64_t mixed = left ^ round(right, r);
+            left = right;
+            right = mixed;
+        }
+        value = (left << halfBits) | right;
+    } while (value >= count);
+    return value;
+}
+
+/*
+Method Name: nextNumber
+Purpose: Hands out the next number of the range, reserving a new block in the state file first when the current one is used up.
+Meaning of Parameters:
+  - std::uint64_t& number: Receives the number.
+Description of Return Values:
+  - Returns `true` if a number was handed out.
+  - Returns `false` and outputs an error message if the range is used up or the state file cannot be read or written.
+*/
+bool IdGenerator::nextNumber(std::uint64_t& number) {
+    if (!loaded && !load()) {
+        return false;
+    } else if (nextIndex >= count) {
+        std::cerr << "Error: All " << count << " " << prefix << " IDs have been used.\n";
+        return false;
+    } else if (nextIndex >= reservedEnd) {
+        std::uint64_t end = std::min(count, nextIndex + blockSize);
+        if (!saveState(end)) {
+            return false;
+        } else {
+            reservedEnd = end;
+        }
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    number = first + permute(nextIndex++);
+    return true;
+}
+
+/*
+Method Name: issued
+Purpose: Reports how many IDs have been handed out, across all runs.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the count; 0 before the state file has been read.
+*/
+std::uint64_t IdGenerator::issued() const {
+    return nextIndex;
+}
+
+/*
+****************************************************************************
+***************************** ID GENERATOR END *****************************
+****************************************************************************
+*/
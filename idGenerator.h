@@ -0,0 +1,41 @@
+#ifndef IDGENERATOR_H
+#define IDGENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+/* Declarations for the keyed-permutation generator behind customer, product and transaction IDs */
+
+// Hands out the numbers of a fixed range in an order that looks random but never repeats. The n-th ID is a keyed
+// Feistel permutation of n, so only the key and the count issued so far are stored, and no ID set is searched.
+// The count is reserved ahead in blocks so the state file is written once per block, not once per ID; a crash
+// skips the rest of the block, and a normal exit writes back the exact count.
+class IdGenerator {
+public:
+    IdGenerator(const std::string& prefix, std::uint64_t first, std::uint64_t count, std::uint64_t blockSize, const std::string& stateFileName);
+    IdGenerator(const IdGenerator&) = delete;
+    IdGenerator& operator=(const IdGenerator&) = delete;
+    ~IdGenerator();
+
+    bool nextNumber(std::uint64_t& number);
+    std::uint64_t permute(std::uint64_t index) const;
+    std::uint64_t issued() const;
+
+private:
+    std::string prefix;             // Names the kind of ID in error messages, e.g. "CustID"
+    std::uint64_t first = 0;        // The smallest number in the range
+    std::uint64_t count = 0;        // How many numbers the range holds
+    std::uint64_t blockSize = 1;    // How many numbers each write of the state file reserves
+    std::string stateFileName;
+    std::uint64_t key = 0;
+    std::uint64_t nextIndex = 0;    // How many numbers have been handed out
+    std::uint64_t reservedEnd = 0;  // The state file already covers every index below this
+    unsigned halfBits = 1;          // Each Feistel half; 2 * halfBits bits cover the range
+    bool loaded = false;
+
+    bool load();
+    bool saveState(std::uint64_t savedIndex) const;
+    std::uint64_t round(std::uint64_t half, unsigned roundNumber) const;
+};
+
+#endif // IDGENERATOR_H
@@ -0,0 +1,471 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cctype>
+#include <string_view>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include "ingest.h"
+#include "customers.h"
+#include "globals.h"
+#include "mappedFile.h"
+#include "recordParser.h"
+#include "transactions.h"
+
+/*
+****************************************************************************
+************************** BATCH INGEST START ******************************
+****************************************************************************
+*/
+
+static const std::size_t maxReportedLines = 5; // Example line numbers printed per rejection reason
+
+// Rejection reasons, shared by the serial and sharded paths so their summaries match
+static const char* const malformedRow = "malformed row";
+static const char* const unknownCustomer = "unknown customer";
+static const char* const unknownProduct = "unknown product";
+static const char* const invalidQuantity = "invalid quantity";
+static const char* const insufficientInventory = "insufficient inventory";
+
+// State shared by the workers of a sharded ingest. Rows are split twice: by customer ID hash, so each worker owns
+// the reward balances of its customers, and by product ID hash, so each worker owns the inventory of its products.
+// A worker only writes the per-row slots of the rows in its own shard.
+struct ShardedIngest {
+    const std::vector<SaleRow>* rows = nullptr;
+    std::vector<std::vector<std::size_t>> customerShards; // Row indexes per customer shard, in file order
+    std::vector<std::vector<std::size_t>> productShards;  // Row indexes per product shard, in file order
+    std::vector<const char*> rejection;                   // Per row: the rejection reason, or nullptr if accepted
+    std::vector<CustomerRecord*> customers;
+    std::vector<ProductRecord*> products;
+    std::vector<Money> amounts;
+    std::vector<int> points;
+    std::vector<TransactionId> transactionIDs;
+    std::vector<int> transactionNumbers;
+    std::vector<std::string> chunkText;                   // Transaction records per contiguous block of rows
+};
+
+/*
+Function Name: isDigits
+Purpose: Checks that a field is made only of digits and, optionally, has an exact length.
+Meaning of Parameters:
+  - std::string_view text: The field to check.
+  - std::size_t length: The required number of digits, or 0 for any non-zero number.
+Description of Return Values:
+  - Returns `true` if the field matches.
+  - Returns `false` otherwise.
+*/
+static bool isDigits(std::string_view text, std::size_t length) {
+    if (text.empty() || (length != 0 && text.size() != length)) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(text[i]))) {
+            return false;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return true;
+}
+
+/*
+Function Name: parseSaleRow
+Purpose: Splits one "customer ID,product ID,quantity" line and checks the shape of each field. The IDs may be given with or without their "CustID" and "Prod" prefixes. Whether the customer and product exist is checked later.
+Meaning of Parameters:
+  - std::string_view line: The trimmed line.
+  - SaleRow& row: Receives the customer and product IDs and the quantity.
+Description of Return Values:
+  - Returns `true` if the line has exactly three well-formed fields.
+  - Returns `false` otherwise.
+*/
+static bool parseSaleRow(std::string_view line, SaleRow& row) {
+    std::size_t first = line.find(',');
+    std::size_t second = (first == std::string_view::npos) ? first : line.find(',', first + 1);
+    if (second == std::string_view::npos || line.find(',', second + 1) != std::string_view::npos) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::string_view customer = trimView(line.substr(0, first));
+    std::string_view product = trimView(line.substr(first + 1, second - first - 1));
+    std::string_view quantity = trimView(line.substr(second + 1));
+    return parseCustomerId(customer, row.customerID) && parseProductId(product, row.productID) &&
+           isDigits(quantity, 0) && parseNumber(quantity, row.quantity);
+}
+
+/*
+Function Name: rejectRow
+Purpose: Counts a rejected row under its reason.
+Meaning of Parameters:
+  - IngestSummary& summary: The summary to update.
+  - const std::string& reason: Why the row was rejected.
+  - std::size_t lineNumber: The row's line number in the sales file.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void rejectRow(IngestSummary& summary, const std::string& reason, std::size_t lineNumber) {
+    summary.rejectedLines[reason].push_back(lineNumber);
+}
+
+/*
+Function Name: readSaleRows
+Purpose: Parses every row of a sales file in one pass. Blank lines, lines starting with '#', and a header line naming the columns are skipped.
+Meaning of Parameters:
+  - std::string_view contents: The whole sales file.
+  - std::vector<SaleRow>& rows: Receives the well-formed rows in file order.
+  - IngestSummary& summary: Counts the rows read and the malformed rows.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void readSaleRows(std::string_view contents, std::vector<SaleRow>& rows, IngestSummary& summary) {
+    RecordParser parser(contents);
+    std::string_view line;
+    std::size_t lineNumber = 0;
+    SaleRow row;
+    while (parser.nextLine(line)) {
+        row.lineNumber = ++lineNumber;
+        bool header = (summary.rowsRead == 0 && !line.empty() && std::isalpha(static_cast<unsigned char>(line[0])) &&
+                       line.compare(0, 6, "CustID") != 0);
+        if (line.empty() || line[0] == '#' || header) {
+            continue;
+        } else {
+            ++summary.rowsRead;
+        }
+
+        if (parseSaleRow(line, row)) {
+            rows.push_back(row);
+        } else {
+            rejectRow(summary, malformedRow, lineNumber);
+        }
+    }
+}
+
+/*
+Function Name: applySaleRows
+Purpose: Applies the rows in file order to the in-memory product catalog and customer store and formats a transaction record for each. Nothing is written to disk here.
+Meaning of Parameters:
+  - const std::vector<SaleRow>& rows: The well-formed rows.
+  - IngestSummary& summary: Counts the applied rows and the rejected ones.
+  - std::string& transactionText: Receives the new "transactions.txt" records, in order.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void applySaleRows(const std::vector<SaleRow>& rows, IngestSummary& summary, std::string& transactionText) {
+    int transactionNumber = readTransactionCount();
+    TransactionRecord transaction;
+    // The for loop rejects rows for unknown customers or products, zero quantities and short inventory; the rest become transactions.
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        CustomerRecord* customer = customerStore.find(rows[i].customerID);
+        ProductRecord* product = productCatalog.find(rows[i].productID);
+        if (customer == nullptr) {
+            rejectRow(summary, unknownCustomer, rows[i].lineNumber);
+        } else if (product == nullptr) {
+            rejectRow(summary, unknownProduct, rows[i].lineNumber);
+        } else if (rows[i].quantity <= 0) {
+            rejectRow(summary, invalidQuantity, rows[i].lineNumber);
+        } else if (product->inventory < rows[i].quantity) {
+            rejectRow(summary, insufficientInventory, rows[i].lineNumber);
+        } else {
+            product->inventory -= rows[i].quantity;
+            transaction.transactionID = generateTransactionID();
+            transaction.customerID = rows[i].customerID;
+            transaction.productIDs.assign(1, rows[i].productID);
+            transaction.totalAmount = product->price * rows[i].quantity;
+            transaction.rewardPoints = rewardRules.points(transaction.totalAmount, rewardRules.weigh(transaction.totalAmount, rows[i].productID));
+            customer->rewardPoints += transaction.rewardPoints;
+            summary.salesTotal += transaction.totalAmount;
+            transactionText += formatTransactionRecord(transaction, transactionNumber++);
+            ++summary.rowsApplied;
+        }
+    }
+}
+
+/*
+Function Name: runShards
+Purpose: Runs one step of a sharded ingest with one thread per shard and waits for all of them.
+Meaning of Parameters:
+  - void (*work)(ShardedIngest&, std::size_t): The step, called once per shard number.
+  - ShardedIngest& ingest: The shared ingest state.
+  - std::size_t shardCount: How many shards, and so threads, to run.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void runShards(void (*work)(ShardedIngest&, std::size_t), ShardedIngest& ingest, std::size_t shardCount) {
+    std::vector<std::thread> workers;
+    for (std::size_t shard = 0; shard < shardCount; ++shard) {
+        workers.push_back(std::thread(work, std::ref(ingest), shard));
+    }
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+/*
+Function Name: checkCustomerShard
+Purpose: Sharded step 1. Resolves the customer and product of every row in a customer shard and rejects rows for unknown IDs or a zero quantity. The stores are only read.
+Meaning of Parameters:
+  - ShardedIngest& ingest: The shared ingest state.
+  - std::size_t shard: The customer shard to process.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void checkCustomerShard(ShardedIngest& ingest, std::size_t shard) {
+    const std::vector<std::size_t>& rowIndexes = ingest.customerShards[shard];
+    for (std::size_t k = 0; k < rowIndexes.size(); ++k) {
+        std::size_t i = rowIndexes[k];
+        const SaleRow& row = (*ingest.rows)[i];
+        ingest.customers[i] = customerStore.find(row.customerID);
+        ingest.products[i] = productCatalog.find(row.productID);
+        if (ingest.customers[i] == nullptr) {
+            ingest.rejection[i] = unknownCustomer;
+        } else if (ingest.products[i] == nullptr) {
+            ingest.rejection[i] = unknownProduct;
+        } else if (row.quantity <= 0) {
+            ingest.rejection[i] = invalidQuantity;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: reserveProductShard
+Purpose: Sharded step 2. Walks the rows of a product shard in file order and deducts inventory exactly as the serial path would, so the same rows run short. The price and reward points of each accepted row are worked out here.
+Meaning of Parameters:
+  - ShardedIngest& ingest: The shared ingest state.
+  - std::size_t shard: The product shard to process.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void reserveProductShard(ShardedIngest& ingest, std::size_t shard) {
+    const std::vector<std::size_t>& rowIndexes = ingest.productShards[shard];
+    for (std::size_t k = 0; k < rowIndexes.size(); ++k) {
+        std::size_t i = rowIndexes[k];
+        int quantity = (*ingest.rows)[i].quantity;
+        if (ingest.rejection[i] != nullptr) {
+            continue;
+        } else if (ingest.products[i]->inventory < quantity) {
+            ingest.rejection[i] = insufficientInventory;
+        } else {
+            ingest.products[i]->inventory -= quantity;
+            ingest.amounts[i] = ingest.products[i]->price * quantity;
+            ingest.points[i] = rewardRules.points(ingest.amounts[i], rewardRules.weigh(ingest.amounts[i], (*ingest.rows)[i].productID));
+        }
+    }
+}
+
+/*
+Function Name: creditCustomerShard
+Purpose: Sharded step 3. Adds the reward points of every accepted row to the balances of the customers in a shard. No other worker touches these customers, so no lock is needed.
+Meaning of Parameters:
+  - ShardedIngest& ingest: The shared ingest state.
+  - std::size_t shard: The customer shard to process.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void creditCustomerShard(ShardedIngest& ingest, std::size_t shard) {
+    const std::vector<std::size_t>& rowIndexes = ingest.customerShards[shard];
+    for (std::size_t k = 0; k < rowIndexes.size(); ++k) {
+        std::size_t i = rowIndexes[k];
+        if (ingest.rejection[i] == nullptr) {
+            ingest.customers[i]->rewardPoints += ingest.points[i];
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: formatTransactionChunk
+Purpose: Sharded step 5. Formats the transaction records of one contiguous block of rows, so the blocks can be joined in file order.
+Meaning of Parameters:
+  - ShardedIngest& ingest: The shared ingest state.
+  - std::size_t chunk: The block to format.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void formatTransactionChunk(ShardedIngest& ingest, std::size_t chunk) {
+    std::size_t chunkSize = (ingest.rows->size() + ingest.chunkText.size() - 1) / ingest.chunkText.size();
+    std::size_t end = std::min(ingest.rows->size(), (chunk + 1) * chunkSize);
+    TransactionRecord transaction;
+    for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+        if (ingest.rejection[i] == nullptr) {
+            transaction.transactionID = ingest.transactionIDs[i];
+            transaction.customerID = (*ingest.rows)[i].customerID;
+            transaction.productIDs.assign(1, (*ingest.rows)[i].productID);
+            transaction.totalAmount = ingest.amounts[i];
+            transaction.rewardPoints = ingest.points[i];
+            ingest.chunkText[chunk] += formatTransactionRecord(transaction, ingest.transactionNumbers[i]);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: partitionSaleRows
+Purpose: Splits the rows into shards by customer ID hash and by product ID hash, keeping file order within each shard.
+Meaning of Parameters:
+  - ShardedIngest& ingest: The shared ingest state; its rows must be set.
+  - std::size_t shardCount: How many shards of each kind to make.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void partitionSaleRows(ShardedIngest& ingest, std::size_t shardCount) {
+    std::size_t rowCount = ingest.rows->size();
+    std::hash<CustomerId> hashCustomer;
+    std::hash<ProductId> hashProduct;
+    ingest.customerShards.assign(shardCount, std::vector<std::size_t>());
+    ingest.productShards.assign(shardCount, std::vector<std::size_t>());
+    for (std::size_t i = 0; i < rowCount; ++i) {
+        ingest.customerShards[hashCustomer((*ingest.rows)[i].customerID) % shardCount].push_back(i);
+        ingest.productShards[hashProduct((*ingest.rows)[i].productID) % shardCount].push_back(i);
+    }
+
+    ingest.rejection.assign(rowCount, nullptr);
+    ingest.customers.assign(rowCount, nullptr);
+    ingest.products.assign(rowCount, nullptr);
+    ingest.amounts.assign(rowCount, Money());
+    ingest.points.assign(rowCount, 0);
+    ingest.transactionIDs.assign(rowCount, TransactionId());
+    ingest.transactionNumbers.assign(rowCount, 0);
+    ingest.chunkText.assign(shardCount, std::string());
+}
+
+/*
+Function Name: applySaleRowsSharded
+Purpose: Applies the rows like applySaleRows, split across worker threads. The result is identical to the serial path: the same rows are rejected, inventory and balances end the same, and the transactions are numbered and written in file order.
+Meaning of Parameters:
+  - const std::vector<SaleRow>& rows: The well-formed rows.
+  - std::size_t threadCount: How many worker threads to use.
+  - IngestSummary& summary: Counts the applied rows and the rejected ones.
+  - std::string& transactionText: Receives the new "transactions.txt" records, in order.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void applySaleRowsSharded(const std::vector<SaleRow>& rows, std::size_t threadCount, IngestSummary& summary, std::string& transactionText) {
+    ShardedIngest ingest;
+    ingest.rows = &rows;
+    partitionSaleRows(ingest, threadCount);
+    runShards(checkCustomerShard, ingest, threadCount);
+    runShards(reserveProductShard, ingest, threadCount);
+    runShards(creditCustomerShard, ingest, threadCount);
+
+    // Step 4 stays serial: transaction IDs come from the shared generator and numbers follow file order
+    int transactionNumber = readTransactionCount();
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        if (ingest.rejection[i] != nullptr) {
+            rejectRow(summary, ingest.rejection[i], rows[i].lineNumber);
+        } else {
+            ingest.transactionIDs[i] = generateTransactionID();
+            ingest.transactionNumbers[i] = transactionNumber++;
+            summary.salesTotal += ingest.amounts[i];
+            ++summary.rowsApplied;
+        }
+    }
+
+    runShards(formatTransactionChunk, ingest, threadCount);
+    for (std::size_t chunk = 0; chunk < ingest.chunkText.size(); ++chunk) {
+        transactionText += ingest.chunkText[chunk];
+    }
+}
+
+/*
+Function Name: commitSales
+Purpose: Writes the result of a batch with one write per data file: products.txt is rewritten once, the transaction records are appended and synced in a single commit of the transaction log, the counter is updated once and the customer file is rewritten once with the new balances.
+Meaning of Parameters:
+  - const std::string& transactionText: The new transaction records.
+  - std::size_t applied: How many transactions they hold.
+Description of Return Values:
+  - Returns `true` if every file was written.
+  - Returns `false` and outputs an error message otherwise.
+*/
+static bool commitSales(const std::string& transactionText, std::size_t applied) {
+    if (applied == 0) {
+        return true;
+    } else if (!productCatalog.save()) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (!transactionLog.append(transactionText, readTransactionCount() + static_cast<int>(applied))) {
+        return false;
+    } else {
+        return customerStore.save();
+    }
+}
+
+/*
+Function Name: ingestTransactions
+Purpose: Replays a sales file of "customer ID,product ID,quantity" rows without the menu. The rows are applied in file order to inventory, reward balances and "transactions.txt", and each data file is written once at the end.
+Meaning of Parameters:
+  - const std::string& fileName: The sales file, e.g. an end-of-day POS export.
+  - std::size_t threadCount: How many worker threads to apply the rows with; 1 applies them serially.
+  - IngestSummary& summary: Receives the row counts, rejected rows and timing.
+Description of Return Values:
+  - Returns `true` if the file was read and every change was written. Rejected rows do not make the ingest fail.
+  - Returns `false` and outputs an error message if the file could not be read or a data file could not be written.
+*/
+bool ingestTransactions(const std::string& fileName, std::size_t threadCount, IngestSummary& summary) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::string_view contents;
+    if (!mappedFileContents(fileName, contents)) {
+        std::cerr << "Error: Could not open " << fileName << " file.\n";
+        return false;
+    } else {
+        summary.bytesRead = contents.size();
+        summary.threads = threadCount;
+    }
+
+    std::vector<SaleRow> rows;
+    std::string transactionText;
+    readSaleRows(contents, rows, summary);
+    if (threadCount > 1) {
+        applySaleRowsSharded(rows, threadCount, summary, transactionText);
+    } else {
+        applySaleRows(rows, summary, transactionText);
+    }
+    bool committed = commitSales(transactionText, summary.rowsApplied);
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return committed;
+}
+
+/*
+Function Name: printIngestSummary
+Purpose: Prints the throughput of an ingest and, for each rejection reason, how many rows it covered and the first few line numbers.
+Meaning of Parameters:
+  - const IngestSummary& summary: The summary to print.
+Description of Return Values:
+  - This function does not return a value.
+*/
+void printIngestSummary(const IngestSummary& summary) {
+    double seconds = (summary.seconds > 0.0) ? summary.seconds : 1e-9;
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1) << "Ingested " << summary.rowsApplied << " of " << summary.rowsRead
+         << " rows with " << summary.threads << " thread(s) in " << summary.seconds * 1000.0 << " ms ("
+         << summary.rowsRead / seconds << " rows/s, "
+         << summary.bytesRead / (1024.0 * 1024.0) / seconds << " MB/s), totalling $" << formatMoney(summary.salesTotal) << ".\n";
+    std::cout << line.str();
+
+    std::map<std::string, std::vector<std::size_t>>::const_iterator it;
+    for (it = summary.rejectedLines.begin(); it != summary.rejectedLines.end(); ++it) {
+        std::cout << "Rejected " << it->second.size() << " row(s): " << it->first << " (line";
+        for (std::size_t i = 0; i < it->second.size() && i < maxReportedLines; ++i) {
+            std::cout << (i == 0 ? " " : ", ") << it->second[i];
+        }
+        std::cout << (it->second.size() > maxReportedLines ? ", ...)\n" : ")\n");
+    }
+}
+
+/*
+****************************************************************************
+*************************** BATCH INGEST END *******************************
+****************************************************************************
+*/
@@ -0,0 +1,34 @@
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "money.h"
+#include "recordId.h"
+
+/* Declarations for the non-interactive batch transaction ingest (app --ingest sales.csv) */
+
+// One "customer ID,product ID,quantity" row of a sales file.
+struct SaleRow {
+    std::size_t lineNumber = 0;
+    CustomerId customerID{};
+    ProductId productID{};
+    int quantity = 0;
+};
+
+struct IngestSummary {
+    std::uint64_t bytesRead = 0;
+    std::size_t threads = 1;
+    std::size_t rowsRead = 0;
+    std::size_t rowsApplied = 0;
+    Money salesTotal;                                              // Sum of the applied rows, exact to the cent
+    std::map<std::string, std::vector<std::size_t>> rejectedLines; // Line numbers of rejected rows, by reason
+    double seconds = 0.0;
+};
+
+bool ingestTransactions(const std::string& fileName, std::size_t threadCount, IngestSummary& summary);
+void printIngestSummary(const IngestSummary& summary);
+
+#endif // INGEST_H
@@ -0,0 +1,55 @@
+#ifndef INVENTORYCOUNT_H
+#define INVENTORYCOUNT_H
+
+#include <atomic>
+
+/* Declarations for the atomic stock count kept in every product and reward record */
+
+// A stock count that concurrent purchases can check and deduct without a lock, so purchases of different products
+// never wait on each other and two purchases of the same product cannot both take its last unit. It reads and
+// assigns like an int; copying a record copies the count's value at that moment.
+class InventoryCount {
+public:
+    InventoryCount(int count = 0) : count(count) {
+    }
+    InventoryCount(const InventoryCount& other) : count(other.count.load()) {
+    }
+    InventoryCount& operator=(const InventoryCount& other) {
+        count.store(other.count.load());
+        return *this;
+    }
+    InventoryCount& operator=(int value) {
+        count.store(value);
+        return *this;
+    }
+    InventoryCount& operator+=(int quantity) {
+        count.fetch_add(quantity);
+        return *this;
+    }
+    InventoryCount& operator-=(int quantity) {
+        count.fetch_sub(quantity);
+        return *this;
+    }
+    operator int() const {
+        return count.load();
+    }
+
+    // Deducts the quantity only if that much is left, as one atomic step. The while loop retries when another
+    // thread changed the count between the load and the exchange; a failed exchange reloads `current`.
+    bool take(int quantity) {
+        int current = count.load();
+        while (current >= quantity) {
+            if (count.compare_exchange_weak(current, current - quantity)) {
+                return true;
+            } else {
+                ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+            }
+        }
+        return false;
+    }
+
+private:
+    std::atomic<int> count;
+};
+
+#endif // INVENTORYCOUNT_H
@@ -10,103 +10,52 @@
 #include <cctype>
 #include <limits>
 #include <iomanip>
+#include <chrono>
+#include <thread>
 #include "customers.h"
 #include "products.h"
 #include "transactions.h"
 #include "globals.h"
 #include "utility.h"
+#include "binaryCustomerFile.h"
+#include "durableFile.h"
+#include "ingest.h"
+#include "server.h"
 
 /*
 Function Name: getRewardAmount
-Purpose: Retrieves the total reward points for a specified customer from the "customers.txt" file.
+Purpose: Retrieves the total reward points for a specified customer from the in-memory customer index.
 Meaning of Parameters:
-  - const std::string& customerID: The ID of the customer whose reward points are being retrieved.
+  - CustomerId customerID: The customer whose reward points are being retrieved.
 Description of Return Values:
   - Returns the total reward points as an integer if the customer ID is found.
-  - Returns -1 if the customer ID or reward points are not found in the file.
-*/
-int getRewardAmount(const std::string& customerID) {
-    std::ifstream infile("customers.txt");
-    std::string line;
-    std::string fullCustomerID = "ID: CustID" + customerID; // Full customer ID format
-    fullCustomerID = trim(fullCustomerID); // Trim any extra spaces
-
-    bool customerFound = false;
-    int rewardPoints = -1; // Default to -1 to indicate not found
-    
-    // The while loop reads each line from the "customers.txt" file, searches for the specified customer ID, and extracts the reward points from the 
-    // corresponding "Total Reward Points:" line if the customer is found.
-    while (std::getline(infile, line)) {
-        line = trim(line); // Trim whitespace from each line
-
-        // Check if this line contains the customer ID
-        if (line == fullCustomerID) {
-            customerFound = true;
-        }
-
-        // If the customer ID was found, look for the reward points on the next relevant line
-        if (customerFound && line.find("Total Reward Points:") != std::string::npos) {
-            // Extract the reward points value after "Total Reward Points:"
-            size_t pos = line.find(":");
-            if (pos != std::string::npos) {
-                std::string rewardStr = line.substr(pos + 1);
-                rewardPoints = std::stoi(trim(rewardStr)); // Convert reward points to an integer
-            }
-            break;
-        }
+  - Returns -1 if the customer ID is not found.
+*/
+int getRewardAmount(CustomerId customerID) {
+    const CustomerRecord* record = customerStore.find(customerID);
+    if (record == nullptr) {
+        return -1; // -1 indicates the customer was not found
+    } else {
+        return record->rewardPoints;
     }
-
-    infile.close();
-
-    return rewardPoints;
 }
 
 /*
 Function Name: getRewardPointValue
-Purpose: Retrieves the point value of a reward product based on its product ID from the "rewardsList.txt" file.
+Purpose: Retrieves the point value of a reward product based on its product ID from the in-memory rewards catalog.
 Meaning of Parameters:
-  - const std::string& productID: The ID of the reward product for which the point value is being retrieved.
+  - ProductId productID: The reward product whose point value is being retrieved.
 Description of Return Values:
-  - Returns the point value as an integer if the product ID is found in the file.
-  - Returns -1 if the product ID or point value is not found.
+  - Returns the point value as an integer if the product ID is found in the catalog.
+  - Returns -1 if the product ID is not found.
 */
-int getRewardPointValue(const std::string& productID) {
-    std::ifstream infile("rewardsList.txt");
-    std::string line;
-    std::string fullRewardID = "ID: Prod" + productID;  // Full reward ID format
-    int pointValue = -1; // Default to -1 to indicate not found
-
-    // Trim any extra spaces from the fullRewardID
-    fullRewardID = trim(fullRewardID);
-
-    bool rewardFound = false;
-
-    // The while loop reads each line from the "rewardsList.txt" file, searches for the specified product ID, and extracts the "Point Value" from the 
-    // subsequent relevant line if the product is found.
-    while (std::getline(infile, line)) {
-        line = trim(line);  // Trim whitespace from each line
-
-        // Check for the product ID in the current line
-        if (line == fullRewardID) {
-            rewardFound = true;
-            continue; // Move to next line to find relevant details
-        }
-
-        // If the reward ID was found, look for the "Point Value" line
-        if (rewardFound && line.find("Point Value:") != std::string::npos) {
-            // Extract the point value after "Point Value:"
-            size_t pos = line.find(":");
-            if (pos != std::string::npos) {
-                std::string pointValueStr = line.substr(pos + 1);
-                pointValueStr = trim(pointValueStr); // Remove any extra whitespace
-                pointValue = std::stoi(pointValueStr); // Convert point value to integer
-                break; // Exit once the value is found
-            }
-        }
+int getRewardPointValue(ProductId productID) {
+    const RewardRecord* record = rewardsCatalog.find(productID);
+    if (record == nullptr) {
+        return -1; // -1 indicates the reward was not found
+    } else {
+        return record->pointValue;
     }
-
-    infile.close();
-    return pointValue;
 }
 
 /*
@@ -120,6 +69,8 @@ Description of Return Values:
 void redeemRewards() {
     std::string customerID;
     std::string productID;
+    CustomerId customer{};
+    ProductId reward{};
     int customerRewardsAmount;
     int redeemRewardAmount;
 
@@ -131,24 +82,33 @@ void redeemRewards() {
         return;
     }
     else {
-        customerRewardsAmount = getRewardAmount(customerID);
+        parseCustomerId(trim(customerID), customer);
+        customerRewardsAmount = getRewardAmount(customer);
         std::cerr << "Welcome to the reward section customer: " << customerID << "\n"
                     << "You have " << customerRewardsAmount << " points available\n";
     }
-    std::cout << "\nHere are the all rewards that can be redeemed: \n";
-    loadAndDisplayProducts(7);
+    std::size_t affordable = rewardsCatalog.affordableCount(customerRewardsAmount);
+    if (affordable == 0) {
+        std::cout << "\nYou don't have enough points to redeem any reward yet.\n";
+        return;
+    }
+    else {
+        std::cout << "\nHere are the rewards you can redeem with your points: \n";
+        displayRewardProducts(affordable);
+    }
 
     std::cout << "Enter the 5 digit Product ID to Redeem: ";
     std::cin >> productID;
 
     if (validateProductsID(productID, 7)){
-        redeemRewardAmount = getRewardPointValue(productID);
+        parseProductId(trim(productID), reward);
+        redeemRewardAmount = getRewardPointValue(reward);
         std::cout << "The customer " << customerID << " has: " << customerRewardsAmount << " points.";
         std::cout << "The reward you are trying to redeem costs: " << redeemRewardAmount << " points.";
         if(customerRewardsAmount >= redeemRewardAmount) {
             std::cout << "You redeemed Product ID: " << productID;
-            processInventoryAdjustment(productID, 1, 7);   
-            updateCustomerRewards(customerID, redeemRewardAmount, 7);
+            processInventoryAdjustment(reward, 1, 7);   
+            updateCustomerRewards(customer, redeemRewardAmount, 7, formatId(reward));
         }
         else {
             std::cout << "You don't have enough points to redeem";
@@ -182,19 +142,303 @@ void showMenu() {
     std::cout << "Type a number 1 through 8: ";
 }
 
+/*
+Function Name: printRecordLookup
+Purpose: Prints one customer or product found through the record index files, for scripts that need a single record without starting the menu.
+Meaning of Parameters:
+  - const std::string& tool: "--lookup-customer" or "--lookup-product".
+  - const std::string& id: The 10 digit customer ID or 5 digit product ID.
+Description of Return Values:
+  - Returns `true` if the record was found and printed.
+  - Returns `false` and outputs an error message if it does not exist.
+*/
+bool printRecordLookup(const std::string& tool, const std::string& id) {
+    CustomerRecord customer;
+    ProductRecord product;
+    if (tool == "--lookup-customer" && parseCustomerId(id, customer.userID) &&
+        lookupCustomerRecord("customers.txt", "rewardsLedger.txt", customer.userID, customer)) {
+        std::cout << formatCustomerRecord(customer);
+        return true;
+    } else if (tool == "--lookup-product" && parseProductId(id, product.productID) && lookupProductRecord("products.txt", product.productID, product)) {
+        std::cout << formatProductRecord(product);
+        return true;
+    } else {
+        std::cerr << "No record with ID " << id << " was found.\n";
+        return false;
+    }
+}
+
+/*
+Function Name: loadCustomerStore
+Purpose: Loads the customer store, preferring the binary customer file when one has been imported.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value. If "customers.bin" exists it is used; otherwise "customers.txt" is read and the changes logged in "rewardsLedger.txt" are applied on top of it.
+*/
+void loadCustomerStore() {
+    std::ifstream binaryFile("customers.bin");
+    if (binaryFile.is_open()) {
+        binaryFile.close();
+        customerStore.loadBinary("customers.bin");
+    } else {
+        customerStore.load("customers.txt");
+        customerStore.openLedger("rewardsLedger.txt");
+    }
+}
+
+/*
+Function Name: recoverInterruptedWrites
+Purpose: Clears the temporary files a crash can leave behind while a data file is being replaced, before anything is loaded.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value. Each temporary file found is removed and reported; the data file it was meant to replace still holds its last complete contents.
+*/
+void recoverInterruptedWrites() {
+    std::vector<std::string> fileNames = {
+        "customers.txt", "customers.idx", "customers.bin", "customer_count.txt", "customer_id_state.txt", "rewardsLedger.txt",
+        "products.txt", "products.idx", "product_count.txt", "product_id_state.txt", "rewardsList.txt",
+        "transactions.txt", "transaction_count.txt", "transaction_id_state.txt", "transactions.rescore.txt"
+    };
+    removeInterruptedReplacements(fileNames);
+}
+
+/*
+Function Name: loadCompactionSetting
+Purpose: Reads the dead-record ratio from "compaction.txt", if there is one, and gives it to the customer store and the product catalog.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value. Without the file the default of 0.25 stays; a value that is not a ratio between 0 and 1 is reported and ignored.
+*/
+void loadCompactionSetting() {
+    std::ifstream infile("compaction.txt");
+    double ratio = 0.0;
+    if (!infile.is_open()) {
+        return;
+    } else if (!(infile >> ratio) || ratio < 0.0 || ratio > 1.0) {
+        std::cerr << "Warning: compaction.txt must hold a ratio between 0 and 1, e.g. 0.25; keeping the default.\n";
+    } else {
+        customerStore.setDeadRecordThreshold(ratio);
+        productCatalog.setDeadRecordThreshold(ratio);
+    }
+}
+
+/*
+Function Name: loadStartupState
+Purpose: Recovers from any interrupted file replacement, reads the compaction setting, loads every in-memory store, refills the uniqueness sets and finishes any interrupted rescore, then reports how long startup took.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This function does not return a value. It prints the number of customers, products and transactions loaded and the elapsed time.
+*/
+void loadStartupState() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    recoverInterruptedWrites();
+    loadCompactionSetting();
+
+    // Parse the data files once; every customer, product and reward lookup after this is served from memory
+    loadCustomerStore();
+    productCatalog.load("products.txt");
+    rewardsCatalog.load("rewardsList.txt");
+    rewardRules.load("rewardRules.txt");
+    rehydrateGlobalSets();
+    finishRescore("transactions.txt");
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::ostringstream milliseconds;
+    milliseconds << std::fixed << std::setprecision(1) << elapsed.count();
+    std::cout << "Loaded " << customerIDs.size() << " customers, " << productCatalog.size() << " products and "
+              << transactionIDs.size() << " transactions in " << milliseconds.str() << " ms.\n";
+}
+
+/*
+Function Name: runIngest
+Purpose: Loads the stores and replays a sales file through the batch ingest, then prints its summary.
+Meaning of Parameters:
+  - const std::string& fileName: The sales file of "customer ID,product ID,quantity" rows.
+  - int threadCount: How many worker threads to use; 0 or less uses one per CPU core.
+Description of Return Values:
+  - Returns `true` if the file was read and every change was written, even if some rows were rejected.
+  - Returns `false` otherwise.
+*/
+bool runIngest(const std::string& fileName, int threadCount) {
+    IngestSummary summary;
+    std::size_t threads = (threadCount > 0) ? static_cast<std::size_t>(threadCount) : std::thread::hardware_concurrency();
+    loadStartupState();
+    bool succeeded = ingestTransactions(fileName, std::max<std::size_t>(threads, 1), summary);
+    printIngestSummary(summary);
+    customerStore.waitForCompaction();
+    return succeeded;
+}
+
+/*
+Function Name: convertCustomerFile
+Purpose: Runs --import-customers or --export-customers, filling in the default file names for any not given.
+Meaning of Parameters:
+  - const std::string& tool: "--import-customers" or "--export-customers".
+  - int argc: The number of command line arguments.
+  - char* argv[]: The command line arguments; argv[2] and argv[3] are the optional source and destination files.
+Description of Return Values:
+  - Returns `true` if the customer file was converted.
+  - Returns `false` otherwise.
+*/
+bool convertCustomerFile(const std::string& tool, int argc, char* argv[]) {
+    bool importing = (tool == "--import-customers");
+    std::string source = importing ? "customers.txt" : "customers.bin";
+    std::string destination = importing ? "customers.bin" : "customers.txt";
+    source = (argc > 2) ? argv[2] : source;
+    destination = (argc > 3) ? argv[3] : destination;
+    if (importing) {
+        return importCustomersToBinary(source, destination);
+    } else {
+        return exportCustomersToText(source, destination);
+    }
+}
+
+/*
+Function Name: printFilterStats
+Purpose: Prints the size, fill and screening counters of one uniqueness filter.
+Meaning of Parameters:
+  - const BloomFilter& filter: The filter to report on.
+Description of Return Values:
+  - This function does not return a value. The observed false positive rate is the share of checks for keys not in the filter that it could not rule out.
+*/
+void printFilterStats(const BloomFilter& filter) {
+    BloomFilterStats stats = filter.stats();
+    std::uint64_t absent = stats.queries - (stats.possibleHits - stats.falsePositives);
+    double observedRate = (absent > 0) ? static_cast<double>(stats.falsePositives) / absent : 0.0;
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << filter.file() << ": " << stats.keyCount << " of " << stats.capacity << " keys, " << stats.bitCount / 8 / 1024
+              << " KB, " << stats.hashCount << " hash functions\n";
+    std::cout << "\tfalse positive rate: sized for " << stats.configuredRate * 100 << "%, expected now " << stats.expectedRate * 100
+              << "%, observed " << observedRate * 100 << "%\n";
+    std::cout << "\t" << stats.queries << " checks, " << stats.possibleHits << " possible hits, " << stats.falsePositives
+              << " false positives\n";
+}
+
+/*
+Function Name: runFilterTool
+Purpose: Runs --filter-stats or --rebuild-filters on the username and credit card filters.
+Meaning of Parameters:
+  - const std::string& tool: "--filter-stats" or "--rebuild-filters".
+  - int argc: The number of command line arguments.
+  - char* argv[]: The command line arguments; for --rebuild-filters, argv[2] is an optional new false positive rate, e.g. 0.001.
+Description of Return Values:
+  - Returns `true` if the tool succeeded.
+  - Returns `false` if the filters could not be rebuilt.
+*/
+bool runFilterTool(const std::string& tool, int argc, char* argv[]) {
+    bool succeeded = true;
+    loadStartupState();
+    if (tool == "--rebuild-filters") {
+        succeeded = rebuildCustomerFilters((argc > 2) ? std::atof(argv[2]) : 0.0);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    printFilterStats(usernameFilter);
+    printFilterStats(creditCardFilter);
+    return succeeded;
+}
+
+/*
+Function Name: isFilterTool
+Purpose: Checks whether a command line option names one of the filter tools.
+Meaning of Parameters:
+  - const std::string& tool: The option.
+Description of Return Values:
+  - Returns `true` for "--filter-stats" and "--rebuild-filters".
+*/
+bool isFilterTool(const std::string& tool) {
+    return tool == "--filter-stats" || tool == "--rebuild-filters";
+}
+
+/*
+Function Name: runServerTool
+Purpose: Runs --serve: loads the stores once, then serves requests on a Unix domain socket until it is shut down.
+Meaning of Parameters:
+  - int argc: The number of command line arguments.
+  - char* argv[]: The command line arguments; argv[2] is an optional socket path, by default "app.sock", argv[3] an optional number of request threads, by default one per CPU core, and argv[4] an optional durability policy ("op", "<N>ms" or "<N>ops"), by default "op".
+Description of Return Values:
+  - Returns `true` if the server shut down cleanly.
+  - Returns `false` if the durability policy is invalid or the socket could not be opened.
+*/
+bool runServerTool(int argc, char* argv[]) {
+    DurabilityPolicy durability;
+    if (argc > 4 && !parseDurabilityPolicy(argv[4], durability)) {
+        std::cerr << "Error: Invalid durability policy " << argv[4] << ". Use op, <N>ms or <N>ops.\n";
+        return false;
+    } else {
+        loadStartupState();
+    }
+    int threadCount = (argc > 3) ? std::atoi(argv[3]) : 0;
+    return runServer((argc > 2) ? argv[2] : defaultSocketPath, static_cast<std::size_t>(std::max(threadCount, 0)), durability);
+}
+
+/*
+Function Name: runCommandLineTool
+Purpose: Runs one of the non-interactive maintenance tools selected on the command line.
+Meaning of Parameters:
+  - int argc: The number of command line arguments.
+  - char* argv[]: The command line arguments. Supported tools are
+      --import-customers [customers.txt] [customers.bin],
+      --export-customers [customers.bin] [customers.txt],
+      --lookup-customer <customer ID>, --lookup-product <product ID>, --ingest <sales file> [threads], --rescore-transactions,
+      --filter-stats, --rebuild-filters [false positive rate] and --serve [socket path] [threads] [op | <N>ms | <N>ops].
+Description of Return Values:
+  - Returns 0 if the tool succeeded, 1 if it failed, or 2 if the arguments do not name a known tool.
+*/
+int runCommandLineTool(int argc, char* argv[]) {
+    std::string tool = argv[1];
+    bool succeeded = false;
+
+    if (tool == "--import-customers" || tool == "--export-customers") {
+        succeeded = convertCustomerFile(tool, argc, argv);
+    } else if ((tool == "--lookup-customer" || tool == "--lookup-product") && argc > 2) {
+        succeeded = printRecordLookup(tool, argv[2]);
+    } else if (tool == "--ingest" && argc > 2) {
+        succeeded = runIngest(argv[2], (argc > 3) ? std::atoi(argv[3]) : 0);
+    } else if (tool == "--rescore-transactions") {
+        loadStartupState();
+        succeeded = rescoreTransactions("transactions.txt");
+    } else if (isFilterTool(tool)) {
+        succeeded = runFilterTool(tool, argc, argv);
+    } else if (tool == "--serve") {
+        succeeded = runServerTool(argc, argv);
+    } else {
+        std::cerr << "Unknown option " << tool << ".\n";
+        std::cerr << "Usage: " << argv[0] << " [--import-customers [text] [binary] | --export-customers [binary] [text] |\n"
+                  << "        --lookup-customer <customer ID> | --lookup-product <product ID> | --ingest <sales file> [threads] |\n"
+                  << "        --rescore-transactions | --filter-stats | --rebuild-filters [false positive rate] |\n"
+                  << "        --serve [socket path] [threads] [op | <N>ms | <N>ops]]\n";
+        return 2;
+    }
+
+    return succeeded ? 0 : 1;
+}
+
 /*
 Function Name: main
 Purpose: Serves as the entry point of the program, displaying the main menu and handling user input to navigate various functionalities.
 Meaning of Parameters:
-  - None.
+  - int argc: The number of command line arguments.
+  - char* argv[]: The command line arguments. When any are given, the matching tool from runCommandLineTool is run instead of the menu.
 Description of Return Values:
-  - Returns 0 upon successful program termination.
+  - Returns 0 upon successful program termination, or the exit status of the command line tool that was run.
   - Continuously executes a menu loop, invoking appropriate functions based on user input.
 */
-int main() {
+int main(int argc, char* argv[]) {
     int choice;
-    int menuFlag = 0;
-    
+
+    if (argc > 1) {
+        return runCommandLineTool(argc, argv);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    loadStartupState();
+
     // The while loop repeatedly displays the main menu, takes user input, 
     // and performs the appropriate action based on the selected choice, continuing until the user chooses to exit.
     while (true) {
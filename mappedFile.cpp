@@ -0,0 +1,179 @@
+#include <memory>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "mappedFile.h"
+
+/*
+****************************************************************************
+*************************** MAPPED FILE START ******************************
+****************************************************************************
+*/
+
+/*
+Function Name: modifiedNanoseconds
+Purpose: Converts the modification time in a stat result to nanoseconds, so a change within the same second is still noticed.
+Meaning of Parameters:
+  - const struct stat& info: The stat result.
+Description of Return Values:
+  - Returns the modification time in nanoseconds since the epoch.
+*/
+static std::int64_t modifiedNanoseconds(const struct stat& info) {
+    return static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+}
+
+/*
+Method Name: ~MappedFile
+Purpose: Unmaps the file.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+MappedFile::~MappedFile() {
+    close();
+}
+
+/*
+Method Name: open
+Purpose: Maps a whole file read-only. The descriptor is closed straight away; the mapping keeps the file's pages reachable, even if the file is later replaced by a rename.
+Meaning of Parameters:
+  - const std::string& fileName: The file to map.
+Description of Return Values:
+  - Returns `true` if the file was mapped. An empty file counts as mapped, with no contents.
+  - Returns `false` if it could not be opened or mapped.
+*/
+bool MappedFile::open(const std::string& fileName) {
+    close();
+    this->fileName = fileName;
+    struct stat info;
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    } else if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    } else {
+        size = static_cast<std::size_t>(info.st_size);
+        inode = static_cast<std::uint64_t>(info.st_ino);
+        modified = modifiedNanoseconds(info);
+    }
+
+    void* mapped = (size > 0) ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        size = 0;
+        return false;
+    } else {
+        data = static_cast<const char*>(mapped);
+    }
+
+    // Record files are scanned front to back, so ask the kernel to read ahead aggressively
+    if (data != nullptr) {
+        ::madvise(const_cast<char*>(data), size, MADV_SEQUENTIAL);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    opened = true;
+    return true;
+}
+
+/*
+Method Name: refresh
+Purpose: Checks the file on disk and maps it again if it has been replaced, or its size or modification time has changed since it was mapped.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the mapping matches the file on disk.
+  - Returns `false` if the file was never opened or can no longer be mapped; the mapping is released in that case.
+*/
+bool MappedFile::refresh() {
+    struct stat info;
+    if (fileName.empty() || ::stat(fileName.c_str(), &info) != 0) {
+        close();
+        return false;
+    } else if (opened && static_cast<std::size_t>(info.st_size) == size &&
+               static_cast<std::uint64_t>(info.st_ino) == inode && modifiedNanoseconds(info) == modified) {
+        return true;
+    } else {
+        return open(fileName);
+    }
+}
+
+/*
+Method Name: contents
+Purpose: Gives access to the mapped bytes. The view stays valid until the next refresh, open or close.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns a view of the whole file, or an empty view if nothing is mapped.
+*/
+std::string_view MappedFile::contents() const {
+    return std::string_view(data, size);
+}
+
+/*
+Method Name: close
+Purpose: Unmaps the file if it is mapped.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void MappedFile::close() {
+    if (data != nullptr) {
+        ::munmap(const_cast<char*>(data), size);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    data = nullptr;
+    size = 0;
+    opened = false;
+}
+
+/*
+Method Name: isOpen
+Purpose: Reports whether a file is currently mapped.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if a file is mapped.
+  - Returns `false` otherwise.
+*/
+bool MappedFile::isOpen() const {
+    return opened;
+}
+
+/*
+Function Name: mappedFileContents
+Purpose: Gives the lookup and listing code the current contents of a data file. Each file stays mapped between calls and is only mapped again when it has changed on disk.
+Meaning of Parameters:
+  - const std::string& fileName: The data file, e.g. "customers.txt".
+  - std::string_view& contents: Receives a view of the whole file. It stays valid until the next call for the same file.
+Description of Return Values:
+  - Returns `true` if the file is mapped.
+  - Returns `false` if it does not exist or could not be mapped; `contents` is then empty.
+*/
+bool mappedFileContents(const std::string& fileName, std::string_view& contents) {
+    // Only used from the main thread; background compaction writes files but never reads them through here
+    static std::unordered_map<std::string, std::unique_ptr<MappedFile>> mappedFiles;
+    std::unique_ptr<MappedFile>& mapped = mappedFiles[fileName];
+    if (!mapped) {
+        mapped.reset(new MappedFile());
+        mapped->open(fileName);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    bool current = mapped->refresh();
+    contents = mapped->contents();
+    return current;
+}
+
+/*
+****************************************************************************
+**************************** MAPPED FILE END *******************************
+****************************************************************************
+*/
@@ -0,0 +1,35 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/* Declarations for the read-only memory mappings of the text data files (customers.txt, products.txt, transactions.txt) */
+
+// A whole file mapped read-only. refresh() maps it again if it was replaced, resized or modified since it was mapped.
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    bool open(const std::string& fileName);
+    bool refresh();
+    std::string_view contents() const;
+    void close();
+    bool isOpen() const;
+
+private:
+    std::string fileName;
+    const char* data = nullptr;
+    std::size_t size = 0;
+    std::uint64_t inode = 0;
+    std::int64_t modified = 0; // Nanoseconds since the epoch
+    bool opened = false;
+};
+
+bool mappedFileContents(const std::string& fileName, std::string_view& contents);
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,116 @@
+#include "money.h"
+
+/*
+****************************************************************************
+******************************* MONEY START ********************************
+****************************************************************************
+*/
+
+static const std::size_t maxWholeDigits = 15; // Keeps every parsed amount, in cents, well inside 64 bits
+
+/*
+Function Name: readDigits
+Purpose: Reads a run of decimal digits into a number, stopping at the first other character or after a set number of digits.
+Meaning of Parameters:
+  - std::string_view text: The text being parsed.
+  - std::size_t& pos: Where to start; moved past the digits read.
+  - std::size_t maxDigits: The most digits to read.
+  - std::int64_t& value: Receives the number.
+Description of Return Values:
+  - Returns how many digits were read.
+*/
+static std::size_t readDigits(std::string_view text, std::size_t& pos, std::size_t maxDigits, std::int64_t& value) {
+    std::size_t digits = 0;
+    value = 0;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && digits < maxDigits) {
+        value = value * 10 + (text[pos] - '0');
+        ++digits;
+        ++pos;
+    }
+    return digits;
+}
+
+/*
+Function Name: parseMoney
+Purpose: Parses a decimal dollar amount such as "12", "12.5", "$12.50" or ".99" straight into cents, without going through floating point.
+Meaning of Parameters:
+  - std::string_view text: The amount, with an optional leading '$' and at most two decimal places.
+  - Money& amount: Receives the amount if the text is valid.
+Description of Return Values:
+  - Returns `true` if the whole text is a valid amount.
+  - Returns `false` if it is empty, has any other character, more than one decimal point or more than two decimal places; `amount` is unchanged.
+*/
+bool parseMoney(std::string_view text, Money& amount) {
+    std::size_t pos = (!text.empty() && text[0] == '$') ? 1 : 0;
+    std::int64_t whole = 0;
+    std::int64_t fraction = 0;
+    std::size_t fractionDigits = 0;
+    std::size_t wholeDigits = readDigits(text, pos, maxWholeDigits, whole);
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        // A third decimal digit is left unread so the length check below rejects it
+        fractionDigits = readDigits(text, pos, 2, fraction);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (pos != text.size() || wholeDigits + fractionDigits == 0) {
+        return false;
+    } else {
+        amount = Money::fromCents(whole * 100 + ((fractionDigits == 1) ? fraction * 10 : fraction));
+        return true;
+    }
+}
+
+/*
+Function Name: appendMoney
+Purpose: Appends an amount in the "12.50" layout used by the data files, always with two decimal places and no '$'.
+Meaning of Parameters:
+  - std::string& out: The string to append to.
+  - Money amount: The amount to format.
+Description of Return Values:
+  - This function does not return a value.
+*/
+void appendMoney(std::string& out, Money amount) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* first = end;
+    std::uint64_t cents = (amount.cents() < 0) ? 0 - static_cast<std::uint64_t>(amount.cents()) : static_cast<std::uint64_t>(amount.cents());
+
+    *--first = static_cast<char>('0' + cents % 10);
+    *--first = static_cast<char>('0' + cents / 10 % 10);
+    *--first = '.';
+    std::uint64_t whole = cents / 100;
+    // The do-while loop writes the dollars backwards from the decimal point, so zero dollars still prints as "0".
+    do {
+        *--first = static_cast<char>('0' + whole % 10);
+        whole /= 10;
+    } while (whole != 0);
+
+    if (amount.cents() < 0) {
+        *--first = '-';
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    out.append(first, end);
+}
+
+/*
+Function Name: formatMoney
+Purpose: Formats an amount for display or for writing to a data file.
+Meaning of Parameters:
+  - Money amount: The amount to format.
+Description of Return Values:
+  - Returns the amount with two decimal places and no '$', e.g. "12.50".
+*/
+std::string formatMoney(Money amount) {
+    std::string text;
+    appendMoney(text, amount);
+    return text;
+}
+
+/*
+****************************************************************************
+******************************** MONEY END *********************************
+****************************************************************************
+*/
@@ -0,0 +1,70 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/* Declarations for the fixed-point money type used for prices and totals */
+
+// An amount of money held as a whole number of cents, so sums over any number of line items are exact.
+// The arithmetic is defined here in the header so it compiles down to plain integer operations at every call site.
+class Money {
+public:
+    Money() = default;
+
+    static Money fromCents(std::int64_t cents) {
+        Money amount;
+        amount.amountInCents = cents;
+        return amount;
+    }
+    std::int64_t cents() const {
+        return amountInCents;
+    }
+
+    Money operator+(Money other) const {
+        return fromCents(amountInCents + other.amountInCents);
+    }
+    Money operator-(Money other) const {
+        return fromCents(amountInCents - other.amountInCents);
+    }
+    Money operator*(int quantity) const {
+        return fromCents(amountInCents * quantity);
+    }
+    Money& operator+=(Money other) {
+        amountInCents += other.amountInCents;
+        return *this;
+    }
+    Money& operator-=(Money other) {
+        amountInCents -= other.amountInCents;
+        return *this;
+    }
+
+    bool operator==(Money other) const {
+        return amountInCents == other.amountInCents;
+    }
+    bool operator!=(Money other) const {
+        return amountInCents != other.amountInCents;
+    }
+    bool operator<(Money other) const {
+        return amountInCents < other.amountInCents;
+    }
+    bool operator<=(Money other) const {
+        return amountInCents <= other.amountInCents;
+    }
+    bool operator>(Money other) const {
+        return amountInCents > other.amountInCents;
+    }
+    bool operator>=(Money other) const {
+        return amountInCents >= other.amountInCents;
+    }
+
+private:
+    std::int64_t amountInCents = 0;
+};
+
+bool parseMoney(std::string_view text, Money& amount);
+void appendMoney(std::string& out, Money amount);
+std::string formatMoney(Money amount);
+
+#endif // MONEY_H
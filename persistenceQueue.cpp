@@ -0,0 +1,457 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "persistenceQueue.h"
+#include "globals.h"
+#include "recordParser.h"
+#include "transactions.h"
+
+/*
+****************************************************************************
+************************** PERSISTENCE QUEUE START *************************
+****************************************************************************
+*/
+
+// The delay before the first retry of a failed batch; it doubles with each failure in a row, up to the maximum
+static const int firstRetryDelayMs = 100;
+static const int maxRetryDelayMs = 5000;
+// How many times a failing batch is tried once the queue is stopping, before its changes are given up
+static const int stoppingAttempts = 3;
+
+/*
+Function Name: countBatchOperations
+Purpose: Counts the changes a batch still holds: one per catalog save, transaction record and reward change.
+Meaning of Parameters:
+  - const PersistenceBatch& batch: The batch.
+Description of Return Values:
+  - Returns the count, or 0 if the batch holds nothing to write.
+*/
+static std::size_t countBatchOperations(const PersistenceBatch& batch) {
+    std::size_t operations = batch.rewardChanges.size();
+    operations += batch.productsChanged ? 1 : 0;
+    operations += batch.rewardsChanged ? 1 : 0;
+    operations += batch.transactionsQueued;
+    return operations;
+}
+
+/*
+Function Name: requeueBatch
+Purpose: Puts what a failed batch could not write back in front of the changes queued since, so transaction records and reward changes stay in the order they were made.
+Meaning of Parameters:
+  - const PersistenceBatch& failed: What is left of the failed batch.
+  - PersistenceBatch& pending: The queue's pending batch; the failed changes are merged into it.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void requeueBatch(const PersistenceBatch& failed, PersistenceBatch& pending) {
+    pending.productsChanged = pending.productsChanged || failed.productsChanged;
+    pending.rewardsChanged = pending.rewardsChanged || failed.rewardsChanged;
+    pending.transactionRecords.insert(0, failed.transactionRecords);
+    pending.transactionCount = (pending.transactionCount > 0) ? pending.transactionCount : failed.transactionCount;
+    pending.transactionsQueued += failed.transactionsQueued;
+    pending.rewardChanges.insert(pending.rewardChanges.begin(), failed.rewardChanges.begin(), failed.rewardChanges.end());
+}
+
+/*
+Method Name: ~PersistenceQueue
+Purpose: Writes anything still queued and stops the writer thread, so changes acknowledged before the program exits are not lost.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+PersistenceQueue::~PersistenceQueue() {
+    stop();
+}
+
+/*
+Method Name: start
+Purpose: Applies a durability policy. Any policy but EveryOperation starts the background writer thread.
+Meaning of Parameters:
+  - const DurabilityPolicy& policy: The policy; its limit must be positive unless the mode is EveryOperation.
+Description of Return Values:
+  - This method does not return a value. A writer already running is stopped first, after writing what it had queued.
+*/
+void PersistenceQueue::start(const DurabilityPolicy& policy) {
+    stop();
+    std::unique_lock<std::mutex> guard(lock);
+    this->policy = policy;
+    if (policy.mode == DurabilityMode::EveryOperation) {
+        return;
+    } else {
+        running = true;
+    }
+    guard.unlock();
+    writer = std::thread(&PersistenceQueue::writerLoop, this);
+}
+
+/*
+Method Name: stop
+Purpose: Writes everything queued, then stops the writer thread; later changes are written straight through again.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void PersistenceQueue::stop() {
+    std::unique_lock<std::mutex> guard(lock);
+    stopping = true;
+    guard.unlock();
+    wakeWriter.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    guard.lock();
+    stopping = false;
+}
+
+/*
+Method Name: flush
+Purpose: Blocks until every change queued so far has been written, without waiting for the policy's limit.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void PersistenceQueue::flush() {
+    std::unique_lock<std::mutex> guard(lock);
+    flushWanted = (pendingOperations > 0);
+    wakeWriter.notify_one();
+    while (running && (pendingOperations > 0 || writing)) {
+        batchDone.wait(guard);
+    }
+}
+
+/*
+Method Name: saveProducts
+Purpose: Saves the product catalog to "products.txt" after an inventory change, or queues the save.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the catalog was saved or the save was queued.
+  - Returns `false` and outputs an error message if a save on the caller's thread failed.
+*/
+bool PersistenceQueue::saveProducts() {
+    std::unique_lock<std::mutex> guard(lock);
+    if (!running) {
+        guard.unlock();
+        return productCatalog.save();
+    } else {
+        pending.productsChanged = true;
+        queued(guard);
+        return true;
+    }
+}
+
+/*
+Method Name: saveRewards
+Purpose: Saves the rewards catalog to "rewardsList.txt" after an inventory change, or queues the save.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the catalog was saved or the save was queued.
+  - Returns `false` and outputs an error message if a save on the caller's thread failed.
+*/
+bool PersistenceQueue::saveRewards() {
+    std::unique_lock<std::mutex> guard(lock);
+    if (!running) {
+        guard.unlock();
+        return rewardsCatalog.save();
+    } else {
+        pending.rewardsChanged = true;
+        queued(guard);
+        return true;
+    }
+}
+
+/*
+Method Name: appendTransaction
+Purpose: Appends a transaction record to "transactions.txt" and writes the transaction counter, or queues both. Records are written in the order they are queued.
+Meaning of Parameters:
+  - const std::string& record: The formatted transaction record.
+  - int transactionCount: The counter value to store after it, i.e. the next transaction number.
+  - std::unique_lock<std::mutex>& order: The caller's hold on the lock the record was numbered under; released once the record is queued, before any write is waited for.
+Description of Return Values:
+  - Returns `true` if the record was appended or queued.
+  - Returns `false` and outputs an error message if an append on the caller's thread failed.
+*/
+bool PersistenceQueue::appendTransaction(const std::string& record, int transactionCount, std::unique_lock<std::mutex>& order) {
+    std::unique_lock<std::mutex> guard(lock);
+    if (!running) {
+        guard.unlock();
+        return saveTransactionsToFile(record, transactionCount, order);
+    } else {
+        pending.transactionRecords += record;
+        pending.transactionCount = transactionCount;
+        ++pending.transactionsQueued;
+        queued(guard);
+        order.unlock();
+        return true;
+    }
+}
+
+/*
+Method Name: persistRewardPoints
+Purpose: Records a reward balance change already applied in memory, through the customer store, or queues it.
+Meaning of Parameters:
+  - CustomerId userID: The customer whose balance changed.
+  - int delta: The signed number of points added or removed.
+  - const std::string& reason: A one-word reason for the ledger.
+  - const std::string& reference: The transaction ID or reward product ID behind the change.
+Description of Return Values:
+  - Returns `true` if the change was written or queued.
+  - Returns `false` if a write on the caller's thread failed or the customer does not exist.
+*/
+bool PersistenceQueue::persistRewardPoints(CustomerId userID, int delta, const std::string& reason, const std::string& reference) {
+    std::unique_lock<std::mutex> guard(lock);
+    if (!running) {
+        guard.unlock();
+        return customerStore.persistRewardPoints(userID, delta, reason, reference);
+    } else {
+        RewardLedgerEntry change;
+        change.userID = userID;
+        change.delta = delta;
+        change.reason = reason;
+        change.reference = reference;
+        pending.rewardChanges.push_back(change);
+        queued(guard);
+        return true;
+    }
+}
+
+/*
+Method Name: stats
+Purpose: Reports how much the writer thread has written. Changes written straight through are not counted.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the counts of queued changes, batches, file writes and failed writes.
+*/
+PersistenceStats PersistenceQueue::stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return counters;
+}
+
+/*
+Method Name: queued
+Purpose: Counts a change just added to the pending batch, and wakes the writer if that may make the batch due.
+Meaning of Parameters:
+  - std::unique_lock<std::mutex>& guard: The caller's hold on the queue lock; it is released.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void PersistenceQueue::queued(std::unique_lock<std::mutex>& guard) {
+    ++pendingOperations;
+    ++counters.operations;
+    // The first change starts the interval; under OperationCount only reaching the limit matters
+    bool wake = (policy.mode == DurabilityMode::Interval) ? pendingOperations == 1 : pendingOperations >= static_cast<std::size_t>(policy.limit);
+    guard.unlock();
+    if (wake) {
+        wakeWriter.notify_one();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: waitForBatch
+Purpose: Sleeps until the pending batch is due under the policy, a flush is wanted or the queue is stopping.
+Meaning of Parameters:
+  - std::unique_lock<std::mutex>& guard: The writer's hold on the queue lock.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void PersistenceQueue::waitForBatch(std::unique_lock<std::mutex>& guard) {
+    while (pendingOperations == 0 && !stopping) {
+        wakeWriter.wait(guard);
+    }
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(policy.limit);
+    bool due = stopping || flushWanted || (policy.mode == DurabilityMode::OperationCount && pendingOperations >= static_cast<std::size_t>(policy.limit));
+    while (!due) {
+        if (policy.mode == DurabilityMode::Interval) {
+            due = (wakeWriter.wait_until(guard, deadline) == std::cv_status::timeout);
+        } else {
+            wakeWriter.wait(guard);
+        }
+        due = due || stopping || flushWanted || (policy.mode == DurabilityMode::OperationCount && pendingOperations >= static_cast<std::size_t>(policy.limit));
+    }
+}
+
+/*
+Method Name: writeBatch
+Purpose: Writes one batch, each file at most once: the transaction records, the reward changes, then the catalogs. Each part that is written is cleared from the batch, so what is left afterwards is exactly what failed.
+Meaning of Parameters:
+  - PersistenceBatch& batch: The batch to write; left holding only the parts that could not be written.
+Description of Return Values:
+  - Returns the number of file writes made and how many of them failed; the other counts are 0.
+*/
+PersistenceStats PersistenceQueue::writeBatch(PersistenceBatch& batch) {
+    PersistenceStats written;
+    if (batch.transactionCount > 0) {
+        ++written.fileWrites;
+        // The batch was queued in number order and is its only writer, so it needs no ordering lock
+        std::unique_lock<std::mutex> unordered;
+        if (saveTransactionsToFile(batch.transactionRecords, batch.transactionCount, unordered)) {
+            batch.transactionRecords.clear();
+            batch.transactionCount = 0;
+            batch.transactionsQueued = 0;
+        } else {
+            ++written.failedWrites;
+        }
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (!batch.rewardChanges.empty()) {
+        ++written.fileWrites;
+        std::vector<RewardLedgerEntry> unwritten;
+        written.failedWrites += customerStore.persistRewardChanges(batch.rewardChanges, unwritten) ? 0 : 1;
+        batch.rewardChanges.swap(unwritten);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (batch.productsChanged) {
+        ++written.fileWrites;
+        batch.productsChanged = !productCatalog.save();
+        written.failedWrites += batch.productsChanged ? 1 : 0;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (batch.rewardsChanged) {
+        ++written.fileWrites;
+        batch.rewardsChanged = !rewardsCatalog.save();
+        written.failedWrites += batch.rewardsChanged ? 1 : 0;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    return written;
+}
+
+/*
+Method Name: retryFailedWrites
+Purpose: Puts the changes a batch could not write back at the front of the queue and waits, a little longer after each failure in a row, before the writer tries them again. Once the queue is stopping the changes are tried a few more times and then given up, with an error.
+Meaning of Parameters:
+  - PersistenceBatch& failed: What is left of the batch after writeBatch; empty if it was written in full.
+  - std::unique_lock<std::mutex>& guard: Holds the queue's lock; released while waiting.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void PersistenceQueue::retryFailedWrites(PersistenceBatch& failed, std::unique_lock<std::mutex>& guard) {
+    std::size_t operations = countBatchOperations(failed);
+    failedAttempts = (operations > 0) ? failedAttempts + 1 : 0;
+    if (operations == 0) {
+        return;
+    } else if (stopping && failedAttempts >= stoppingAttempts) {
+        counters.abandoned += operations;
+        failedAttempts = 0;
+        std::cerr << "Error: " << operations << " changes could not be written before shutdown and were lost.\n";
+        return;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    requeueBatch(failed, pending);
+    pendingOperations += operations;
+    counters.retried += operations;
+    flushWanted = true;
+    int delayMs = std::min(maxRetryDelayMs, firstRetryDelayMs << std::min(failedAttempts - 1, 6));
+    std::cerr << "Warning: " << operations << " changes could not be written; retrying in " << delayMs << " ms.\n";
+    std::chrono::steady_clock::time_point retryAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+    while (std::chrono::steady_clock::now() < retryAt) {
+        wakeWriter.wait_until(guard, retryAt);
+    }
+}
+
+/*
+Method Name: writerLoop
+Purpose: The body of the writer thread: waits for a batch to come due, takes it off the queue and writes it, until the queue is stopped with nothing left to write.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. Changes made after it returns are written straight through.
+*/
+void PersistenceQueue::writerLoop() {
+    std::unique_lock<std::mutex> guard(lock);
+    waitForBatch(guard);
+    // The batch is taken under the lock but written without it, so operations keep queueing during the write
+    while (pendingOperations > 0) {
+        PersistenceBatch batch;
+        std::swap(batch, pending);
+        pendingOperations = 0;
+        flushWanted = false;
+        writing = true;
+        guard.unlock();
+        PersistenceStats written = writeBatch(batch);
+        guard.lock();
+        writing = false;
+        ++counters.batches;
+        counters.fileWrites += written.fileWrites;
+        counters.failedWrites += written.failedWrites;
+        batchDone.notify_all();
+        retryFailedWrites(batch, guard);
+        waitForBatch(guard);
+    }
+    running = false;
+    batchDone.notify_all();
+}
+
+/*
+Function Name: parseDurabilityPolicy
+Purpose: Parses a durability policy given on the command line: "op" writes every operation through, "<N>ms" writes every N milliseconds and "<N>ops" every N operations.
+Meaning of Parameters:
+  - const std::string& text: The policy text.
+  - DurabilityPolicy& policy: Receives the policy.
+Description of Return Values:
+  - Returns `true` if the text is a valid policy.
+  - Returns `false` otherwise; `policy` is left unchanged.
+*/
+bool parseDurabilityPolicy(const std::string& text, DurabilityPolicy& policy) {
+    std::size_t digits = text.find_first_not_of("0123456789");
+    int limit = 0;
+    if (text == "op") {
+        policy = DurabilityPolicy();
+        return true;
+    } else if (digits == 0 || digits == std::string::npos || !parseNumber(text, limit) || limit <= 0) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::string unit = text.substr(digits);
+    if (unit == "ms" || unit == "ops") {
+        policy.mode = (unit == "ms") ? DurabilityMode::Interval : DurabilityMode::OperationCount;
+        policy.limit = limit;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/*
+Function Name: describeDurabilityPolicy
+Purpose: Describes a durability policy for log messages.
+Meaning of Parameters:
+  - const DurabilityPolicy& policy: The policy.
+Description of Return Values:
+  - Returns e.g. "every operation", "every 50 ms" or "every 100 operations".
+*/
+std::string describeDurabilityPolicy(const DurabilityPolicy& policy) {
+    if (policy.mode == DurabilityMode::Interval) {
+        return "every " + std::to_string(policy.limit) + " ms";
+    } else if (policy.mode == DurabilityMode::OperationCount) {
+        return "every " + std::to_string(policy.limit) + " operations";
+    } else {
+        return "every operation";
+    }
+}
+
+/*
+****************************************************************************
+*************************** PERSISTENCE QUEUE END **************************
+****************************************************************************
+*/
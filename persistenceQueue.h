@@ -0,0 +1,93 @@
+#ifndef PERSISTENCEQUEUE_H
+#define PERSISTENCEQUEUE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "recordId.h"
+#include "rewardLedger.h"
+
+/* Declarations for the write-behind queue between the in-memory stores and the data files */
+
+// When queued changes are written to the data files. EveryOperation writes each change before the operation
+// returns, as the menu always has. Interval writes whatever has queued once `limit` milliseconds have passed since
+// the first unwritten change; OperationCount writes once `limit` changes have queued.
+enum class DurabilityMode { EveryOperation, Interval, OperationCount };
+
+struct DurabilityPolicy {
+    DurabilityMode mode = DurabilityMode::EveryOperation;
+    int limit = 0;
+};
+
+struct PersistenceStats {
+    std::uint64_t operations = 0;   // Changes queued
+    std::uint64_t batches = 0;      // Times the writer wrote what had queued
+    std::uint64_t fileWrites = 0;   // Catalog saves, transaction log appends and reward ledger batches in those batches
+    std::uint64_t failedWrites = 0; // Of those, the ones that failed; each is reported on std::cerr
+    std::uint64_t retried = 0;      // Changes put back in the queue after a failed write, counted once per retry
+    std::uint64_t abandoned = 0;    // Changes still failing when the queue stopped; reported on std::cerr
+};
+
+// Everything queued since the last batch. Changes to the same file are coalesced: any number of inventory changes
+// become one catalog save, and any number of transactions become one append and one counter write.
+struct PersistenceBatch {
+    bool productsChanged = false;
+    bool rewardsChanged = false;
+    std::string transactionRecords;     // Formatted records, in transaction number order
+    std::size_t transactionsQueued = 0; // How many records transactionRecords holds
+    int transactionCount = 0;           // The counter value to write after them; 0 if no transaction is queued
+    std::vector<RewardLedgerEntry> rewardChanges;
+};
+
+// Decouples the operations that change the data files from the writes themselves. Under EveryOperation (the
+// default) each call writes straight through on the caller's thread. Once started with another policy, a call only
+// records what must be written and returns; a background writer thread takes everything queued in one batch and
+// writes it, so a purchase's latency no longer depends on the size of products.txt or on how the disk is doing.
+// A change acknowledged under those policies is lost if the process dies before its batch is written. A write that
+// fails while the process keeps running (a full or failing disk) is not dropped: the changes it held go back to the
+// front of the queue and are retried with a growing delay, until they are written or the queue is stopped.
+class PersistenceQueue {
+public:
+    PersistenceQueue() = default;
+    PersistenceQueue(const PersistenceQueue&) = delete;
+    PersistenceQueue& operator=(const PersistenceQueue&) = delete;
+    ~PersistenceQueue();
+
+    void start(const DurabilityPolicy& policy);
+    void stop();
+    void flush();
+    bool saveProducts();
+    bool saveRewards();
+    bool appendTransaction(const std::string& record, int transactionCount, std::unique_lock<std::mutex>& order);
+    bool persistRewardPoints(CustomerId userID, int delta, const std::string& reason, const std::string& reference);
+    PersistenceStats stats() const;
+
+private:
+    DurabilityPolicy policy;
+    std::thread writer;
+    mutable std::mutex lock;
+    std::condition_variable wakeWriter; // Signalled when a batch may be due, a flush is wanted or the queue is stopping
+    std::condition_variable batchDone;  // Signalled when the writer has finished a batch
+    PersistenceBatch pending;           // Guarded by lock, as are the fields below
+    std::size_t pendingOperations = 0;
+    bool running = false;
+    bool writing = false;
+    bool flushWanted = false;
+    bool stopping = false;
+    int failedAttempts = 0;             // Batches in a row that could not be written in full
+    PersistenceStats counters;
+
+    void writerLoop();
+    void waitForBatch(std::unique_lock<std::mutex>& guard);
+    PersistenceStats writeBatch(PersistenceBatch& batch);
+    void retryFailedWrites(PersistenceBatch& failed, std::unique_lock<std::mutex>& guard);
+    void queued(std::unique_lock<std::mutex>& guard);
+};
+
+bool parseDurabilityPolicy(const std::string& text, DurabilityPolicy& policy);
+std::string describeDurabilityPolicy(const DurabilityPolicy& policy);
+
+#endif // PERSISTENCEQUEUE_H
@@ -0,0 +1,393 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include "productCatalog.h"
+#include "durableFile.h"
+#include "mappedFile.h"
+#include "recordIndex.h"
+#include "recordParser.h"
+#include "tombstoneLog.h"
+#include "utility.h"
+
+/*
+****************************************************************************
+************************* PRODUCT CATALOG START ****************************
+****************************************************************************
+*/
+
+/*
+Function Name: formatProductRecord
+Purpose: Converts a product record into the text layout used by the "products.txt" file.
+Meaning of Parameters:
+  - const ProductRecord& record: The product record to format.
+Description of Return Values:
+  - Returns the formatted record, starting with the "Product N" header line and with the price shown to two decimal places.
+*/
+std::string formatProductRecord(const ProductRecord& record) {
+    std::ostringstream oss;
+    oss << "Product " << record.productNumber << "\n"
+        << "\tID: " << formatId(record.productID) << "\n"
+        << "\tName: " << record.name << "\n"
+        << "\tPrice: $" << formatMoney(record.price) << "\n"
+        << "\tInventory Count: " << record.inventory << "\n";
+    return oss.str();
+}
+
+/*
+Function Name: applyProductField
+Purpose: Stores a single "Key: value" field read from "products.txt" into the matching attribute of a product record.
+Meaning of Parameters:
+  - ProductRecord& record: The record being filled in.
+  - std::string_view line: A trimmed line from the product file.
+Description of Return Values:
+  - This function does not return a value. Lines that do not match a known field are ignored.
+*/
+static void applyProductField(ProductRecord& record, std::string_view line) {
+    std::string_view value;
+    int inventory = 0;
+    if (fieldValue(line, "ID:", value)) {
+        parseProductId(value, record.productID);
+    } else if (fieldValue(line, "Name:", value)) {
+        record.name.assign(value);
+    } else if (fieldValue(line, "Price: $", value)) {
+        parseMoney(value, record.price);
+    } else if (fieldValue(line, "Inventory Count:", value) && parseNumber(value, inventory)) {
+        record.inventory = inventory;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Function Name: parseProductRecords
+Purpose: Parses product records out of a buffer holding product file text, copying only the field values that are kept.
+Meaning of Parameters:
+  - std::string_view text: The whole product file, or the text of a single record.
+  - std::vector<ProductRecord>& records: Receives the records, appended in file order.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void parseProductRecords(std::string_view text, std::vector<ProductRecord>& records) {
+    RecordParser parser(text);
+    std::string_view line;
+    std::string_view value;
+    std::size_t first = records.size();
+    // The while loop starts a new record at every "Product N" header and routes the following field lines into it.
+    while (parser.nextLine(line)) {
+        if (fieldValue(line, "Product", value)) {
+            records.push_back(ProductRecord());
+            parseNumber(value, records.back().productNumber);
+        } else if (records.size() > first) {
+            applyProductField(records.back(), line);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: readRemovedIDs
+Purpose: Reads the product IDs in a removal log.
+Meaning of Parameters:
+  - const std::string& fileName: The removal log. A missing log counts as empty.
+  - std::unordered_set<ProductId>& ids: Receives the removed IDs; existing contents are kept.
+Description of Return Values:
+  - This function does not return a value. Lines that are not product IDs are skipped.
+*/
+static void readRemovedIDs(const std::string& fileName, std::unordered_set<ProductId>& ids) {
+    std::unordered_set<std::string> lines;
+    ProductId id{};
+    readTombstones(fileName, lines);
+    for (std::unordered_set<std::string>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+        if (parseProductId(*it, id)) {
+            ids.insert(id);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: lookupProductRecord
+Purpose: Reads a single product straight from the product file through its record index, without loading the whole file.
+Meaning of Parameters:
+  - const std::string& fileName: The product file, normally "products.txt".
+  - ProductId productID: The product to look up.
+  - ProductRecord& record: Receives the product record if it is found.
+Description of Return Values:
+  - Returns `true` if the product exists.
+  - Returns `false` if the product ID is not in the file, has been removed, or the file could not be read.
+*/
+bool lookupProductRecord(const std::string& fileName, ProductId productID, ProductRecord& record) {
+    RecordLocation location;
+    std::string text;
+    std::string idText = formatId(productID);
+    if (isTombstoned(fileName, idText) || !findRecordLocation(fileName, "Product", idText, location) ||
+        !readRecordAt(fileName, location, text)) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::vector<ProductRecord> found;
+    parseProductRecords(text, found);
+    record = found.empty() ? ProductRecord() : found.front();
+    return true;
+}
+
+/*
+Method Name: load
+Purpose: Parses the product file once and builds the hash index from product ID to record.
+Meaning of Parameters:
+  - const std::string& fileName: The product file to read, normally "products.txt".
+Description of Return Values:
+  - Returns `true` if the file was read.
+  - Returns `false` if the file could not be opened; the catalog is left empty in that case.
+*/
+bool ProductCatalog::load(const std::string& fileName) {
+    this->fileName = fileName;
+    records.clear();
+    index.clear();
+    removedIDs.clear();
+    deadRecords = 0;
+
+    std::string_view contents;
+    if (!mappedFileContents(fileName, contents)) {
+        return false;
+    } else {
+        parseProductRecords(contents, records);
+    }
+
+    // Records named in the removal log stay hidden until the file is compacted
+    readRemovedIDs(tombstoneFileName(fileName), removedIDs);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].deleted = removedIDs.count(records[i].productID) > 0;
+        deadRecords += records[i].deleted ? 1 : 0;
+    }
+
+    reindex();
+    return true;
+}
+
+/*
+Method Name: save
+Purpose: Rewrites the product file from the live in-memory records, along with its record index ("products.idx"). This is the single persistence path for inventory changes, and it compacts away removed records and empties the removal log. Concurrent calls take turns; each writes the counts as they are when it starts, so the last one to finish includes every deduction made before it.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the file was replaced.
+  - Returns `false` and outputs an error message if it could not be; the old file is kept in that case.
+*/
+bool ProductCatalog::save() {
+    std::lock_guard<std::mutex> guard(saveLock);
+    dropDeadRecords();
+    std::vector<RecordLocation> locations(records.size());
+    std::string contents;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        std::string text = formatProductRecord(records[i]);
+        locations[i].id = formatId(records[i].productID);
+        locations[i].offset = contents.size();
+        locations[i].length = static_cast<std::uint32_t>(text.size());
+        contents += text;
+    }
+
+    // The removal log is only dropped once the rewritten file, which leaves the removed records out, is in place
+    if (!replaceFile(fileName, contents)) {
+        return false;
+    } else {
+        writeRecordIndex(fileName, locations);
+    }
+    std::remove(tombstoneFileName(fileName).c_str());
+    removedIDs.clear();
+    return true;
+}
+
+/*
+Method Name: append
+Purpose: Adds a new product record to the catalog, appends it to the end of the product file and adds its entry to the record index.
+Meaning of Parameters:
+  - const ProductRecord& record: The new product record.
+Description of Return Values:
+  - Returns `true` if the record was appended to the file.
+  - Returns `false` and outputs an error message if the file could not be opened; the record is not indexed in that case.
+*/
+bool ProductCatalog::append(const ProductRecord& record) {
+    // A reused ID must not stay hidden by an old entry in the removal log
+    if (removedIDs.count(record.productID) > 0 && !save()) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::ofstream outfile(fileName, std::ios::app);
+    if (!outfile.is_open()) {
+        std::cerr << "Error: Could not open " << fileName << " file.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::string text = formatProductRecord(record);
+    outfile << text;
+    outfile.close();
+    appendRecordIndex(fileName, formatId(record.productID), static_cast<std::uint32_t>(text.size()));
+
+    index[record.productID] = records.size();
+    records.push_back(record);
+    return true;
+}
+
+/*
+Method Name: remove
+Purpose: Removes a product record by hiding it from the index and logging its ID in "products.removed.txt", instead of rewriting the product file. The file is rewritten only once the share of removed records passes the dead record threshold.
+Meaning of Parameters:
+  - ProductId productID: The product to remove.
+Description of Return Values:
+  - Returns `true` if the record existed and the removal was recorded.
+  - Returns `false` if the product ID is not in the catalog or the removal log could not be written.
+*/
+bool ProductCatalog::remove(ProductId productID) {
+    std::unordered_map<ProductId, std::size_t>::const_iterator it = index.find(productID);
+    if (it == index.end() || !appendTombstone(tombstoneFileName(fileName), formatId(productID))) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    records[it->second].deleted = true;
+    removedIDs.insert(productID);
+    index.erase(it);
+    ++deadRecords;
+
+    if (static_cast<double>(deadRecords) > deadRecordThreshold * static_cast<double>(records.size())) {
+        return save();
+    } else {
+        return true;
+    }
+}
+
+/*
+Method Name: setDeadRecordThreshold
+Purpose: Sets how large a share of the records may be removed-but-not-compacted before the product file is rewritten.
+Meaning of Parameters:
+  - double ratio: The share, between 0 and 1. 0 rewrites the file on every removal.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void ProductCatalog::setDeadRecordThreshold(double ratio) {
+    deadRecordThreshold = ratio;
+}
+
+/*
+Method Name: dropDeadRecords
+Purpose: Erases removed records from memory before the file is rewritten without them.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. The index is rebuilt if anything was erased.
+*/
+void ProductCatalog::dropDeadRecords() {
+    if (deadRecords == 0) {
+        return;
+    } else {
+        deadRecords = 0;
+    }
+
+    std::vector<ProductRecord> live;
+    live.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (!records[i].deleted) {
+            live.push_back(records[i]);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    records.swap(live);
+    reindex();
+}
+
+/*
+Method Name: find
+Purpose: Looks up a product record by its product ID.
+Meaning of Parameters:
+  - ProductId productID: The product to look up.
+Description of Return Values:
+  - Returns a pointer to the record if it exists, or `nullptr` if it does not.
+*/
+ProductRecord* ProductCatalog::find(ProductId productID) {
+    std::unordered_map<ProductId, std::size_t>::const_iterator it = index.find(productID);
+    if (it == index.end()) {
+        return nullptr;
+    } else {
+        return &records[it->second];
+    }
+}
+
+/*
+Method Name: find (const)
+Purpose: Looks up a product record by its product ID without allowing modification.
+Meaning of Parameters:
+  - ProductId productID: The product to look up.
+Description of Return Values:
+  - Returns a pointer to the record if it exists, or `nullptr` if it does not.
+*/
+const ProductRecord* ProductCatalog::find(ProductId productID) const {
+    std::unordered_map<ProductId, std::size_t>::const_iterator it = index.find(productID);
+    if (it == index.end()) {
+        return nullptr;
+    } else {
+        return &records[it->second];
+    }
+}
+
+/*
+Method Name: all
+Purpose: Gives read access to every product record in file order, for listing the catalog. Removed records stay in the list, flagged `deleted`, until the next compaction.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns a reference to the record list.
+*/
+const std::vector<ProductRecord>& ProductCatalog::all() const {
+    return records;
+}
+
+/*
+Method Name: size
+Purpose: Reports how many product records are currently in the catalog.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the number of live records in the catalog; removed records awaiting compaction are not counted.
+*/
+std::size_t ProductCatalog::size() const {
+    return index.size();
+}
+
+/*
+Method Name: reindex
+Purpose: Rebuilds the hash index from product ID to position in the record list, leaving out removed records.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. It replaces the contents of the index.
+*/
+void ProductCatalog::reindex() {
+    index.clear();
+    index.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (!records[i].deleted) {
+            index[records[i].productID] = i;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+****************************************************************************
+************************** PRODUCT CATALOG END *****************************
+****************************************************************************
+*/
@@ -0,0 +1,52 @@
+#ifndef PRODUCTCATALOG_H
+#define PRODUCTCATALOG_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "inventoryCount.h"
+#include "money.h"
+#include "recordId.h"
+
+/* Declarations for the in-memory product catalog backed by products.txt */
+
+struct ProductRecord {
+    int productNumber = 0;
+    ProductId productID{};
+    std::string name;
+    Money price;
+    InventoryCount inventory;
+    bool deleted = false; // Removed, but still in the file until the next compaction
+};
+
+class ProductCatalog {
+public:
+    bool load(const std::string& fileName);
+    bool save();
+    bool append(const ProductRecord& record);
+    bool remove(ProductId productID);
+    void setDeadRecordThreshold(double ratio);
+    ProductRecord* find(ProductId productID);
+    const ProductRecord* find(ProductId productID) const;
+    const std::vector<ProductRecord>& all() const;
+    std::size_t size() const;
+
+private:
+    std::string fileName = "products.txt";
+    std::vector<ProductRecord> records;
+    std::unordered_map<ProductId, std::size_t> index;
+    std::unordered_set<ProductId> removedIDs; // IDs in the removal log
+    std::size_t deadRecords = 0;
+    double deadRecordThreshold = 0.25;          // Compact once this fraction of the records are removed
+    std::mutex saveLock;                        // Concurrent purchases each save; one rewrite runs at a time
+
+    void dropDeadRecords();
+    void reindex();
+};
+
+std::string formatProductRecord(const ProductRecord& record);
+bool lookupProductRecord(const std::string& fileName, ProductId productID, ProductRecord& record);
+
+#endif // PRODUCTCATALOG_H
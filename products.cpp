@@ -10,6 +10,8 @@
 #include <cctype>
 #include <iomanip>
 #include "products.h"
+#include "durableFile.h"
+#include "cart.h"
 #include "globals.h"
 #include "utility.h"
 
@@ -23,12 +25,12 @@
 Class Name: Product
 Purpose: Represents a product with attributes such as ID, name, price, and inventory, and provides methods to manage and persist product data.
 Meaning of Attributes:
-  - std::string productID: A unique identifier for the product, generated when the product is created.
+  - ProductId productID: A unique identifier for the product, generated when the product is created.
   - std::string name: The name of the product.
-  - double price: The price of the product in dollars, stored as a double with two decimal places.
+  - Money price: The price of the product, in whole cents.
   - int inventory: The quantity of the product available in stock.
 Description of Methods:
-  - Product(std::string pname, double pprice, int pinventory): 
+  - Product(std::string pname, Money pprice, int pinventory): 
       Constructor to initialize a product with a name, price, and inventory, and generate a unique product ID.
   - std::string toString(int productNumber) const: 
       Converts product information into a formatted string representation, including the product number, ID, name, price (with two decimal places), and inventory count.
@@ -41,16 +43,34 @@ Description of Methods:
 */
 class Product {
 public:
-    std::string productID;
+    ProductId productID;
     std::string name;
-    double price;
+    Money price;
     int inventory;
 
-    Product(std::string pname, double pprice, int pinventory)
+    Product(std::string pname, Money pprice, int pinventory)
         : name(pname), price(pprice), inventory(pinventory) {
         productID = generateProductID();
     }
 
+    /*
+    Method Name: toRecord
+    Purpose: Copies the product information into a record that can be stored in the product catalog.
+    Meaning of Parameters:
+    - int productNumber: The product number to include in the record.
+    Description of Return Values:
+    - Returns a ProductRecord holding the product number, ID, name, price, and inventory count.
+    */
+    ProductRecord toRecord(int productNumber) const {
+        ProductRecord record;
+        record.productNumber = productNumber;
+        record.productID = productID;
+        record.name = name;
+        record.price = price;
+        record.inventory = inventory;
+        return record;
+    }
+
     /*
     Method Name: toString
     Purpose: Converts product information into a formatted string representation.
@@ -60,34 +80,23 @@ public:
     - Returns a formatted string containing product details, including the product ID, name, price (with two decimal places), and inventory count.
     */
     std::string toString(int productNumber) const {
-        std::ostringstream oss;
-        oss << "Product " << productNumber << "\n"  // Add the product number
-            << "\tID: " << productID << "\n"
-            << "\tName: " << name << "\n"
-            << "\tPrice: $" << std::fixed << std::setprecision(2) << price << "\n"
-            << "\tInventory Count: " << inventory << "\n";
-        return oss.str();
+        return formatProductRecord(toRecord(productNumber));
     }
 
     /*
     Method Name: saveProductToFile
-    Purpose: Appends a product's information to the "products.txt" file.
+    Purpose: Appends a product's information to the "products.txt" file and the in-memory product catalog.
     Meaning of Parameters:
     - const Product& product: The product object containing the details to be saved.
     Description of Return Values:
     - This method does not return a value. It writes the product's data to the file or outputs an error message if the file cannot be opened.
     */
     static void saveProductToFile(const Product& product) {
-        std::ofstream outfile("products.txt", std::ios::app);
-
-        if (outfile.is_open()) {
-            int productNumber = Product::readProductCount(); // Get current product count
-            outfile << product.toString(productNumber);      // Pass productNumber to toString
-            outfile.close();
-
+        int productNumber = Product::readProductCount(); // Get current product count
+        if (productCatalog.append(product.toRecord(productNumber))) {
             std::cout << "Product saved successfully.\n";
         } else {
-            std::cerr << "Error: Could not open products.txt file.\n";
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
         }
     }
 
@@ -118,37 +127,34 @@ public:
     Meaning of Parameters:
     - int count: The new product count to be written to the file.
     Description of Return Values:
-    - This method does not return a value. It writes the updated count to the file if it is successfully opened. Outputs an error message if the file cannot be written.
+    - This method does not return a value. It replaces the file with the updated count. Outputs an error message and keeps the old count if the file cannot be written.
     */
     static void updateProductCount(int count) {
-        std::ofstream outfile("product_count.txt");
-        if (outfile.is_open()) {
-            outfile << count;
-            outfile.close();
-        } else {
-            std::cerr << "Error: Unable to write to product_count.txt\n";
-        }
+        replaceFile("product_count.txt", std::to_string(count));
     }
 };
 
 /*
 Function Name: generateProductID
-Purpose: Generates a unique product ID by appending "Prod" to a random 5-digit number.
+Purpose: Generates a unique product ID from the next 5-digit number of the product ID generator.
 Meaning of Parameters:
   - None.
 Description of Return Values:
-  - Returns a string containing the newly generated unique product ID.
-  - Ensures the ID does not already exist in the `productIDs` set.
+  - Returns the newly generated unique product ID.
+  - Returns ProductId() (0) if the generator cannot issue one, e.g. all 90000 have been used; it outputs the error.
 */
-std::string generateProductID() {
-    std::srand(std::time(nullptr));
-    std::string newID;
-    // Generates a unique product ID in the format "ProdXXXXX" (with a random 5-digit number) and ensures uniqueness by checking against existing IDs.
+ProductId generateProductID() {
+    std::uint64_t number = 0;
+    // The generator never repeats itself; the do-while loop only skips IDs taken by reward items or picked at random before it existed
     do {
-        newID = "Prod" + std::to_string(10000 + std::rand() % 90000);
-    } while (productIDs.find(newID) != productIDs.end());
-    productIDs.insert(newID);
-    return newID;
+        if (!productIdGenerator.nextNumber(number)) {
+            return ProductId();
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    } while (productIDs.contains(static_cast<ProductId>(number)));
+    productIDs.insert(static_cast<ProductId>(number));
+    return static_cast<ProductId>(number);
 }
 
 //Product validation start
@@ -194,7 +200,7 @@ bool validateProductName(const std::string& name) {
 
 /*
 Function Name: validateProductPrice
-Purpose: Validates that the product price is a positive number with at most two decimal places.
+Purpose: Validates that the product price is a positive number with at most two decimal places, which parseMoney can hold exactly in cents.
 Meaning of Parameters:
   - const std::string& priceStr: The product price to validate, provided as a string.
 Description of Return Values:
@@ -224,15 +230,6 @@ bool validateProductPrice(const std::string& priceStr) {
         }
     }
 
-    // Convert the valid numeric string to double and check if it's positive
-    double price = std::stod(priceStr);
-    if (price <= 0.0) {
-        std::cerr << "Invalid product price. Price must be a positive number.\n";
-        return false;
-    } else {
-        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-    }
-
     // Check for two decimal places
     if (decimalPointFound) {
         std::size_t decimalPos = priceStr.find('.');
@@ -246,6 +243,15 @@ bool validateProductPrice(const std::string& priceStr) {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
+    // Convert the valid numeric string to cents and check if it's positive; an empty string or a lone '.' fails to convert
+    Money price;
+    if (!parseMoney(priceStr, price) || price <= Money()) {
+        std::cerr << "Invalid product price. Price must be a positive number.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
     return true;
 }
 
@@ -296,10 +302,8 @@ void addProduct() {
 
     priceStr = priceCreation();
 
-    double price = std::stod(priceStr); // Convert to double after validation
-
-    std::ostringstream formattedPrice;
-    formattedPrice << std::fixed << std::setprecision(2);
+    Money price;
+    parseMoney(priceStr, price); // Convert to cents after validation
 
     inventoryStr = inventoryCreation();
 
@@ -309,6 +313,12 @@ void addProduct() {
     
     int productNumber = Product::readProductCount();
     Product product(name, price, inventory);
+    if (product.productID == ProductId()) {
+        std::cerr << "Product not added.\n";
+        return;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
     Product::saveProductToFile(product);
 
     int newCount = productNumber + 1; 
@@ -385,168 +395,164 @@ std::string inventoryCreation()
 Function Name: removeProduct
 Purpose: Removes a product from the "products.txt" file based on the provided product ID and updates the product count.
 Meaning of Parameters:
-  - const std::string& productID: The ID of the product to be removed from the file.
+  - const std::string& productID: The ID of the product to be removed from the file, as typed ("Prod#####").
 Description of Return Values:
-  - This function does not return a value. It updates the "products.txt" file by removing the specified product and rewrites the file, or outputs error messages if issues occur.
+  - This function does not return a value. It records the removal in "products.removed.txt" (the product file is compacted later), or outputs error messages if issues occur.
 */
 void removeProduct(const std::string& productID) {
-    std::ifstream inFile("products.txt");
-    if (!inFile) {
-        std::cerr << "Error opening file for reading.\n";
+    ProductId id{};
+    if (!parseProductId(productID, id) || productCatalog.find(id) == nullptr) {
+        std::cout << "Product ID not found.\n";
         return;
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    std::vector<std::string> fileContents;
-    std::string line;
-    bool accountFound = false;
-    bool skip = false;
+    // Hide the record and log its removal; the file is only rewritten once enough records are removed
+    if (!productCatalog.remove(id)) {
+        std::cerr << "Error opening file for writing.\n";
+        return;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
 
-    // Read each line and decide whether to keep or skip it
-    while (getline(inFile, line)) {
-        if (!skip && line.find("ID: " + productID) != std::string::npos) {
-            // Start skipping lines for the account to remove
-            accountFound = true;
-            skip = true;
+    deincrement_count("product_count.txt");
+    std::cout << "Product removed successfully.\n";
+}
+
+/*
+Function Name: displayCatalogProducts
+Purpose: Displays every product held in the in-memory product catalog and collects their IDs.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns an `std::unordered_set<ProductId>` containing the product IDs in the catalog.
+  - Outputs the product details to the console and provides a message if no products are available.
+*/
+std::unordered_set<ProductId> displayCatalogProducts() {
+    productsTxtChecker();
+
+    std::unordered_set<ProductId> productIDs;
+    const std::vector<ProductRecord>& products = productCatalog.all();
+    productIDs.reserve(products.size());
+
+    std::cout << "Available Products:\n";
+    // The for loop prints each live catalog entry in the same layout as the product file, numbering them in display order.
+    for (std::size_t i = 0; i < products.size(); ++i) {
+        if (products[i].deleted) {
+            continue;
         } else {
             ; // Null Statement: to satisify requirement that every if block has a corresponding else.
         }
-        if (skip) {
-            // Keep skipping until we reach a new customer or end of account data
-            if (line.empty() || line.find("Product") != std::string::npos) {
-                 skip = false;  // Stop skipping at the end of the account
-            } else {
-                ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-            }
-        } else {
-            fileContents.push_back(line); // Add the line if not skipping
-        }
-    }
-    inFile.close();
 
-    if (!accountFound) {
-        std::cout << "Product ID not found.\n";
-        return;
-    } else {
-        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        std::string details = formatProductRecord(products[i]);
+        std::cout << "Product " << (productIDs.size() + 1) << "\n";
+        std::cout << details.substr(details.find('\n') + 1);
+        productIDs.insert(products[i].productID);
     }
 
-    // Rewrite the file with remaining accounts
-    std::ofstream outFile("products.txt", std::ios::trunc);
-    if (!outFile) {
-        std::cerr << "Error opening file for writing.\n";
-        return;
+    if (productIDs.empty()) {
+        std::cerr << "No products available in products.txt. Returning to main menu.\n";
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    // The for loop iterates through the lines stored in the vector `fileContents` and writes each line back to the "products.txt" file to 
-    // reconstruct the file without the removed product.
-    for (std::vector<std::string>::const_iterator it = fileContents.begin(); it != fileContents.end(); ++it) {
-        const std::string& contentLine = *it;
-        outFile << contentLine << "\n";
+    return productIDs;
+}
+
+/*
+Function Name: displayRewardProducts
+Purpose: Displays the cheapest rewards held in the in-memory rewards catalog and collects their IDs.
+Meaning of Parameters:
+  - std::size_t count: How many rewards to list, starting from the lowest point value (see RewardsCatalog::affordableCount).
+Description of Return Values:
+  - Returns an `std::unordered_set<ProductId>` containing the product IDs of the listed rewards.
+  - Outputs the reward details to the console and provides a message if no rewards are listed.
+*/
+std::unordered_set<ProductId> displayRewardProducts(std::size_t count) {
+    std::unordered_set<ProductId> productIDs;
+    const std::vector<RewardRecord>& rewards = rewardsCatalog.all();
+    productIDs.reserve(count);
+
+    // The for loop prints each listed reward in the same layout as the rewards file.
+    for (std::size_t i = 0; i < count && i < rewards.size(); ++i) {
+        std::cout << formatRewardRecord(rewards[i]);
+        productIDs.insert(rewards[i].productID);
     }
 
+    if (productIDs.empty()) {
+        std::cerr << "No rewards available in rewardsList.txt.\n";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
 
-    outFile.close();
-    deincrement_count("product_count.txt");
-    std::cout << "Product removed successfully.\n";
+    return productIDs;
 }
 
 /*
 Function Name: loadAndDisplayProducts
-Purpose: Displays products from a file and loads their IDs into a set for further processing.
+Purpose: Displays the available products or rewards and loads their IDs into a set for further processing.
 Meaning of Parameters:
-  - int menuFlag: Determines the file to read from. If `menuFlag` is 5, the function reads from "products.txt"; otherwise, it reads from "rewardsList.txt".
+  - int menuFlag: Determines the source. If `menuFlag` is 5, the function lists the in-memory product catalog; otherwise, it lists the in-memory rewards catalog.
 Description of Return Values:
-  - Returns an `std::unordered_set<std::string>` containing the product IDs found in the file.
+  - Returns an `std::unordered_set<ProductId>` containing the product IDs that were listed.
   - Outputs the product details to the console and provides a message if no products are available.
 */
-std::unordered_set<std::string> loadAndDisplayProducts(int menuFlag) {
-    std::unordered_set<std::string> productIDs;
-    std::ifstream infile;
-    std::string message;
-
-    if(menuFlag == 5) {
-        infile.open("products.txt");
-        productsTxtChecker();
-        message = "Available Products:\n";
-    }
-    else {
-        infile.open("rewardsList.txt");
-    }
-
-    std::string line;
-    bool productFound = false;
-    int productCount = 0;
-
-    std::cout << message;
-    // The while loop reads each line from either "products.txt" or "rewardsList.txt," identifies product-related details, displays them, 
-    // and collects product IDs into an unordered set.
-    while (std::getline(infile, line)) {
-        if (line.find("Product") != std::string::npos) {
-            ++productCount;
-            std::cout << "Product " << productCount << "\n";
-        } else if (line.find("ID:") != std::string::npos) {
-            std::string productID = line.substr(line.find(":") + 2);
-            productIDs.insert(productID);
-            productFound = true;
-            std::cout << "\tID: " << productID << "\n";
-        } else {
-            std::cout << "  " << line << "\n";
-        }
+std::unordered_set<ProductId> loadAndDisplayProducts(int menuFlag) {
+    if (menuFlag == 5) {
+        return displayCatalogProducts();
+    } else {
+        return displayRewardProducts(rewardsCatalog.size());
     }
+}
 
-    infile.close();
+/*
+Function Name: validateCatalogProductID
+Purpose: Validates if a given product ID exists in the in-memory product catalog.
+Meaning of Parameters:
+  - const std::string& productsID: The 5 digit product number to validate, provided as a string.
+Description of Return Values:
+  - Returns `true` if the product ID is in the catalog.
+  - Returns `false` if the product ID is not in the catalog.
+*/
+bool validateCatalogProductID(const std::string& productsID) {
+    productsTxtChecker(); // Check if products.txt exists
 
-    if (!productFound) {
-        std::cerr << "No products available in products.txt. Returning to main menu.\n";
+    ProductId id{};
+    if (parseProductId(trim(productsID), id) && productCatalog.find(id) != nullptr) {
+        std::cout << "\nProduct ID '" << productsID << "' found.\n"; // Debug message
+        return true;
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    return productIDs;
+    std::cerr << "\nProduct ID '" << productsID << "' not found.\n"; // Debug message
+    return false;
 }
 
 /*
 Function Name: validateProductsID
-Purpose: Validates if a given product ID exists in the file of available products or rewards.
+Purpose: Validates if a given product ID exists among the available products or rewards.
 Meaning of Parameters:
   - const std::string& productsID: The product ID to validate, provided as a string.
-  - int menuFlag: Determines the file to validate against. If `menuFlag` is 5, the function checks "products.txt"; otherwise, it checks "rewardsList.txt".
+  - int menuFlag: Determines the source to validate against. If `menuFlag` is 5, the function checks the in-memory product catalog; otherwise, it checks the in-memory rewards catalog.
 Description of Return Values:
-  - Returns `true` if the product ID is found in the specified file.
-  - Returns `false` if the product ID is not found or the file does not exist.
+  - Returns `true` if the product ID is found in the specified catalog.
+  - Returns `false` if the product ID is not found.
 */
 bool validateProductsID(const std::string& productsID, int menuFlag) {
-    std::ifstream infile;
-    if(menuFlag == 5) {
-        infile.open("products.txt");
-        productsTxtChecker(); // Check if products.txt exists
-    }
-    else {
-        infile.open("rewardsList.txt");
+    if (menuFlag == 5) {
+        return validateCatalogProductID(productsID);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
-    std::string line;
-    std::string fullProductID = "ID: Prod" + productsID;
-
-    // Trim any extra spaces from the fullProductID
-    fullProductID = trim(fullProductID);
 
-    // The while loop reads each line from the specified file, trims it, and checks if it matches the given full product ID; if found, 
-    // it returns true, otherwise continues searching.
-    while (std::getline(infile, line)) {
-        // Trim each line before checking
-        line = trim(line);
-
-        // Check if the line matches exactly with fullProductID
-        if (line == fullProductID) {
-            std::cout << "\nProduct ID '" << productsID << "' found.\n"; // Debug message
-            return true; // Exact Product ID found
-        } else {
-            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-        }
+    ProductId id{};
+    if (parseProductId(trim(productsID), id) && rewardsCatalog.find(id) != nullptr) {
+        std::cout << "\nProduct ID '" << productsID << "' found.\n"; // Debug message
+        return true;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
     std::cerr << "\nProduct ID '" << productsID << "' not found.\n"; // Debug message
@@ -555,14 +561,13 @@ bool validateProductsID(const std::string& productsID, int menuFlag) {
 
 /*
 Function Name: processProducts
-Purpose: Handles the product selection process for a transaction, including validating product IDs, adjusting inventory, and calculating the total amount.
+Purpose: Handles the product selection process for a transaction, validating each product ID and quantity and adding it to the cart. Inventory is only checked in memory here; the cart writes it once when the transaction is committed.
 Meaning of Parameters:
-  - std::vector<std::string>& productList: A reference to a vector where selected product IDs will be stored.
-  - double& totalAmount: A reference to a double where the total amount of the transaction will be accumulated.
+  - Cart& cart: The cart that collects the accepted line items.
 Description of Return Values:
-  - This function does not return a value. It updates the provided product list and total amount based on user input and validation.
+  - This function does not return a value. It fills the cart based on user input and validation.
 */
-void processProducts(std::vector<std::string> &productList, double &totalAmount) {
+void processProducts(Cart& cart) {
     int productCount;
     std::cout << "Enter the number of different products you wish to buy: ";
     std::cin >> productCount;
@@ -572,14 +577,13 @@ void processProducts(std::vector<std::string> &productList, double &totalAmount)
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    char choice;
     int count = 0;
     int quantity = 0;
     std::string productID;
-    double productPrice;
+    ProductId id{};
 
-    // The do-while loop prompts the user to enter product IDs and quantities, validates the product ID, updates the inventory, 
-    // calculates the total price, and repeats until the specified number of products has been
+    // The do-while loop prompts the user to enter product IDs and quantities, validates the product ID, adds it to the cart,
+    // shows the running total, and repeats until the specified number of products has been added
     do {
         std::cout << "\nEnter 5 digit Product ID #" << (++count) << ": ";
         std::cin >> productID;
@@ -588,17 +592,11 @@ void processProducts(std::vector<std::string> &productList, double &totalAmount)
             std::cout << "Enter the quantity of " << productID << " that you wish to purchase: ";
             std::cin >> quantity;
 
-            bool productFound = false;
-            std::vector<std::string> updatedInventory = readAndUpdateProductInventory(productID, quantity, productFound,5);
-
-            if (productFound && !updatedInventory.empty()) {
-                productList.push_back(productID);
+            parseProductId(productID, id);
+            if (cart.add(id, quantity)) {
                 std::cout << "Added " << quantity << " of Product ID " << productID << " to the list.\n";
-                processInventoryAdjustment(productID, quantity, 5);
                 productCount -= 1;
-                productPrice = getProductPrice(productID);
-                totalAmount = totalAmount + (productPrice * quantity);
-                std::cout << "The current total price is: $" << totalAmount << "\n";
+                std::cout << "The current total price is: $" << formatMoney(cart.total()) << "\n";
             } else {
                 std::cerr << "Transaction canceled for this item.\n";
             }
@@ -611,177 +609,134 @@ void processProducts(std::vector<std::string> &productList, double &totalAmount)
 
 /*
 Function Name: getProductPrice
-Purpose: Retrieves the price of a product based on its product ID from the "products.txt" file.
+Purpose: Retrieves the price of a product based on its product ID from the in-memory product catalog.
 Meaning of Parameters:
-  - const std::string& productID: The ID of the product for which the price is being retrieved.
+  - ProductId productID: The product whose price is being retrieved.
 Description of Return Values:
-  - Returns the price of the product as a double if found in the file.
-  - Returns -1.0 if the product ID or price is not found.
+  - Returns the price of the product if found in the catalog.
+  - Returns -$0.01 if the product ID is not found.
 */
-double getProductPrice(const std::string& productID) {
-    std::ifstream infile("products.txt");
-    std::string line;
-    std::string fullProductID = "ID: Prod" + productID;  // Full product ID format
-    double price = -1.0; // Default to -1.0 to indicate not found
-
-    // Trim any extra spaces from the fullProductID
-    fullProductID = trim(fullProductID);
-
-    bool productFound = false;
+Money getProductPrice(ProductId productID) {
+    const ProductRecord* record = productCatalog.find(productID);
+    if (record == nullptr) {
+        return Money::fromCents(-1); // -1 cent indicates the product was not found
+    } else {
+        return record->price;
+    }
+}
 
-    // The while loop reads each line from "products.txt," checks for the specified product ID, and retrieves the price from the 
-    // subsequent "Price: $" line if the product ID is found.
-    while (std::getline(infile, line)) {
-        line = trim(line);  // Trim whitespace from each line
+/*
+Function Name: updateCatalogInventory
+Purpose: Deducts a purchased quantity from a product's inventory in the in-memory product catalog.
+Meaning of Parameters:
+  - ProductId productID: The product whose inventory is being updated.
+  - int quantity: The quantity to deduct from the current inventory.
+  - bool& productFound: A reference variable set to whether the product exists in the catalog.
+Description of Return Values:
+  - Returns `true` if the product exists and had enough inventory; the catalog entry is updated in that case.
+  - Returns `false` and leaves the catalog unchanged if the product is missing or there is insufficient inventory.
+*/
+bool updateCatalogInventory(ProductId productID, int quantity, bool& productFound) {
+    ProductRecord* record = productCatalog.find(productID);
+    productFound = (record != nullptr);
 
-        // Check for the product ID in the current line
-        if (line == fullProductID) {
-            productFound = true;
-        } else {
-            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-        }
+    if (!productFound) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
 
-        // If the product ID was found, look for the price on the next relevant line
-        if (productFound && line.find("Price: $") != std::string::npos) {
-            // Extract the price value after "Price: $"
-            std::string priceStr = line.substr(line.find("$") + 1);
-            price = std::stod(priceStr); // Convert price to double
-            break;
-        } else {
-            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-        }
+    // The check and the deduction are one atomic step, so a concurrent purchase cannot take the same units
+    if (!record->inventory.take(quantity)) {
+        std::cerr << "Error: Not enough inventory for product ID " << idDigits(productID) << ".\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    return price;
+    return true;
 }
 
 /*
-Function Name: readAndUpdateProductInventory
-Purpose: Reads product inventory from a file, updates the inventory for a specified product ID, and returns the updated lines.
+Function Name: updateRewardInventory
+Purpose: Deducts a redeemed quantity from a reward's inventory in the in-memory rewards catalog.
 Meaning of Parameters:
-  - const std::string& productID: The ID of the product whose inventory is being updated.
+  - ProductId productID: The reward whose inventory is being updated.
   - int quantity: The quantity to deduct from the current inventory.
-  - bool& productFound: A reference variable to indicate whether the specified product ID was found.
-  - int menuFlag: Determines the file to process. If `menuFlag` is 5, the function reads from "products.txt"; otherwise, it reads from "rewardsList.txt".
+  - bool& productFound: A reference variable set to whether the reward exists in the catalog.
 Description of Return Values:
-  - Returns a `std::vector<std::string>` containing the updated lines of the file, including inventory adjustments if applicable.
-  - If there is insufficient inventory, the function outputs an error message and returns the lines without changes.
+  - Returns `true` if the reward exists and had enough inventory; the catalog entry is updated in that case.
+  - Returns `false` and leaves the catalog unchanged if the reward is missing or there is insufficient inventory.
 */
-std::vector<std::string> readAndUpdateProductInventory(const std::string& productID, int quantity, bool& productFound, int menuFlag) {
-    std::ifstream infile;
-    if(menuFlag == 5) {
-        infile.open("products.txt");
-        productsTxtChecker();
-    }
-    else {
-        infile.open("rewardsList.txt");
-    }
-    std::vector<std::string> lines;
-    productFound = false;
-
-    std::string line;
-    // The while loop reads each line from the file, identifies the specified product ID, validates and updates its inventory if sufficient stock is available, 
-    // and stores all lines in a vector for potential file updates.
-    while (getline(infile, line)) {
-        if (line.find("ID: Prod" + productID) != std::string::npos) {
-            lines.push_back(line); // Product ID line
-            getline(infile, line); // Name line
-            lines.push_back(line);
-            getline(infile, line); // Price line
-            lines.push_back(line);
-
-            // Process the Inventory Count line
-            getline(infile, line);
-            int currentInventory = 0;
-
-            // Extract current inventory from the line
-            size_t pos = line.find(":");
-            if (pos != std::string::npos) {
-                std::string currentInventoryStr = line.substr(pos + 1);
-                currentInventory = std::stoi(currentInventoryStr);
-            } else {
-                ; // Null Statement: to satisify requirement that every if block has a corresponding else.
-            }
-
-            // Check if there's enough inventory
-            if (currentInventory >= quantity) {
-                int updatedInventory = currentInventory - quantity;
+bool updateRewardInventory(ProductId productID, int quantity, bool& productFound) {
+    RewardRecord* record = rewardsCatalog.find(productID);
+    productFound = (record != nullptr);
 
-                // Update the line with the new inventory count, including the tab
-                std::stringstream ss;
-                ss << "\tInventory Count: " << updatedInventory;
-                lines.push_back(ss.str());
-            } else {
-                std::cerr << "Error: Not enough inventory for product ID " << productID << ".\n";
-                return lines;
-                break;
-
-            }
+    if (!productFound) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
 
-            productFound = true;
-        } else {
-            lines.push_back(line);
-        }
+    // The check and the deduction are one atomic step, so a concurrent purchase cannot take the same units
+    if (!record->inventory.take(quantity)) {
+        std::cerr << "Error: Not enough inventory for product ID " << idDigits(productID) << ".\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
 
-    infile.close();
-    return lines;
+    return true;
 }
 
 /*
 Function Name: writeUpdatedProductInventory
-Purpose: Writes updated product inventory data back to the appropriate file.
+Purpose: Writes updated product or reward inventory back to the appropriate file, through the persistence queue.
 Meaning of Parameters:
-  - const std::vector<std::string>& lines: A vector containing the updated lines to be written to the file.
-  - int menuFlag: Determines the file to write to. If `menuFlag` is 5, the function writes to "products.txt"; otherwise, it writes to "rewardsList.txt".
+  - int menuFlag: Determines the file to write to. If `menuFlag` is 5, the function saves the product catalog to "products.txt"; otherwise, it saves the rewards catalog to "rewardsList.txt".
 Description of Return Values:
-  - This function does not return a value. It writes the updated lines to the specified file.
+  - This function does not return a value. It writes the updated inventory to the specified file, or queues the write under a write-behind policy.
 */
-void writeUpdatedProductInventory(const std::vector<std::string>& lines, int menuFlag) {
-    std::ofstream outfile;
-    if(menuFlag == 5) {
-        outfile.open("products.txt");
-        productsTxtChecker();
-    }
-    else {
-        outfile.open("rewardsList.txt");
-    }
-
-    // The for loop iterates through the vector of lines and writes each line back to the appropriate file, ensuring the product inventory is updated.
-    for (size_t i = 0; i < lines.size(); ++i) {
-        outfile << lines[i] << "\n";
+void writeUpdatedProductInventory(int menuFlag) {
+    if (menuFlag == 5) {
+        persistenceQueue.saveProducts();
+    } else {
+        persistenceQueue.saveRewards();
     }
-
-    outfile.close();
 }
 
 /*
 Function Name: processInventoryAdjustment
-Purpose: Adjusts the inventory of a specified product by updating the product data in the appropriate file.
+Purpose: Adjusts the inventory of a specified product or reward in memory and writes the change to the appropriate file.
 Meaning of Parameters:
-  - const std::string& productID: The ID of the product whose inventory needs to be adjusted.
+  - ProductId productID: The product whose inventory needs to be adjusted.
   - int quantity: The quantity to deduct from the product's inventory.
-  - int menuFlag: Determines the file to process. If `menuFlag` is 5, the function adjusts inventory in "products.txt"; otherwise, it adjusts inventory in "rewardsList.txt".
+  - int menuFlag: Determines the catalog to process. If `menuFlag` is 5, the function adjusts inventory in the product catalog and "products.txt"; otherwise, it adjusts inventory in the rewards catalog and "rewardsList.txt".
 Description of Return Values:
-  - This function does not return a value. It updates the inventory if the product is found, or outputs an error message if the product is not found.
+  - Returns `true` if the product was found with enough inventory and the adjustment was written.
+  - Returns `false` and outputs an error message if the product is not found or has insufficient inventory.
 */
-void processInventoryAdjustment(const std::string& productID, int quantity, int menuFlag) {
+bool processInventoryAdjustment(ProductId productID, int quantity, int menuFlag) {
     bool productFound = false;
-    std::vector<std::string> updatedData;
-    if(menuFlag == 5) {
-        updatedData = readAndUpdateProductInventory(productID, quantity, productFound, menuFlag);
+    bool adjusted = false;
+    if (menuFlag == 5) {
+        adjusted = updateCatalogInventory(productID, quantity, productFound);
     }
     else {
-        updatedData = readAndUpdateProductInventory(productID, quantity, productFound, menuFlag);
+        adjusted = updateRewardInventory(productID, quantity, productFound);
     }
 
-    if (productFound) {
-        writeUpdatedProductInventory(updatedData, menuFlag);
-        std::cout << "\nInventory updated successfully for Product ID: " << productID << "\n";
+    if (adjusted) {
+        writeUpdatedProductInventory(menuFlag);
+        std::cout << "\nInventory updated successfully for Product ID: " << idDigits(productID) << "\n";
     } 
+    else if (!productFound) {
+        std::cerr << "Product with ID " << idDigits(productID) << " not found.\n";
+    }
     else {
-        std::cerr << "Product with ID " << productID << " not found.\n";
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
+    return adjusted;
 }
 /*
 ****************************************************************************
@@ -2,20 +2,28 @@
 #define PRODUCTS_H
 
 /* Declarations for product-related classes and functions */
+class Cart;
+class Money;
+enum class ProductId : std::uint64_t;
+
 void productsTxtChecker();
 void addProduct();
 void removeProduct(const std::string& productID);
 bool validateProductName(const std::string& name);
 bool validateProductPrice(const std::string& priceStr);
 bool validateInventoryCount(const std::string& countStr);
-std::string generateProductID();
-std::unordered_set<std::string> loadAndDisplayProducts(int menuFlag);
+ProductId generateProductID();
+std::unordered_set<ProductId> displayCatalogProducts();
+std::unordered_set<ProductId> displayRewardProducts(std::size_t count);
+std::unordered_set<ProductId> loadAndDisplayProducts(int menuFlag);
+bool validateCatalogProductID(const std::string& productsID);
 bool validateProductsID(const std::string& productsID, int menuFlag);
-void processProducts(std::vector<std::string> &productList, double &totalAmount);
-double getProductPrice(const std::string& productID);
-std::vector<std::string> readAndUpdateProductInventory(const std::string& productID, int quantity, bool& productFound, int menuFlag);
-void writeUpdatedProductInventory(const std::vector<std::string>& lines, int menuFlag);
-void processInventoryAdjustment(const std::string& productID, int quantity, int menuFlag);
+void processProducts(Cart& cart);
+Money getProductPrice(ProductId productID);
+bool updateCatalogInventory(ProductId productID, int quantity, bool& productFound);
+bool updateRewardInventory(ProductId productID, int quantity, bool& productFound);
+void writeUpdatedProductInventory(int menuFlag);
+bool processInventoryAdjustment(ProductId productID, int quantity, int menuFlag);
 std::string productNameCreation();
 std::string priceCreation();
 std::string inventoryCreation();
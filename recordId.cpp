@@ -0,0 +1,179 @@
+#include <charconv>
+#include "recordId.h"
+
+/*
+****************************************************************************
+***************************** RECORD ID START ******************************
+****************************************************************************
+*/
+
+static const char customerIdPrefix[] = "CustID";
+static const char productIdPrefix[] = "Prod";
+static const char transactionIdPrefix[] = "Transaction";
+
+/*
+Function Name: parseIdNumber
+Purpose: Reads the number of an ID, with or without its prefix. The number must have exactly the width IDs of that kind are issued with, so parsing and formatting always give back the same text.
+Meaning of Parameters:
+  - std::string_view text: The ID, e.g. "Prod12345" or "12345".
+  - std::string_view prefix: The prefix of this kind of ID, e.g. "Prod".
+  - std::size_t width: How many digits the number has.
+  - std::uint64_t& number: Receives the number.
+Description of Return Values:
+  - Returns `true` if the text is a valid ID of this kind.
+  - Returns `false` otherwise; `number` is unchanged.
+*/
+static bool parseIdNumber(std::string_view text, std::string_view prefix, std::size_t width, std::uint64_t& number) {
+    if (text.substr(0, prefix.size()) == prefix) {
+        text.remove_prefix(prefix.size());
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::uint64_t value = 0;
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.size() != width || text[0] == '0' || result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        return false;
+    } else {
+        number = value;
+        return true;
+    }
+}
+
+/*
+Function Name: parseCustomerId
+Purpose: Parses a customer ID as written in the data files ("CustID1234567890") or typed at the menu ("1234567890").
+Meaning of Parameters:
+  - std::string_view text: The ID.
+  - CustomerId& id: Receives the ID.
+Description of Return Values:
+  - Returns `true` if the text is a 10 digit customer ID, with or without the prefix.
+  - Returns `false` otherwise; `id` is unchanged.
+*/
+bool parseCustomerId(std::string_view text, CustomerId& id) {
+    std::uint64_t number = 0;
+    if (!parseIdNumber(text, customerIdPrefix, 10, number)) {
+        return false;
+    } else {
+        id = static_cast<CustomerId>(number);
+        return true;
+    }
+}
+
+/*
+Function Name: parseProductId
+Purpose: Parses a product or reward item ID as written in the data files ("Prod12345") or typed at the menu ("12345").
+Meaning of Parameters:
+  - std::string_view text: The ID.
+  - ProductId& id: Receives the ID.
+Description of Return Values:
+  - Returns `true` if the text is a 5 digit product ID, with or without the prefix.
+  - Returns `false` otherwise; `id` is unchanged.
+*/
+bool parseProductId(std::string_view text, ProductId& id) {
+    std::uint64_t number = 0;
+    if (!parseIdNumber(text, productIdPrefix, 5, number)) {
+        return false;
+    } else {
+        id = static_cast<ProductId>(number);
+        return true;
+    }
+}
+
+/*
+Function Name: parseTransactionId
+Purpose: Parses a transaction ID as written in "transactions.txt" ("Transaction1234567").
+Meaning of Parameters:
+  - std::string_view text: The ID.
+  - TransactionId& id: Receives the ID.
+Description of Return Values:
+  - Returns `true` if the text is a 7 digit transaction ID, with or without the prefix.
+  - Returns `false` otherwise; `id` is unchanged.
+*/
+bool parseTransactionId(std::string_view text, TransactionId& id) {
+    std::uint64_t number = 0;
+    if (!parseIdNumber(text, transactionIdPrefix, 7, number)) {
+        return false;
+    } else {
+        id = static_cast<TransactionId>(number);
+        return true;
+    }
+}
+
+/*
+Function Name: formatId (CustomerId)
+Purpose: Formats a customer ID the way the data files store it.
+Meaning of Parameters:
+  - CustomerId id: The ID.
+Description of Return Values:
+  - Returns the ID with its prefix, e.g. "CustID1234567890".
+*/
+std::string formatId(CustomerId id) {
+    return customerIdPrefix + idDigits(id);
+}
+
+/*
+Function Name: formatId (ProductId)
+Purpose: Formats a product or reward item ID the way the data files store it.
+Meaning of Parameters:
+  - ProductId id: The ID.
+Description of Return Values:
+  - Returns the ID with its prefix, e.g. "Prod12345".
+*/
+std::string formatId(ProductId id) {
+    return productIdPrefix + idDigits(id);
+}
+
+/*
+Function Name: formatId (TransactionId)
+Purpose: Formats a transaction ID the way "transactions.txt" stores it.
+Meaning of Parameters:
+  - TransactionId id: The ID.
+Description of Return Values:
+  - Returns the ID with its prefix, e.g. "Transaction1234567".
+*/
+std::string formatId(TransactionId id) {
+    return transactionIdPrefix + idDigits(id);
+}
+
+/*
+Function Name: idDigits (CustomerId)
+Purpose: Formats just the number of a customer ID, as the menu asks for it and the transaction records store it.
+Meaning of Parameters:
+  - CustomerId id: The ID.
+Description of Return Values:
+  - Returns the 10 digit number, e.g. "1234567890".
+*/
+std::string idDigits(CustomerId id) {
+    return std::to_string(static_cast<std::uint64_t>(id));
+}
+
+/*
+Function Name: idDigits (ProductId)
+Purpose: Formats just the number of a product ID, as the menu asks for it and the transaction records store it.
+Meaning of Parameters:
+  - ProductId id: The ID.
+Description of Return Values:
+  - Returns the 5 digit number, e.g. "12345".
+*/
+std::string idDigits(ProductId id) {
+    return std::to_string(static_cast<std::uint64_t>(id));
+}
+
+/*
+Function Name: idDigits (TransactionId)
+Purpose: Formats just the number of a transaction ID.
+Meaning of Parameters:
+  - TransactionId id: The ID.
+Description of Return Values:
+  - Returns the 7 digit number, e.g. "1234567".
+*/
+std::string idDigits(TransactionId id) {
+    return std::to_string(static_cast<std::uint64_t>(id));
+}
+
+/*
+****************************************************************************
+****************************** RECORD ID END *******************************
+****************************************************************************
+*/
@@ -0,0 +1,27 @@
+#ifndef RECORDID_H
+#define RECORDID_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/* Declarations for the integer customer, product and transaction IDs used everywhere inside the program */
+
+// Each kind of ID is its own enum type over the ID's number, so one kind cannot be passed where another is expected.
+// They compare and hash as plain integers; the "CustID1234567890" text form is only parsed and formatted where the
+// data files and the console are read or written. 0 is never issued and stands for "no ID".
+enum class CustomerId : std::uint64_t {};
+enum class ProductId : std::uint64_t {};
+enum class TransactionId : std::uint64_t {};
+
+bool parseCustomerId(std::string_view text, CustomerId& id);
+bool parseProductId(std::string_view text, ProductId& id);
+bool parseTransactionId(std::string_view text, TransactionId& id);
+std::string formatId(CustomerId id);
+std::string formatId(ProductId id);
+std::string formatId(TransactionId id);
+std::string idDigits(CustomerId id);
+std::string idDigits(ProductId id);
+std::string idDigits(TransactionId id);
+
+#endif // RECORDID_H
@@ -0,0 +1,453 @@
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "durableFile.h"
+#include "mappedFile.h"
+#include "recordIndex.h"
+#include "recordParser.h"
+#include "utility.h"
+
+/*
+****************************************************************************
+************************** RECORD INDEX START ******************************
+****************************************************************************
+*/
+
+static const char recordIndexMagic[4] = { 'R', 'I', 'D', 'X' };
+static const std::uint32_t recordIndexVersion = 2;
+// How many appended entries may sit unsorted after the sorted ones before appendRecordIndex sorts them in
+static const std::uint64_t maxUnsortedEntries = 256;
+
+/*
+Function Name: statDataFile
+Purpose: Reads the size and modification time of a data file, which together identify the version of the file an index describes.
+Meaning of Parameters:
+  - const std::string& dataFileName: The data file, e.g. "customers.txt".
+  - RecordIndexHeader& header: Receives the size and modification time; the magic and version are filled in as well.
+Description of Return Values:
+  - Returns `true` if the file exists.
+  - Returns `false` if it could not be examined.
+*/
+static bool statDataFile(const std::string& dataFileName, RecordIndexHeader& header) {
+    struct stat info;
+    if (::stat(dataFileName.c_str(), &info) != 0) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::memcpy(header.magic, recordIndexMagic, sizeof(header.magic));
+    header.version = recordIndexVersion;
+    header.dataSize = static_cast<std::uint64_t>(info.st_size);
+    header.dataModified = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    return true;
+}
+
+/*
+Function Name: readIndexHeader
+Purpose: Reads and validates the header of an open index file.
+Meaning of Parameters:
+  - int fd: The open index file.
+  - RecordIndexHeader& header: Receives the header.
+Description of Return Values:
+  - Returns `true` if the header was read and is an index header of this version.
+  - Returns `false` otherwise.
+*/
+static bool readIndexHeader(int fd, RecordIndexHeader& header) {
+    if (::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        return false;
+    } else {
+        return std::memcmp(header.magic, recordIndexMagic, sizeof(header.magic)) == 0 && header.version == recordIndexVersion;
+    }
+}
+
+/*
+Function Name: toIndexEntry
+Purpose: Converts a record location into its fixed-width index entry.
+Meaning of Parameters:
+  - const RecordLocation& location: The location to convert.
+  - RecordIndexEntry& entry: Receives the entry.
+Description of Return Values:
+  - Returns `true` if the ID fits in the entry.
+  - Returns `false` if the ID is too long.
+*/
+static bool toIndexEntry(const RecordLocation& location, RecordIndexEntry& entry) {
+    std::memset(&entry, 0, sizeof(entry));
+    if (location.id.size() > sizeof(entry.id)) {
+        return false;
+    } else {
+        std::memcpy(entry.id, location.id.data(), location.id.size());
+    }
+
+    entry.offset = location.offset;
+    entry.length = location.length;
+    return true;
+}
+
+/*
+Function Name: entryIdLess
+Purpose: Orders index entries by their padded ID bytes, the order the sorted part of an index is kept in.
+Meaning of Parameters:
+  - const RecordIndexEntry& left: The first entry.
+  - const RecordIndexEntry& right: The second entry.
+Description of Return Values:
+  - Returns `true` if left's ID sorts before right's.
+  - Returns `false` otherwise.
+*/
+static bool entryIdLess(const RecordIndexEntry& left, const RecordIndexEntry& right) {
+    return std::memcmp(left.id, right.id, sizeof(left.id)) < 0;
+}
+
+/*
+Function Name: countIndexEntries
+Purpose: Works out how many whole entries an open index file holds from its size.
+Meaning of Parameters:
+  - int fd: The open index file.
+Description of Return Values:
+  - Returns the number of entries after the header, or 0 if the file could not be examined.
+*/
+static std::uint64_t countIndexEntries(int fd) {
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < sizeof(RecordIndexHeader)) {
+        return 0;
+    } else {
+        return (static_cast<std::uint64_t>(info.st_size) - sizeof(RecordIndexHeader)) / sizeof(RecordIndexEntry);
+    }
+}
+
+/*
+Function Name: readIndexEntry
+Purpose: Reads one entry of an open index file by its position.
+Meaning of Parameters:
+  - int fd: The open index file.
+  - std::uint64_t position: The entry's position, counting from 0 after the header.
+  - RecordIndexEntry& entry: Receives the entry.
+Description of Return Values:
+  - Returns `true` if the whole entry was read.
+  - Returns `false` otherwise.
+*/
+static bool readIndexEntry(int fd, std::uint64_t position, RecordIndexEntry& entry) {
+    off_t offset = static_cast<off_t>(sizeof(RecordIndexHeader) + position * sizeof(RecordIndexEntry));
+    return ::pread(fd, &entry, sizeof(entry), offset) == static_cast<ssize_t>(sizeof(entry));
+}
+
+/*
+Function Name: searchIndexEntries
+Purpose: Looks an ID up in an open index file: a binary search over the sorted entries, then a check of the few entries appended since they were sorted. Reads O(log n) entries rather than the whole index.
+Meaning of Parameters:
+  - int fd: The open index file.
+  - const RecordIndexHeader& header: Its header, which says how many entries are sorted.
+  - const RecordIndexEntry& wanted: An entry holding the padded ID to find.
+  - RecordIndexEntry& entry: Receives the matching entry.
+Description of Return Values:
+  - Returns `true` if the ID was found.
+  - Returns `false` if it is not in the index or the index could not be read.
+*/
+static bool searchIndexEntries(int fd, const RecordIndexHeader& header, const RecordIndexEntry& wanted, RecordIndexEntry& entry) {
+    std::uint64_t count = countIndexEntries(fd);
+    std::uint64_t sorted = std::min(header.sortedEntries, count);
+    std::uint64_t low = 0;
+    std::uint64_t high = sorted;
+    // The while loop halves the sorted range, reading one entry per step.
+    while (low < high) {
+        std::uint64_t middle = low + (high - low) / 2;
+        bool read = readIndexEntry(fd, middle, entry);
+        int order = read ? std::memcmp(entry.id, wanted.id, sizeof(entry.id)) : 0;
+        if (!read) {
+            return false;
+        } else if (order == 0) {
+            return true;
+        } else if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    for (std::uint64_t i = sorted; i < count; ++i) {
+        if (readIndexEntry(fd, i, entry) && std::memcmp(entry.id, wanted.id, sizeof(entry.id)) == 0) {
+            return true;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return false;
+}
+
+/*
+Function Name: writeIndexEntries
+Purpose: Sorts a complete set of entries by ID and replaces the index file with them through replaceFile.
+Meaning of Parameters:
+  - const std::string& indexFileName: The index file to replace.
+  - RecordIndexHeader& header: The header describing the data file; its sorted entry count is set to every entry.
+  - std::vector<RecordIndexEntry>& entries: The entries; sorted in place.
+Description of Return Values:
+  - Returns `true` if the index was written.
+  - Returns `false` and outputs an error message otherwise.
+*/
+static bool writeIndexEntries(const std::string& indexFileName, RecordIndexHeader& header, std::vector<RecordIndexEntry>& entries) {
+    std::sort(entries.begin(), entries.end(), entryIdLess);
+    header.sortedEntries = entries.size();
+
+    std::string contents;
+    contents.reserve(sizeof(header) + entries.size() * sizeof(RecordIndexEntry));
+    contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    contents.append(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(RecordIndexEntry));
+    return replaceFile(indexFileName, contents);
+}
+
+/*
+Function Name: sortAppendedEntries
+Purpose: Rewrites an index whose unsorted tail has grown too long, with one more entry added and every entry sorted, so lookups stay logarithmic.
+Meaning of Parameters:
+  - int fd: The open index file.
+  - const std::string& indexFileName: Its name.
+  - RecordIndexHeader& header: The header describing the data file with the new record in it.
+  - const RecordIndexEntry& added: The entry for the new record.
+Description of Return Values:
+  - Returns `true` if the index was rewritten.
+  - Returns `false` if it could not be read or written.
+*/
+static bool sortAppendedEntries(int fd, const std::string& indexFileName, RecordIndexHeader& header, const RecordIndexEntry& added) {
+    std::vector<RecordIndexEntry> entries(countIndexEntries(fd));
+    std::size_t bytes = entries.size() * sizeof(RecordIndexEntry);
+    bool read = ::pread(fd, entries.data(), bytes, sizeof(RecordIndexHeader)) == static_cast<ssize_t>(bytes);
+    entries.push_back(added);
+    return read && writeIndexEntries(indexFileName, header, entries);
+}
+
+/*
+Function Name: recordIndexFileName
+Purpose: Derives the index file name for a data file by replacing its extension with ".idx".
+Meaning of Parameters:
+  - const std::string& dataFileName: The data file, e.g. "customers.txt".
+Description of Return Values:
+  - Returns the index file name, e.g. "customers.idx".
+*/
+std::string recordIndexFileName(const std::string& dataFileName) {
+    return replaceFileExtension(dataFileName, ".idx");
+}
+
+/*
+Function Name: recordIndexIsFresh
+Purpose: Checks whether the index file still describes the data file, by comparing the size and modification time stored in its header.
+Meaning of Parameters:
+  - const std::string& dataFileName: The data file whose index is checked.
+Description of Return Values:
+  - Returns `true` if the index exists and matches the data file.
+  - Returns `false` if the index is missing, damaged or stale.
+*/
+bool recordIndexIsFresh(const std::string& dataFileName) {
+    RecordIndexHeader current;
+    RecordIndexHeader stored;
+    int fd = ::open(recordIndexFileName(dataFileName).c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    bool fresh = readIndexHeader(fd, stored) && statDataFile(dataFileName, current) &&
+                 stored.dataSize == current.dataSize && stored.dataModified == current.dataModified;
+    ::close(fd);
+    return fresh;
+}
+
+/*
+Function Name: writeRecordIndex
+Purpose: Writes a complete index, sorted by ID, for a data file that has just been written, replacing any older index through replaceFile so a crash never leaves a partly written index under the real name.
+Meaning of Parameters:
+  - const std::string& dataFileName: The data file the locations refer to.
+  - const std::vector<RecordLocation>& locations: The byte range of every record in the file.
+Description of Return Values:
+  - Returns `true` if the index was written.
+  - Returns `false` if it could not be; any old index is removed so it cannot be mistaken for a current one.
+*/
+bool writeRecordIndex(const std::string& dataFileName, const std::vector<RecordLocation>& locations) {
+    std::string indexFileName = recordIndexFileName(dataFileName);
+    RecordIndexHeader header;
+    std::vector<RecordIndexEntry> entries(locations.size());
+    bool written = statDataFile(dataFileName, header);
+    for (std::size_t i = 0; written && i < locations.size(); ++i) {
+        written = toIndexEntry(locations[i], entries[i]);
+    }
+
+    if (!written || !writeIndexEntries(indexFileName, header, entries)) {
+        std::remove(indexFileName.c_str());
+        return false;
+    } else {
+        return true;
+    }
+}
+
+/*
+Function Name: appendRecordIndex
+Purpose: Adds the entry for a record that was just appended to the end of the data file, so registering a customer or product does not rewrite the index. The entry joins the unsorted tail after the sorted entries; once the tail reaches maxUnsortedEntries the whole index is sorted again.
+Meaning of Parameters:
+  - const std::string& dataFileName: The data file the record was appended to.
+  - const std::string& id: The record's full ID.
+  - std::uint32_t length: The length in bytes of the appended record.
+Description of Return Values:
+  - Returns `true` if the entry was added and the index matches the data file again.
+  - Returns `false` if the index was missing or already stale; it is left for findRecordLocation to rebuild.
+*/
+bool appendRecordIndex(const std::string& dataFileName, const std::string& id, std::uint32_t length) {
+    RecordIndexHeader stored;
+    RecordIndexHeader current;
+    RecordIndexEntry entry;
+    RecordLocation location;
+    int fd = ::open(recordIndexFileName(dataFileName).c_str(), O_RDWR);
+    if (fd < 0) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    // The index is only extended if it described the file exactly as it was before this record was added
+    bool appended = readIndexHeader(fd, stored) && statDataFile(dataFileName, current) &&
+                    stored.dataSize + length == current.dataSize;
+    location.id = id;
+    location.offset = stored.dataSize;
+    location.length = length;
+    appended = appended && toIndexEntry(location, entry);
+
+    std::uint64_t count = countIndexEntries(fd);
+    current.sortedEntries = stored.sortedEntries;
+    if (appended && count - std::min(stored.sortedEntries, count) >= maxUnsortedEntries) {
+        appended = sortAppendedEntries(fd, recordIndexFileName(dataFileName), current, entry);
+    } else {
+        off_t end = static_cast<off_t>(sizeof(RecordIndexHeader) + count * sizeof(RecordIndexEntry));
+        appended = appended && ::pwrite(fd, &entry, sizeof(entry), end) == static_cast<ssize_t>(sizeof(entry)) &&
+                   ::pwrite(fd, &current, sizeof(current), 0) == static_cast<ssize_t>(sizeof(current));
+    }
+    ::close(fd);
+    return appended;
+}
+
+/*
+Function Name: scanRecordLocations
+Purpose: Rebuilds the list of record locations by reading the whole data file once.
+Meaning of Parameters:
+  - const std::string& dataFileName: The data file to scan.
+  - const std::string& headerKey: The word that starts each record's header line, "Customer" or "Product".
+  - std::vector<RecordLocation>& locations: Receives the ID and byte range of every record, in file order.
+Description of Return Values:
+  - Returns `true` if the file was read.
+  - Returns `false` if it could not be opened.
+*/
+bool scanRecordLocations(const std::string& dataFileName, const std::string& headerKey, std::vector<RecordLocation>& locations) {
+    std::string_view contents;
+    if (!mappedFileContents(dataFileName, contents)) {
+        return false;
+    } else {
+        locations.clear();
+    }
+
+    RecordParser parser(contents);
+    std::string_view line;
+    std::string_view value;
+    // The while loop opens a new location at every header line, takes its ID from the "ID:" line and closes it at the next header.
+    while (parser.nextLine(line)) {
+        if (fieldValue(line, headerKey, value)) {
+            if (!locations.empty()) {
+                locations.back().length = static_cast<std::uint32_t>(parser.lineOffset() - locations.back().offset);
+            } else {
+                ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+            }
+            locations.push_back(RecordLocation());
+            locations.back().offset = parser.lineOffset();
+        } else if (!locations.empty() && fieldValue(line, "ID:", value)) {
+            locations.back().id.assign(value);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+
+    if (!locations.empty()) {
+        locations.back().length = static_cast<std::uint32_t>(contents.size() - locations.back().offset);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    return true;
+}
+
+/*
+Function Name: findRecordLocation
+Purpose: Finds the byte range of one record through the index file, rebuilding the index first if it is missing or stale.
+Meaning of Parameters:
+  - const std::string& dataFileName: The data file to look in.
+  - const std::string& headerKey: The word that starts each record's header line, used if the index has to be rebuilt.
+  - const std::string& id: The full ID to look up, e.g. "CustID##########" or "Prod#####".
+  - RecordLocation& location: Receives the record's byte range if it is found.
+Description of Return Values:
+  - Returns `true` if the ID is in the data file.
+  - Returns `false` if it is not, or the data file could not be read.
+*/
+bool findRecordLocation(const std::string& dataFileName, const std::string& headerKey, const std::string& id, RecordLocation& location) {
+    std::vector<RecordLocation> locations;
+    if (!recordIndexIsFresh(dataFileName)) {
+        bool scanned = scanRecordLocations(dataFileName, headerKey, locations);
+        writeRecordIndex(dataFileName, locations);
+        for (std::size_t i = 0; scanned && i < locations.size(); ++i) {
+            if (locations[i].id == id) {
+                location = locations[i];
+                return true;
+            } else {
+                ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+            }
+        }
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    RecordIndexHeader header;
+    RecordIndexEntry wanted;
+    RecordIndexEntry entry;
+    location.id = id;
+    int fd = ::open(recordIndexFileName(dataFileName).c_str(), O_RDONLY);
+    // Only index entries are read; no data file bytes are touched until the record itself is copied.
+    bool found = fd >= 0 && toIndexEntry(location, wanted) && readIndexHeader(fd, header) &&
+                 searchIndexEntries(fd, header, wanted, entry);
+    if (fd >= 0) {
+        ::close(fd);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    location.offset = found ? entry.offset : 0;
+    location.length = found ? entry.length : 0;
+    return found;
+}
+
+/*
+Function Name: readRecordAt
+Purpose: Copies one record's text straight out of its byte range in the mapped data file.
+Meaning of Parameters:
+  - const std::string& dataFileName: The data file to read.
+  - const RecordLocation& location: The byte range of the record.
+  - std::string& text: Receives the record text, starting with its header line.
+Description of Return Values:
+  - Returns `true` if the whole range was read.
+  - Returns `false` if the file could not be opened or is shorter than expected.
+*/
+bool readRecordAt(const std::string& dataFileName, const RecordLocation& location, std::string& text) {
+    std::string_view contents;
+    if (!mappedFileContents(dataFileName, contents) || location.offset + location.length > contents.size()) {
+        text.clear();
+        return false;
+    } else {
+        text.assign(contents.substr(location.offset, location.length));
+        return true;
+    }
+}
+
+/*
+****************************************************************************
+*************************** RECORD INDEX END *******************************
+****************************************************************************
+*/
@@ -0,0 +1,44 @@
+#ifndef RECORDINDEX_H
+#define RECORDINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Declarations for the sidecar record index files (customers.idx, products.idx) that map an ID to the byte range of its record */
+
+// File header. Records the size and modification time of the data file the entries describe.
+struct RecordIndexHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t dataSize;
+    std::int64_t dataModified;   // Nanoseconds since the epoch
+    std::uint64_t sortedEntries; // The entries before this one are sorted by ID; later ones were appended unsorted
+};
+
+// One index entry. The ID is padded with '\0'; entries compare by their padded ID bytes.
+struct RecordIndexEntry {
+    char id[24];
+    std::uint64_t offset;
+    std::uint32_t length;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(RecordIndexHeader) == 32, "record index header must be 32 bytes");
+static_assert(sizeof(RecordIndexEntry) == 40, "record index entry must be 40 bytes");
+
+struct RecordLocation {
+    std::string id;
+    std::uint64_t offset = 0;
+    std::uint32_t length = 0;
+};
+
+std::string recordIndexFileName(const std::string& dataFileName);
+bool recordIndexIsFresh(const std::string& dataFileName);
+bool writeRecordIndex(const std::string& dataFileName, const std::vector<RecordLocation>& locations);
+bool appendRecordIndex(const std::string& dataFileName, const std::string& id, std::uint32_t length);
+bool scanRecordLocations(const std::string& dataFileName, const std::string& headerKey, std::vector<RecordLocation>& locations);
+bool findRecordLocation(const std::string& dataFileName, const std::string& headerKey, const std::string& id, RecordLocation& location);
+bool readRecordAt(const std::string& dataFileName, const RecordLocation& location, std::string& text);
+
+#endif // RECORDINDEX_H
@@ -0,0 +1,218 @@
+#include <fstream>
+#include <charconv>
+#include "recordParser.h"
+
+/*
+****************************************************************************
+************************** RECORD PARSER START *****************************
+****************************************************************************
+*/
+
+/*
+Function Name: isBlank
+Purpose: Checks for the whitespace characters that surround fields in the record files.
+Meaning of Parameters:
+  - char ch: The character to check.
+Description of Return Values:
+  - Returns `true` for a space, tab, carriage return, newline, vertical tab or form feed.
+*/
+static bool isBlank(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '\v' || ch == '\f';
+}
+
+/*
+Method Name: RecordParser
+Purpose: Starts reading a record file held in memory from its first byte.
+Meaning of Parameters:
+  - std::string_view buffer: The whole file. It must outlive the parser and every view the parser returns.
+Description of Return Values:
+  - None.
+*/
+RecordParser::RecordParser(std::string_view buffer) : buffer(buffer) {
+}
+
+/*
+Method Name: nextLine
+Purpose: Moves to the next line of the buffer and returns it without its surrounding whitespace. Nothing is copied.
+Meaning of Parameters:
+  - std::string_view& line: Receives the trimmed line.
+Description of Return Values:
+  - Returns `true` if a line was read, or `false` at the end of the buffer.
+*/
+bool RecordParser::nextLine(std::string_view& line) {
+    if (pos >= buffer.size()) {
+        return false;
+    } else {
+        lineStart = pos;
+    }
+
+    std::size_t end = buffer.find('\n', pos);
+    end = (end == std::string_view::npos) ? buffer.size() : end;
+    line = trimView(buffer.substr(pos, end - pos));
+    pos = (end < buffer.size()) ? end + 1 : end;
+    return true;
+}
+
+/*
+Method Name: lineOffset
+Purpose: Reports where the line most recently returned by nextLine starts, for building record indexes.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the byte offset of the start of that line, before trimming.
+*/
+std::size_t RecordParser::lineOffset() const {
+    return lineStart;
+}
+
+/*
+Method Name: position
+Purpose: Reports how far the parser has read.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the byte offset just past the newline of the line most recently returned, or the buffer size at the end.
+*/
+std::size_t RecordParser::position() const {
+    return pos;
+}
+
+/*
+Function Name: trimView
+Purpose: Removes leading and trailing whitespace from a view without copying it.
+Meaning of Parameters:
+  - std::string_view text: The text to trim.
+Description of Return Values:
+  - Returns a view of the text between the first and last non-whitespace characters, or an empty view.
+*/
+std::string_view trimView(std::string_view text) {
+    std::size_t start = 0;
+    std::size_t end = text.size();
+    while (start < end && isBlank(text[start])) {
+        ++start;
+    }
+    while (end > start && isBlank(text[end - 1])) {
+        --end;
+    }
+    return text.substr(start, end - start);
+}
+
+/*
+Function Name: fieldValue
+Purpose: Checks whether a trimmed line starts with the given key and, if so, returns a view of the value after it.
+Meaning of Parameters:
+  - std::string_view line: The trimmed line (e.g. "Age: 42").
+  - std::string_view key: The field key including its colon when it has one (e.g. "Age:").
+  - std::string_view& value: Receives the trimmed value when the key matches.
+Description of Return Values:
+  - Returns `true` if the line starts with the key; `value` then holds the field value.
+  - Returns `false` if it does not; `value` is left unchanged.
+*/
+bool fieldValue(std::string_view line, std::string_view key, std::string_view& value) {
+    if (line.compare(0, key.size(), key) != 0) {
+        return false;
+    } else {
+        value = trimView(line.substr(key.size()));
+    }
+    return true;
+}
+
+/*
+Function Name: parseNumber (int)
+Purpose: Parses a whole number with std::from_chars, without locale lookups or copies.
+Meaning of Parameters:
+  - std::string_view text: The digits, optionally preceded by '-'.
+  - int& value: Receives the number.
+Description of Return Values:
+  - Returns `true` if the text starts with a number in range; anything after it is ignored, as with std::atoi.
+  - Returns `false` otherwise; `value` is left unchanged.
+*/
+bool parseNumber(std::string_view text, int& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc();
+}
+
+/*
+Function Name: parseWholeNumber
+Purpose: Parses a whole number that must make up the entire text, for input from outside the data files such as request fields.
+Meaning of Parameters:
+  - std::string_view text: The digits, optionally preceded by '-'.
+  - int& value: Receives the number.
+Description of Return Values:
+  - Returns `true` if the text is exactly one number in range; "2x" and "" are rejected.
+  - Returns `false` otherwise; `value` is left unchanged.
+*/
+bool parseWholeNumber(std::string_view text, int& value) {
+    int parsed = 0;
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), parsed);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        return false;
+    } else {
+        value = parsed;
+        return true;
+    }
+}
+
+/*
+Function Name: parseNumber (std::uint64_t)
+Purpose: Parses an unsigned 64-bit number with std::from_chars.
+Meaning of Parameters:
+  - std::string_view text: The digits.
+  - std::uint64_t& value: Receives the number.
+Description of Return Values:
+  - Returns `true` if the text starts with a number in range.
+  - Returns `false` otherwise; `value` is left unchanged.
+*/
+bool parseNumber(std::string_view text, std::uint64_t& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc();
+}
+
+/*
+Function Name: parseNumber (double)
+Purpose: Parses a decimal number such as a price with std::from_chars.
+Meaning of Parameters:
+  - std::string_view text: The number, e.g. "2.50".
+  - double& value: Receives the number.
+Description of Return Values:
+  - Returns `true` if the text starts with a number.
+  - Returns `false` otherwise; `value` is left unchanged.
+*/
+bool parseNumber(std::string_view text, double& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc();
+}
+
+/*
+Function Name: readWholeFile
+Purpose: Reads a whole file into memory with a single read, so it can be parsed with RecordParser.
+Meaning of Parameters:
+  - const std::string& fileName: The file to read.
+  - std::string& buffer: Receives the file contents.
+Description of Return Values:
+  - Returns `true` if the file was read.
+  - Returns `false` if it could not be opened or read; `buffer` is left empty in that case.
+*/
+bool readWholeFile(const std::string& fileName, std::string& buffer) {
+    buffer.clear();
+    std::ifstream infile(fileName, std::ios::binary | std::ios::ate);
+    if (!infile.is_open()) {
+        return false;
+    } else {
+        buffer.resize(static_cast<std::size_t>(infile.tellg()));
+        infile.seekg(0);
+    }
+
+    if (!infile.read(&buffer[0], static_cast<std::streamsize>(buffer.size()))) {
+        buffer.clear();
+        return false;
+    } else {
+        return true;
+    }
+}
+
+/*
+****************************************************************************
+*************************** RECORD PARSER END ******************************
+****************************************************************************
+*/
@@ -0,0 +1,33 @@
+#ifndef RECORDPARSER_H
+#define RECORDPARSER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/* Declarations for the allocation-free reader shared by every "Key: value" record file */
+
+// Walks a buffer holding a whole record file one trimmed line at a time. The views it hands out point into the buffer.
+class RecordParser {
+public:
+    explicit RecordParser(std::string_view buffer);
+
+    bool nextLine(std::string_view& line);
+    std::size_t lineOffset() const;
+    std::size_t position() const;
+
+private:
+    std::string_view buffer;
+    std::size_t pos = 0;
+    std::size_t lineStart = 0;
+};
+
+std::string_view trimView(std::string_view text);
+bool fieldValue(std::string_view line, std::string_view key, std::string_view& value);
+bool parseNumber(std::string_view text, int& value);
+bool parseWholeNumber(std::string_view text, int& value);
+bool parseNumber(std::string_view text, std::uint64_t& value);
+bool parseNumber(std::string_view text, double& value);
+bool readWholeFile(const std::string& fileName, std::string& buffer);
+
+#endif // RECORDPARSER_H
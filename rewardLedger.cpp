@@ -0,0 +1,215 @@
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include "durableFile.h"
+#include "rewardLedger.h"
+
+/*
+****************************************************************************
+************************** REWARD LEDGER START *****************************
+****************************************************************************
+*/
+
+/*
+Function Name: parseLedgerEntry
+Purpose: Parses one line of the reward ledger. Lines have the form "<sequence> <customer ID> <+/-points> <reason> <reference>".
+Meaning of Parameters:
+  - const std::string& line: The ledger line to parse.
+  - RewardLedgerEntry& entry: Receives the parsed fields.
+Description of Return Values:
+  - Returns `true` if the line holds a complete entry.
+  - Returns `false` for blank, partial or malformed lines, such as a final line cut short by a crash.
+*/
+bool parseLedgerEntry(const std::string& line, RewardLedgerEntry& entry) {
+    std::istringstream iss(line);
+    std::string userID;
+    if (iss >> entry.sequence >> userID >> entry.delta >> entry.reason >> entry.reference) {
+        return parseCustomerId(userID, entry.userID);
+    } else {
+        return false;
+    }
+}
+
+/*
+Function Name: sumLedgerDeltas
+Purpose: Adds up one customer's balance changes in a ledger file that are newer than a given sequence number, for reading a balance without loading every customer.
+Meaning of Parameters:
+  - const std::string& fileName: The ledger file or segment to read. A missing file counts as empty.
+  - CustomerId userID: The customer whose entries are added up.
+  - std::uint64_t afterSequence: Entries at or below this sequence number are already in the customer file and are skipped.
+Description of Return Values:
+  - Returns the signed total of the matching entries, or 0 if there are none.
+*/
+int sumLedgerDeltas(const std::string& fileName, CustomerId userID, std::uint64_t afterSequence) {
+    std::ifstream infile(fileName);
+    std::string line;
+    RewardLedgerEntry entry;
+    int total = 0;
+
+    while (std::getline(infile, line)) {
+        if (parseLedgerEntry(line, entry) && entry.sequence > afterSequence && entry.userID == userID) {
+            total += entry.delta;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return total;
+}
+
+/*
+Method Name: open
+Purpose: Opens the ledger file for appending and continues numbering after the last entry already applied.
+Meaning of Parameters:
+  - const std::string& fileName: The ledger file, normally "rewardsLedger.txt".
+  - std::uint64_t lastSequence: The highest sequence number already used, so new entries continue after it.
+  - std::size_t pendingEntries: How many entries are already in the ledger and not yet folded into the customer file.
+Description of Return Values:
+  - Returns `true` if the file was opened.
+  - Returns `false` and outputs an error message if it could not be opened.
+*/
+bool RewardLedger::open(const std::string& fileName, std::uint64_t lastSequence, std::size_t pendingEntries) {
+    close();
+    this->fileName = fileName;
+    sequence = lastSequence;
+    pending = pendingEntries;
+
+    outfile.open(fileName, std::ios::app);
+    if (!outfile.is_open()) {
+        std::cerr << "Error: Could not open " << fileName << " file.\n";
+        return false;
+    } else {
+        return true;
+    }
+}
+
+/*
+Method Name: append
+Purpose: Appends one reward point change to the ledger and flushes it to the file.
+Meaning of Parameters:
+  - CustomerId userID: The customer whose balance changed.
+  - int delta: The signed number of points added or removed.
+  - const std::string& reason: A one-word reason, e.g. "purchase" or "redeem".
+  - const std::string& reference: The transaction ID or reward product ID behind the change, or "-" if there is none.
+Description of Return Values:
+  - Returns `true` if the entry was written.
+  - Returns `false` and outputs an error message if the ledger is not open or the write failed. The file is reopened and the sequence number is not used up, so the entry can be retried: if part of it did reach the file and reads as complete, replay skips the retried copy as a sequence number it has already applied.
+*/
+bool RewardLedger::append(CustomerId userID, int delta, const std::string& reason, const std::string& reference) {
+    if (!outfile.is_open()) {
+        std::cerr << "Error: Reward ledger is not open.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    // After a failed append the entry starts on a fresh line, so it is not run together with what the failure left
+    outfile << (torn ? "\n" : "") << (sequence + 1) << ' ' << formatId(userID) << ' ' << (delta >= 0 ? "+" : "") << delta << ' '
+            << reason << ' ' << (reference.empty() ? "-" : reference) << '\n';
+    outfile.flush();
+    torn = !outfile;
+    if (torn) {
+        std::cerr << "Error: Could not write to " << fileName << " file.\n";
+        outfile.close();
+        outfile.open(fileName, std::ios::app);
+        return false;
+    } else {
+        ++sequence;
+        ++pending;
+    }
+    return true;
+}
+
+/*
+Method Name: rotate
+Purpose: Moves the current ledger contents aside into a segment file and starts a new, empty ledger, so the segment can be folded into a snapshot while new changes keep being appended.
+Meaning of Parameters:
+  - const std::string& segmentName: The file name to move the current ledger to.
+Description of Return Values:
+  - Returns `true` if the ledger was moved and reopened; the pending entry count restarts at zero.
+  - Returns `false` and outputs an error message if the rename or reopen failed.
+*/
+bool RewardLedger::rotate(const std::string& segmentName) {
+    outfile.close();
+    if (std::rename(fileName.c_str(), segmentName.c_str()) != 0) {
+        std::cerr << "Error: Could not move " << fileName << " to " << segmentName << ".\n";
+        outfile.open(fileName, std::ios::app);
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    return open(fileName, sequence, 0);
+}
+
+/*
+Method Name: reset
+Purpose: Empties the ledger after every entry in it has been folded into the customer file. The empty ledger replaces the old one through replaceFile, so a crash leaves either the full ledger or the empty one, never a truncation that has not reached the disk.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the ledger was truncated and reopened; sequence numbering continues where it was.
+  - Returns `false` and outputs an error message if the file could not be replaced or reopened; a ledger that could not be replaced keeps its entries.
+*/
+bool RewardLedger::reset() {
+    outfile.close();
+    bool emptied = replaceFile(fileName, "");
+    return open(fileName, sequence, emptied ? 0 : pending) && emptied;
+}
+
+/*
+Method Name: close
+Purpose: Closes the ledger file if it is open.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void RewardLedger::close() {
+    if (outfile.is_open()) {
+        outfile.close();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: isOpen
+Purpose: Reports whether reward changes are currently being recorded in the ledger.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the ledger file is open.
+*/
+bool RewardLedger::isOpen() const {
+    return outfile.is_open();
+}
+
+/*
+Method Name: lastSequence
+Purpose: Reports the sequence number of the most recent ledger entry.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the last sequence number used, or the starting value given to open if nothing was appended.
+*/
+std::uint64_t RewardLedger::lastSequence() const {
+    return sequence;
+}
+
+/*
+Method Name: pendingEntries
+Purpose: Reports how many entries are in the current ledger file, waiting to be folded into the customer file.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the number of pending entries.
+*/
+std::size_t RewardLedger::pendingEntries() const {
+    return pending;
+}
+
+/*
+****************************************************************************
+*************************** REWARD LEDGER END ******************************
+****************************************************************************
+*/
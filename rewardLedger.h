@@ -0,0 +1,41 @@
+#ifndef REWARDLEDGER_H
+#define REWARDLEDGER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "recordId.h"
+
+/* Declarations for the append-only reward point ledger (rewardsLedger.txt) */
+
+struct RewardLedgerEntry {
+    std::uint64_t sequence = 0;
+    CustomerId userID{};
+    int delta = 0;
+    std::string reason;
+    std::string reference;
+};
+
+class RewardLedger {
+public:
+    bool open(const std::string& fileName, std::uint64_t lastSequence, std::size_t pendingEntries);
+    bool append(CustomerId userID, int delta, const std::string& reason, const std::string& reference);
+    bool rotate(const std::string& segmentName);
+    bool reset();
+    void close();
+    bool isOpen() const;
+    std::uint64_t lastSequence() const;
+    std::size_t pendingEntries() const;
+
+private:
+    std::string fileName;
+    std::ofstream outfile;
+    std::uint64_t sequence = 0;
+    std::size_t pending = 0;
+    bool torn = false; // The last append failed and may have left part of a line behind
+};
+
+bool parseLedgerEntry(const std::string& line, RewardLedgerEntry& entry);
+int sumLedgerDeltas(const std::string& fileName, CustomerId userID, std::uint64_t afterSequence);
+
+#endif // REWARDLEDGER_H
@@ -0,0 +1,544 @@
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include "rewardRules.h"
+#include "recordParser.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/*
+****************************************************************************
+*************************** REWARD RULES START *****************************
+****************************************************************************
+*/
+
+// Sections of the rules file, chosen by the header line that starts each block
+static const int noRuleSection = 0;
+static const int baseRateSection = 1;
+static const int bracketSection = 2;
+static const int multiplierSection = 3;
+
+// The SIMD paths of pointsBatch work in doubles. Totals below 2^31 cents ($21 million) times rates below 2^16
+// hundredths (655 points per dollar) stay under 2^47, where the double result rounds down to the same whole
+// number as the integer one. Larger totals are handed back to the scalar code; larger rates disable the SIMD paths.
+static const std::int64_t batchRateLimit = std::int64_t(1) << 16;
+static const double batchAmountLimit = 2147483648.0;
+
+/*
+Function Name: parseRuleScale
+Purpose: Parses a rate or multiplier from the rules file into hundredths, using the same decimal parser as dollar amounts.
+Meaning of Parameters:
+  - std::string_view value: The field value, e.g. "1.5".
+  - std::int64_t& hundredths: Receives the value in hundredths, e.g. 150.
+Description of Return Values:
+  - Returns `true` if the value is a number with at most two decimal places.
+  - Returns `false` otherwise; `hundredths` is unchanged.
+*/
+static bool parseRuleScale(std::string_view value, std::int64_t& hundredths) {
+    Money scaled;
+    if (!parseMoney(value, scaled)) {
+        return false;
+    } else {
+        hundredths = scaled.cents();
+        return true;
+    }
+}
+
+/*
+Function Name: splitProductList
+Purpose: Splits a comma-separated list of product IDs from a category rule.
+Meaning of Parameters:
+  - std::string_view value: The list, e.g. "Prod56834, Prod56838".
+  - std::vector<std::string>& productIDs: Receives the IDs, appended in order.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void splitProductList(std::string_view value, std::vector<std::string>& productIDs) {
+    while (!value.empty()) {
+        std::size_t comma = value.find(',');
+        std::string_view productID = trimView(value.substr(0, comma));
+        if (!productID.empty()) {
+            productIDs.push_back(std::string(productID));
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+        value = (comma == std::string_view::npos) ? std::string_view() : value.substr(comma + 1);
+    }
+}
+
+/*
+Function Name: ruleSection
+Purpose: Recognises the header line that starts a block of the rules file and adds an empty rule for it.
+Meaning of Parameters:
+  - std::string_view line: A trimmed line from the rules file.
+  - RewardRuleSet& ruleSet: Receives a new bracket or multiplier when the header starts one.
+Description of Return Values:
+  - Returns the section the header starts, or noRuleSection if the line is not a header.
+*/
+static int ruleSection(std::string_view line, RewardRuleSet& ruleSet) {
+    std::string_view value;
+    if (fieldValue(line, "Base Rate", value)) {
+        return baseRateSection;
+    } else if (fieldValue(line, "Bracket", value)) {
+        ruleSet.brackets.push_back(RewardBracket());
+        return bracketSection;
+    } else if (fieldValue(line, "Product Multiplier", value) || fieldValue(line, "Category Multiplier", value)) {
+        ruleSet.multipliers.push_back(RewardMultiplier());
+        ruleSet.multipliers.back().name = std::string(line);
+        return multiplierSection;
+    } else {
+        return noRuleSection;
+    }
+}
+
+/*
+Function Name: applyBaseRateField
+Purpose: Stores a single "Key: value" field of the "Base Rate" block.
+Meaning of Parameters:
+  - RewardRuleSet& ruleSet: The rules being read.
+  - std::string_view line: A trimmed line from the rules file.
+Description of Return Values:
+  - Returns `true` if the field was valid or is not one the block uses.
+  - Returns `false` if a known field has a value that is not a non-negative number with at most two decimal places.
+*/
+static bool applyBaseRateField(RewardRuleSet& ruleSet, std::string_view line) {
+    std::string_view value;
+    if (fieldValue(line, "Points Per Dollar:", value)) {
+        return parseRuleScale(value, ruleSet.pointsPerDollar);
+    } else if (fieldValue(line, "Minimum Spend:", value)) {
+        return parseMoney(value, ruleSet.minimumSpend);
+    } else {
+        return true;
+    }
+}
+
+/*
+Function Name: applyBracketField
+Purpose: Stores a single "Key: value" field of a "Bracket" block into the bracket it describes.
+Meaning of Parameters:
+  - RewardBracket& bracket: The bracket being read.
+  - std::string_view line: A trimmed line from the rules file.
+Description of Return Values:
+  - Returns `true` if the field was valid or is not one the block uses.
+  - Returns `false` if a known field has a value that is not a non-negative number with at most two decimal places.
+*/
+static bool applyBracketField(RewardBracket& bracket, std::string_view line) {
+    std::string_view value;
+    if (fieldValue(line, "From:", value)) {
+        return parseMoney(value, bracket.from);
+    } else if (fieldValue(line, "Points Per Dollar:", value)) {
+        return parseRuleScale(value, bracket.pointsPerDollar);
+    } else {
+        return true;
+    }
+}
+
+/*
+Function Name: applyMultiplierField
+Purpose: Stores a single "Key: value" field of a product or category multiplier block into the rule it describes.
+Meaning of Parameters:
+  - RewardMultiplier& rule: The multiplier being read.
+  - std::string_view line: A trimmed line from the rules file.
+Description of Return Values:
+  - Returns `true` if the field was valid or is not one the block uses.
+  - Returns `false` if the multiplier is not a non-negative number with at most two decimal places.
+*/
+static bool applyMultiplierField(RewardMultiplier& rule, std::string_view line) {
+    std::string_view value;
+    if (fieldValue(line, "Multiplier:", value)) {
+        return parseRuleScale(value, rule.multiplier);
+    } else if (fieldValue(line, "ID:", value) || fieldValue(line, "Products:", value)) {
+        splitProductList(value, rule.productIDs);
+        return true;
+    } else {
+        return true;
+    }
+}
+
+/*
+Function Name: applyRuleField
+Purpose: Stores a single "Key: value" field of the rules file into the rule its block describes.
+Meaning of Parameters:
+  - RewardRuleSet& ruleSet: The rules being read.
+  - int section: The block the field belongs to.
+  - std::string_view line: A trimmed line from the rules file.
+Description of Return Values:
+  - Returns `true` if the field was valid or is not one the block uses.
+  - Returns `false` if a known field has a value that is not a non-negative number with at most two decimal places.
+*/
+static bool applyRuleField(RewardRuleSet& ruleSet, int section, std::string_view line) {
+    if (section == baseRateSection) {
+        return applyBaseRateField(ruleSet, line);
+    } else if (section == bracketSection) {
+        return applyBracketField(ruleSet.brackets.back(), line);
+    } else if (section == multiplierSection) {
+        return applyMultiplierField(ruleSet.multipliers.back(), line);
+    } else {
+        return true;
+    }
+}
+
+/*
+Function Name: productSlot
+Purpose: Converts a product ID from the rules file into its position in the multiplier table.
+Meaning of Parameters:
+  - const std::string& productID: The product ID as written in the file (Prod#####).
+  - std::size_t& slot: Receives the 5 digit product number.
+Description of Return Values:
+  - Returns `true` if the ID is "Prod" followed by exactly 5 digits.
+  - Returns `false` otherwise.
+*/
+static bool productSlot(const std::string& productID, std::size_t& slot) {
+    ProductId id{};
+    if (productID.compare(0, 4, "Prod") != 0 || !parseProductId(productID, id)) {
+        return false;
+    } else {
+        slot = static_cast<std::size_t>(id);
+        return true;
+    }
+}
+
+/*
+Function Name: compileMultipliers
+Purpose: Builds the table of one multiplier per product number, multiplying in every product and category rule that names the product.
+Meaning of Parameters:
+  - const RewardRuleSet& ruleSet: The rules to compile.
+  - std::vector<std::int32_t>& productMultipliers: Receives the table, in hundredths.
+Description of Return Values:
+  - This function does not return a value. Malformed product IDs are skipped with a warning.
+*/
+static void compileMultipliers(const RewardRuleSet& ruleSet, std::vector<std::int32_t>& productMultipliers) {
+    productMultipliers.assign(rewardProductSlots, static_cast<std::int32_t>(rewardScale));
+    std::size_t slot = 0;
+    for (std::size_t i = 0; i < ruleSet.multipliers.size(); ++i) {
+        const RewardMultiplier& rule = ruleSet.multipliers[i];
+        for (std::size_t j = 0; j < rule.productIDs.size(); ++j) {
+            if (productSlot(rule.productIDs[j], slot)) {
+                productMultipliers[slot] = static_cast<std::int32_t>(productMultipliers[slot] * rule.multiplier / rewardScale);
+            } else {
+                std::cerr << "Warning: Ignoring product ID " << rule.productIDs[j] << " in " << rule.name << ".\n";
+            }
+        }
+    }
+}
+
+/*
+Function Name: lessBracketStart
+Purpose: Orders brackets by the spend they start at, for compiling them into the threshold table.
+Meaning of Parameters:
+  - const RewardBracket& left: The first bracket to compare.
+  - const RewardBracket& right: The second bracket to compare.
+Description of Return Values:
+  - Returns `true` if `left` starts at a lower spend than `right`.
+*/
+static bool lessBracketStart(const RewardBracket& left, const RewardBracket& right) {
+    return left.from < right.from;
+}
+
+#if defined(__x86_64__)
+/*
+Function Name: pointsBatchSse2
+Purpose: SSE2 path of RewardRules::pointsBatch, two totals at a time. Each threshold is compared against both totals at once and the rate of the highest bracket reached is kept with masks, so there are no branches on the totals.
+Meaning of Parameters:
+  - const long long* cents: The totals in cents.
+  - int* points: Receives the points.
+  - std::size_t count: How many totals there are.
+  - const double* thresholds: The compiled thresholds, in cents.
+  - std::size_t thresholdCount: How many thresholds are in use.
+  - const double* rates: The compiled rates, in hundredths of a point per dollar.
+Description of Return Values:
+  - Returns how many totals were evaluated, counted from the start. It stops at the first pair holding a total outside the exact range and leaves the rest to the scalar code.
+*/
+static std::size_t pointsBatchSse2(const long long* cents, int* points, std::size_t count, const double* thresholds, std::size_t thresholdCount, const double* rates) {
+    // Adding 2^52 + 2^51 to an integer below 2^51 and reading the bits as a double gives that value plus the same constant
+    const __m128i magicBits = _mm_set1_epi64x(0x4338000000000000LL);
+    const __m128d magic = _mm_set1_pd(6755399441055744.0);
+    const __m128d limit = _mm_set1_pd(batchAmountLimit);
+    const __m128d lowLimit = _mm_set1_pd(-batchAmountLimit);
+    const __m128d scale = _mm_set1_pd(100.0 * rewardScale);
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cents + i));
+        __m128d amount = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(raw, magicBits)), magic);
+        if (_mm_movemask_pd(_mm_or_pd(_mm_cmpge_pd(amount, limit), _mm_cmplt_pd(amount, lowLimit))) != 0) {
+            break;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+
+        __m128d rate = _mm_set1_pd(rates[0]);
+        for (std::size_t k = 0; k < thresholdCount; ++k) {
+            __m128d reached = _mm_cmpge_pd(amount, _mm_set1_pd(thresholds[k]));
+            rate = _mm_or_pd(_mm_and_pd(reached, _mm_set1_pd(rates[k + 1])), _mm_andnot_pd(reached, rate));
+        }
+        __m128i earned = _mm_cvttpd_epi32(_mm_div_pd(_mm_mul_pd(amount, rate), scale));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(points + i), earned);
+    }
+    return i;
+}
+
+/*
+Function Name: pointsBatchAvx2
+Purpose: AVX2 path of RewardRules::pointsBatch, four totals at a time; otherwise the same as pointsBatchSse2. Only called once the CPU is known to support AVX2.
+Meaning of Parameters:
+  - const long long* cents: The totals in cents.
+  - int* points: Receives the points.
+  - std::size_t count: How many totals there are.
+  - const double* thresholds: The compiled thresholds, in cents.
+  - std::size_t thresholdCount: How many thresholds are in use.
+  - const double* rates: The compiled rates, in hundredths of a point per dollar.
+Description of Return Values:
+  - Returns how many totals were evaluated, counted from the start. It stops early at a block holding a total outside the exact range.
+*/
+__attribute__((target("avx2")))
+static std::size_t pointsBatchAvx2(const long long* cents, int* points, std::size_t count, const double* thresholds, std::size_t thresholdCount, const double* rates) {
+    const __m256i magicBits = _mm256_set1_epi64x(0x4338000000000000LL);
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+    const __m256d limit = _mm256_set1_pd(batchAmountLimit);
+    const __m256d lowLimit = _mm256_set1_pd(-batchAmountLimit);
+    const __m256d scale = _mm256_set1_pd(100.0 * rewardScale);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cents + i));
+        __m256d amount = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(raw, magicBits)), magic);
+        __m256d outside = _mm256_or_pd(_mm256_cmp_pd(amount, limit, _CMP_GE_OQ), _mm256_cmp_pd(amount, lowLimit, _CMP_LT_OQ));
+        if (_mm256_movemask_pd(outside) != 0) {
+            break;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+
+        __m256d rate = _mm256_set1_pd(rates[0]);
+        for (std::size_t k = 0; k < thresholdCount; ++k) {
+            __m256d reached = _mm256_cmp_pd(amount, _mm256_set1_pd(thresholds[k]), _CMP_GE_OQ);
+            rate = _mm256_blendv_pd(rate, _mm256_set1_pd(rates[k + 1]), reached);
+        }
+        __m128i earned = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_mul_pd(amount, rate), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(points + i), earned);
+    }
+    return i;
+}
+#endif
+
+/*
+Method Name: RewardRules
+Purpose: Starts with the original fixed rule of 10 points per $5 spent, used when no rules file is present.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+RewardRules::RewardRules() {
+    compile(RewardRuleSet());
+}
+
+/*
+Method Name: load
+Purpose: Reads the reward rules from a configuration file and compiles them. The previous rules stay in effect if the file is missing or invalid.
+Meaning of Parameters:
+  - const std::string& fileName: The rules file, normally "rewardRules.txt".
+Description of Return Values:
+  - Returns `true` if the file was read and compiled.
+  - Returns `false` if it is missing, or outputs an error message and returns `false` if it is invalid.
+*/
+bool RewardRules::load(const std::string& fileName) {
+    std::string buffer;
+    if (!readWholeFile(fileName, buffer)) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    RewardRuleSet ruleSet;
+    RecordParser parser(buffer);
+    std::string_view line;
+    int section = noRuleSection;
+    bool valid = true;
+    // The while loop switches block at every header line and routes the following field lines into the current rule.
+    while (valid && parser.nextLine(line)) {
+        int header = ruleSection(line, ruleSet);
+        section = (header != noRuleSection) ? header : section;
+        valid = (header != noRuleSection) || applyRuleField(ruleSet, section, line);
+    }
+
+    if (!valid) {
+        std::cerr << "Error: Invalid value \"" << line << "\" in " << fileName << ". Using the previous reward rules.\n";
+        return false;
+    } else {
+        return compile(ruleSet);
+    }
+}
+
+/*
+Method Name: compile
+Purpose: Compiles a rule set into the flat integer tables used by points: a fixed-size array of bracket thresholds in cents with the rate for each, and one multiplier per product number with the category multipliers folded in.
+Meaning of Parameters:
+  - const RewardRuleSet& ruleSet: The rules to compile.
+Description of Return Values:
+  - Returns `true` if the rules were compiled and are now in effect.
+  - Returns `false` and outputs an error message if there are too many brackets; the previous rules stay in effect.
+*/
+bool RewardRules::compile(const RewardRuleSet& ruleSet) {
+    // The rate steps, from zero upwards. Nothing is earned below the minimum spend, and no bracket starts below it.
+    std::vector<RewardBracket> steps(1, RewardBracket());
+    steps[0].pointsPerDollar = (ruleSet.minimumSpend > Money()) ? 0 : ruleSet.pointsPerDollar;
+    std::vector<RewardBracket> brackets = ruleSet.brackets;
+    std::stable_sort(brackets.begin(), brackets.end(), lessBracketStart);
+    brackets.insert(brackets.begin(), RewardBracket{ ruleSet.minimumSpend, ruleSet.pointsPerDollar });
+    for (std::size_t i = 0; i < brackets.size(); ++i) {
+        steps.push_back(RewardBracket{ std::max(brackets[i].from, ruleSet.minimumSpend), brackets[i].pointsPerDollar });
+    }
+
+    if (steps.size() > rewardBracketSlots) {
+        std::cerr << "Error: At most " << rewardBracketSlots - 2 << " reward brackets are supported.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    batchExact = true;
+    for (std::size_t k = 0; k < rewardBracketSlots; ++k) {
+        thresholds[k] = (k + 1 < steps.size()) ? steps[k + 1].from.cents() : std::numeric_limits<std::int64_t>::max();
+        rates[k] = (k < steps.size()) ? steps[k].pointsPerDollar : steps.back().pointsPerDollar;
+        batchThresholds[k] = static_cast<double>(thresholds[k]);
+        batchRates[k] = static_cast<double>(rates[k]);
+        batchExact = batchExact && rates[k] < batchRateLimit;
+    }
+    rates[rewardBracketSlots] = steps.back().pointsPerDollar;
+    batchRates[rewardBracketSlots] = static_cast<double>(rates[rewardBracketSlots]);
+    thresholdCount = steps.size() - 1;
+
+    compileMultipliers(ruleSet, productMultipliers);
+    multipliersInEffect = !ruleSet.multipliers.empty();
+    return true;
+}
+
+/*
+Method Name: points
+Purpose: Evaluates the compiled rules for one transaction in integer arithmetic. The bracket is found by counting the thresholds the total reaches; the loop length depends only on the rules, never on the total, so there are no data-dependent branches.
+Meaning of Parameters:
+  - Money totalAmount: The transaction total, which selects the bracket and is checked against the minimum spend.
+  - std::int64_t weightedAmount: The sum of weigh() over the line items: cents times each product's multiplier in hundredths.
+Description of Return Values:
+  - Returns the reward points earned, rounded down.
+*/
+int RewardRules::points(Money totalAmount, std::int64_t weightedAmount) const {
+    std::size_t reached = 0;
+    for (std::size_t k = 0; k < thresholdCount; ++k) {
+        reached += (totalAmount.cents() >= thresholds[k]) ? 1 : 0;
+    }
+    // Cents, multiplier hundredths and rate hundredths each carry a factor of 100.
+    return static_cast<int>(weightedAmount * rates[reached] / (100 * rewardScale * rewardScale));
+}
+
+/*
+Method Name: multiplier
+Purpose: Looks up the combined product and category multiplier for a product.
+Meaning of Parameters:
+  - ProductId productID: The product.
+Description of Return Values:
+  - Returns the multiplier in hundredths, or 100 if no rule names the product.
+*/
+std::int64_t RewardRules::multiplier(ProductId productID) const {
+    std::size_t slot = static_cast<std::size_t>(productID);
+    return (slot < productMultipliers.size()) ? productMultipliers[slot] : rewardScale;
+}
+
+/*
+Method Name: weigh
+Purpose: Scales a line item's amount by its product's multiplier, giving the value points adds up the line items in.
+Meaning of Parameters:
+  - Money amount: The line item amount.
+  - ProductId productID: The line item's product.
+Description of Return Values:
+  - Returns the amount in cents times the multiplier in hundredths.
+*/
+std::int64_t RewardRules::weigh(Money amount, ProductId productID) const {
+    return amount.cents() * multiplier(productID);
+}
+
+/*
+Method Name: hasMultipliers
+Purpose: Tells whether any product or category multiplier is in effect, i.e. whether a transaction's points can depend on more than its total.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the rules have at least one multiplier block.
+  - Returns `false` otherwise.
+*/
+bool RewardRules::hasMultipliers() const {
+    return multipliersInEffect;
+}
+
+/*
+Method Name: pointsBatch
+Purpose: Evaluates the compiled rules for an array of transaction totals with no product multipliers, using the fastest path the CPU supports.
+Meaning of Parameters:
+  - const Money* amounts: The transaction totals.
+  - int* points: Receives the points for each total.
+  - std::size_t count: How many totals there are.
+Description of Return Values:
+  - This function does not return a value. points[i] is always equal to points(amounts[i], amounts[i].cents() * rewardScale).
+*/
+void RewardRules::pointsBatch(const Money* amounts, int* points, std::size_t count) const {
+    pointsBatch(amounts, points, count, bestBatchPath());
+}
+
+/*
+Method Name: pointsBatch (explicit path)
+Purpose: Evaluates the compiled rules for an array of transaction totals on a chosen path, so the paths can be compared.
+Meaning of Parameters:
+  - const Money* amounts: The transaction totals.
+  - int* points: Receives the points for each total.
+  - std::size_t count: How many totals there are.
+  - int batchPath: rewardBatchScalar, rewardBatchSse2 or rewardBatchAvx2. A path the CPU or the rules cannot use falls back to the scalar one.
+Description of Return Values:
+  - This function does not return a value.
+*/
+void RewardRules::pointsBatch(const Money* amounts, int* points, std::size_t count, int batchPath) const {
+    std::size_t done = 0;
+#if defined(__x86_64__)
+    // Money is a single 64-bit integer, so an array of it can be loaded as packed integers
+    const long long* cents = reinterpret_cast<const long long*>(amounts);
+    if (batchExact && batchPath == rewardBatchAvx2 && bestBatchPath() == rewardBatchAvx2) {
+        done = pointsBatchAvx2(cents, points, count, batchThresholds, thresholdCount, batchRates);
+    } else if (batchExact && batchPath >= rewardBatchSse2) {
+        done = pointsBatchSse2(cents, points, count, batchThresholds, thresholdCount, batchRates);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+#else
+    (void)batchPath;
+#endif
+
+    // The for loop finishes the totals the SIMD path left over: the tail, and any total too large for it.
+    for (std::size_t i = done; i < count; ++i) {
+        points[i] = this->points(amounts[i], amounts[i].cents() * rewardScale);
+    }
+}
+
+/*
+Method Name: bestBatchPath
+Purpose: Picks the widest SIMD path the CPU running the program supports. The check runs once.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns rewardBatchAvx2, rewardBatchSse2 (always available on x86-64) or rewardBatchScalar.
+*/
+int RewardRules::bestBatchPath() {
+#if defined(__x86_64__)
+    static const int path = __builtin_cpu_supports("avx2") ? rewardBatchAvx2 : rewardBatchSse2;
+    return path;
+#else
+    return rewardBatchScalar;
+#endif
+}
+
+/*
+****************************************************************************
+**************************** REWARD RULES END ******************************
+****************************************************************************
+*/
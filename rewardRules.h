@@ -0,0 +1,68 @@
+#ifndef REWARDRULES_H
+#define REWARDRULES_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "money.h"
+#include "recordId.h"
+
+/* Declarations for the configurable reward rules (rewardRules.txt) and the lookup tables they are compiled into */
+
+static const std::size_t rewardBracketSlots = 16;     // Fixed, so the tables live inside the object with no allocation
+static const std::size_t rewardProductSlots = 100000; // One multiplier per 5 digit product number
+static const std::int64_t rewardScale = 100;           // Rates and multipliers are kept in hundredths: 1.5 is 150
+
+// Ways pointsBatch can evaluate an array of totals; the best one the CPU supports is picked at runtime.
+static const int rewardBatchScalar = 0;
+static const int rewardBatchSse2 = 1; // 2 totals per instruction
+static const int rewardBatchAvx2 = 2; // 4 totals per instruction
+
+// A spend bracket. Transactions totalling at least `from` dollars earn `pointsPerDollar` on the whole amount.
+struct RewardBracket {
+    Money from;
+    std::int64_t pointsPerDollar = 0; // Hundredths of a point
+};
+
+// A multiplier on the points earned by the listed products. A product rule lists one product; a category rule many.
+struct RewardMultiplier {
+    std::string name;
+    std::int64_t multiplier = rewardScale; // Hundredths
+    std::vector<std::string> productIDs; // As written in the file (Prod#####); checked when compiled
+};
+
+// The rules as written in the configuration file, before compiling.
+struct RewardRuleSet {
+    std::int64_t pointsPerDollar = 2 * rewardScale; // 10 points per $5, the original fixed rate
+    Money minimumSpend;
+    std::vector<RewardBracket> brackets;
+    std::vector<RewardMultiplier> multipliers;
+};
+
+class RewardRules {
+public:
+    RewardRules();
+
+    bool load(const std::string& fileName);
+    bool compile(const RewardRuleSet& ruleSet);
+    int points(Money totalAmount, std::int64_t weightedAmount) const;
+    std::int64_t multiplier(ProductId productID) const;
+    std::int64_t weigh(Money amount, ProductId productID) const;
+    bool hasMultipliers() const;
+    void pointsBatch(const Money* amounts, int* points, std::size_t count) const;
+    void pointsBatch(const Money* amounts, int* points, std::size_t count, int batchPath) const;
+
+    static int bestBatchPath();
+
+private:
+    std::int64_t thresholds[rewardBracketSlots];  // Ascending bracket starts in cents; unused slots hold a value no total reaches
+    std::size_t thresholdCount = 0;               // How many of the thresholds are in use
+    std::int64_t rates[rewardBracketSlots + 1];   // rates[k] applies when exactly k thresholds have been reached
+    std::vector<std::int32_t> productMultipliers; // Indexed by product number, in hundredths
+    bool multipliersInEffect = false;             // The rules have at least one product or category multiplier
+    double batchThresholds[rewardBracketSlots];   // The thresholds and rates again as doubles, for the SIMD paths
+    double batchRates[rewardBracketSlots + 1];
+    bool batchExact = true;                       // Every rate is small enough for the SIMD paths to match points exactly
+};
+
+#endif // REWARDRULES_H
@@ -0,0 +1,240 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include "rewardsCatalog.h"
+#include "durableFile.h"
+#include "recordParser.h"
+
+/*
+****************************************************************************
+************************* REWARDS CATALOG START ****************************
+****************************************************************************
+*/
+
+/*
+Function Name: formatRewardRecord
+Purpose: Converts a reward record into the text layout used by the "rewardsList.txt" file.
+Meaning of Parameters:
+  - const RewardRecord& record: The reward record to format.
+Description of Return Values:
+  - Returns the formatted record, starting with the "Tier N, Reward M" header line and ending with a newline.
+*/
+std::string formatRewardRecord(const RewardRecord& record) {
+    return "Tier " + std::to_string(record.tier) + ", Reward " + std::to_string(record.rewardNumber) + "\n" +
+           "\tID: " + formatId(record.productID) + "\n" +
+           "\tName: " + record.name + "\n" +
+           "\tPoint Value: " + std::to_string(record.pointValue) + "\n" +
+           "\tInventory Count: " + std::to_string(record.inventory) + "\n";
+}
+
+/*
+Function Name: applyRewardField
+Purpose: Stores a single "Key: value" field read from "rewardsList.txt" into the matching attribute of a reward record.
+Meaning of Parameters:
+  - RewardRecord& record: The record being filled in.
+  - std::string_view line: A trimmed line from the rewards file.
+Description of Return Values:
+  - This function does not return a value. Lines that do not match a known field are ignored.
+  - Both "Inventory Count:" and "Inventory count:" are accepted, since the shipped list uses both spellings.
+*/
+static void applyRewardField(RewardRecord& record, std::string_view line) {
+    std::string_view value;
+    int inventory = 0;
+    if (fieldValue(line, "ID:", value)) {
+        parseProductId(value, record.productID);
+    } else if (fieldValue(line, "Name:", value)) {
+        record.name.assign(value);
+    } else if (fieldValue(line, "Point Value:", value)) {
+        parseNumber(value, record.pointValue);
+    } else if ((fieldValue(line, "Inventory Count:", value) || fieldValue(line, "Inventory count:", value)) && parseNumber(value, inventory)) {
+        record.inventory = inventory;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Function Name: parseRewardHeader
+Purpose: Parses a "Tier N, Reward M" header line.
+Meaning of Parameters:
+  - std::string_view line: A trimmed line from the rewards file.
+  - RewardRecord& header: Receives the tier and reward numbers.
+Description of Return Values:
+  - Returns `true` if the line is a reward header, `false` otherwise.
+*/
+static bool parseRewardHeader(std::string_view line, RewardRecord& header) {
+    std::string_view value;
+    std::size_t comma = line.find(',');
+    if (comma == std::string_view::npos || !fieldValue(line.substr(0, comma), "Tier ", value) || !parseNumber(value, header.tier)) {
+        return false;
+    } else {
+        return fieldValue(trimView(line.substr(comma + 1)), "Reward ", value) && parseNumber(value, header.rewardNumber);
+    }
+}
+
+/*
+Function Name: lessPointValue
+Purpose: Orders reward records by point value for sorting and binary searching the catalog.
+Meaning of Parameters:
+  - const RewardRecord& left: The first record to compare.
+  - const RewardRecord& right: The second record to compare.
+Description of Return Values:
+  - Returns `true` if `left` costs fewer points than `right`.
+*/
+static bool lessPointValue(const RewardRecord& left, const RewardRecord& right) {
+    return left.pointValue < right.pointValue;
+}
+
+/*
+Method Name: load
+Purpose: Parses the rewards file once into an array sorted by point value and builds the hash index from product ID to record.
+Meaning of Parameters:
+  - const std::string& fileName: The rewards file to read, normally "rewardsList.txt".
+Description of Return Values:
+  - Returns `true` if the file was read.
+  - Returns `false` if the file could not be opened; the catalog is left empty in that case.
+*/
+bool RewardsCatalog::load(const std::string& fileName) {
+    this->fileName = fileName;
+    records.clear();
+    index.clear();
+
+    std::string buffer;
+    if (!readWholeFile(fileName, buffer)) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    RecordParser parser(buffer);
+    std::string_view line;
+    // The while loop starts a new record at every "Tier N, Reward M" header and routes the following field lines into it.
+    while (parser.nextLine(line)) {
+        RewardRecord header;
+        if (parseRewardHeader(line, header)) {
+            records.push_back(header);
+        } else if (!records.empty()) {
+            applyRewardField(records.back(), line);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+
+    // Stable so rewards with the same cost keep their file order
+    std::stable_sort(records.begin(), records.end(), lessPointValue);
+    reindex();
+    return true;
+}
+
+/*
+Method Name: save
+Purpose: Rewrites the rewards file from the in-memory records, in point value order.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if the file was replaced.
+  - Returns `false` and outputs an error message if it could not be; the old file is kept in that case.
+*/
+bool RewardsCatalog::save() const {
+    std::lock_guard<std::mutex> guard(saveLock);
+    std::string contents;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        contents += formatRewardRecord(records[i]);
+    }
+    return replaceFile(fileName, contents);
+}
+
+/*
+Method Name: find
+Purpose: Looks up a reward record by its product ID.
+Meaning of Parameters:
+  - ProductId productID: The reward item to look up.
+Description of Return Values:
+  - Returns a pointer to the record if it exists, or `nullptr` if it does not.
+*/
+RewardRecord* RewardsCatalog::find(ProductId productID) {
+    std::unordered_map<ProductId, std::size_t>::const_iterator it = index.find(productID);
+    if (it == index.end()) {
+        return nullptr;
+    } else {
+        return &records[it->second];
+    }
+}
+
+/*
+Method Name: find (const)
+Purpose: Looks up a reward record by its product ID without allowing modification.
+Meaning of Parameters:
+  - ProductId productID: The reward item to look up.
+Description of Return Values:
+  - Returns a pointer to the record if it exists, or `nullptr` if it does not.
+*/
+const RewardRecord* RewardsCatalog::find(ProductId productID) const {
+    std::unordered_map<ProductId, std::size_t>::const_iterator it = index.find(productID);
+    if (it == index.end()) {
+        return nullptr;
+    } else {
+        return &records[it->second];
+    }
+}
+
+/*
+Method Name: affordableCount
+Purpose: Finds how many rewards a customer can afford by binary searching the point value order.
+Meaning of Parameters:
+  - int rewardPoints: The customer's reward point balance.
+Description of Return Values:
+  - Returns the number of leading records in all() whose point value is at most `rewardPoints`.
+*/
+std::size_t RewardsCatalog::affordableCount(int rewardPoints) const {
+    RewardRecord limit;
+    limit.pointValue = rewardPoints;
+    std::vector<RewardRecord>::const_iterator end = std::upper_bound(records.begin(), records.end(), limit, lessPointValue);
+    return static_cast<std::size_t>(end - records.begin());
+}
+
+/*
+Method Name: all
+Purpose: Gives read access to every reward record in point value order.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns a reference to the record list.
+*/
+const std::vector<RewardRecord>& RewardsCatalog::all() const {
+    return records;
+}
+
+/*
+Method Name: size
+Purpose: Reports how many reward records are currently in the catalog.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the number of records in the catalog.
+*/
+std::size_t RewardsCatalog::size() const {
+    return records.size();
+}
+
+/*
+Method Name: reindex
+Purpose: Rebuilds the hash index from product ID to position in the sorted record list.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value. It replaces the contents of the index.
+*/
+void RewardsCatalog::reindex() {
+    index.clear();
+    index.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        index[records[i].productID] = i;
+    }
+}
+
+/*
+****************************************************************************
+************************** REWARDS CATALOG END *****************************
+****************************************************************************
+*/
@@ -0,0 +1,43 @@
+#ifndef REWARDSCATALOG_H
+#define REWARDSCATALOG_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "inventoryCount.h"
+#include "recordId.h"
+
+/* Declarations for the in-memory rewards catalog backed by rewardsList.txt */
+
+struct RewardRecord {
+    int tier = 0;
+    int rewardNumber = 0;
+    ProductId productID{};
+    std::string name;
+    int pointValue = 0;
+    InventoryCount inventory;
+};
+
+class RewardsCatalog {
+public:
+    bool load(const std::string& fileName);
+    bool save() const;
+    RewardRecord* find(ProductId productID);
+    const RewardRecord* find(ProductId productID) const;
+    std::size_t affordableCount(int rewardPoints) const;
+    const std::vector<RewardRecord>& all() const;
+    std::size_t size() const;
+
+private:
+    std::string fileName = "rewardsList.txt";
+    std::vector<RewardRecord> records; // Sorted by point value
+    std::unordered_map<ProductId, std::size_t> index;
+    mutable std::mutex saveLock; // Concurrent redemptions each save; one rewrite runs at a time
+
+    void reindex();
+};
+
+std::string formatRewardRecord(const RewardRecord& record);
+
+#endif // REWARDSCATALOG_H
@@ -0,0 +1,766 @@
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "server.h"
+#include "cart.h"
+#include "customers.h"
+#include "globals.h"
+#include "products.h"
+#include "recordParser.h"
+#include "threadPool.h"
+#include "transactions.h"
+
+/*
+****************************************************************************
+***************************** SERVER START *********************************
+****************************************************************************
+*/
+
+// One request verb and the handler that serves it. The field counts include the verb itself.
+struct RequestHandler {
+    const char* verb;
+    std::size_t minFields;
+    std::size_t maxFields;
+    const char* usage;
+    std::string (*handle)(const std::vector<std::string_view>& fields);
+};
+
+// A stream buffer that accepts and drops everything written to it. It keeps no state, so worker threads can write to
+// it at once.
+class DiscardBuffer : public std::streambuf {
+protected:
+    int overflow(int character) override {
+        return traits_type::not_eof(character);
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+// One client connection. Requests may arrive split across reads or several to a read, and replies may not all
+// be sent at once, so both directions are buffered. Only one request per connection is on the thread pool at a
+// time, so a client that sends several requests gets its replies in the order it sent them.
+struct ClientConnection {
+    int fd = -1;
+    std::string input;         // Received bytes not yet handed to the pool
+    std::string output;        // Replies not yet sent
+    std::size_t pollIndex = 0; // The connection's entry in this round's poll set, or 0 if it was not polled
+    bool busy = false;         // A request from this connection is on the pool
+    bool closing = false;      // Close the connection once the output has been sent and no request is on the pool
+};
+
+// One request on its way through the pool: a worker fills in the reply, and the event loop sends it.
+struct ServerRequest {
+    int fd = -1; // The connection it came from
+    std::string line;
+    std::string reply;
+    bool closeConnection = false;
+    bool stopServer = false;
+};
+
+// Stop reading from a connection while this much of its input waits for the pool
+static const std::size_t maxBufferedInput = 16 * maxRequestLength;
+
+static volatile std::sig_atomic_t stopSignal = 0;
+
+// Requests the workers have finished, waiting for the event loop. A worker writes to the eventfd after adding one,
+// which wakes the event loop from poll.
+static std::mutex completionLock;
+static std::vector<ServerRequest*> completedRequests;
+static int completionSignal = -1;
+
+// Held while registering or removing an account: it covers the uniqueness checks, the Bloom filters, the customer
+// ID generator and customer_count.txt, which are shared by every account and not safe to change concurrently
+static std::mutex accountLock;
+
+/*
+Function Name: requestStop
+Purpose: Signal handler for SIGINT and SIGTERM; the event loop notices the flag and shuts down cleanly.
+Meaning of Parameters:
+  - int: The signal number (unused).
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void requestStop(int) {
+    stopSignal = 1;
+}
+
+/*
+Function Name: splitFields
+Purpose: Splits a request line into its space-separated fields. A trailing carriage return is treated as a space, so terminals that send CRLF work too.
+Meaning of Parameters:
+  - std::string_view line: The request, without its newline.
+  - std::vector<std::string_view>& fields: Receives the fields; they point into the line.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void splitFields(std::string_view line, std::vector<std::string_view>& fields) {
+    static const char* const separators = " \t\r";
+    std::size_t start = line.find_first_not_of(separators);
+    while (start != std::string_view::npos) {
+        std::size_t end = line.find_first_of(separators, start);
+        fields.push_back(line.substr(start, (end == std::string_view::npos) ? end : end - start));
+        start = line.find_first_not_of(separators, end);
+    }
+}
+
+/*
+Function Name: findCustomer
+Purpose: Parses a customer ID field and checks the customer store has it.
+Meaning of Parameters:
+  - std::string_view field: The customer ID, with or without its "CustID" prefix.
+  - CustomerId& customerID: Receives the parsed ID.
+Description of Return Values:
+  - Returns `true` if the customer exists.
+  - Returns `false` if the ID is malformed or no customer has it.
+*/
+static bool findCustomer(std::string_view field, CustomerId& customerID) {
+    return parseCustomerId(field, customerID) && customerStore.contains(customerID);
+}
+
+/*
+Function Name: handleRegister
+Purpose: Serves REGISTER <username> <first name> <last name> <age> <credit card>, with the same checks as the menu's account creation.
+Meaning of Parameters:
+  - const std::vector<std::string_view>& fields: The request fields.
+Description of Return Values:
+  - Returns "OK <customer ID>", or "ERR <reason>" if a field is invalid or the account could not be saved.
+*/
+static std::string handleRegister(const std::vector<std::string_view>& fields) {
+    std::string username(fields[1]);
+    std::string firstName(fields[2]);
+    std::string lastName(fields[3]);
+    std::string creditCard(fields[5]);
+    int age = -1;
+    std::lock_guard<std::mutex> guard(accountLock);
+    std::string problem = usernameProblem(username);
+    if (!problem.empty()) {
+        return "ERR " + problem;
+    } else if (!validateName(firstName) || !validateName(lastName)) {
+        return "ERR Invalid name. Only alphabetic characters allowed.";
+    } else if (!parseWholeNumber(fields[4], age) || !validateAge(age)) {
+        return "ERR Invalid age. Must be between 0 and 100.";
+    } else {
+        problem = creditCardProblem(creditCard);
+    }
+
+    if (!problem.empty()) {
+        return "ERR " + problem;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    CustomerId customerID = createAccount(username, firstName, lastName, age, creditCard);
+    return (customerID == CustomerId()) ? "ERR Account not created." : "OK " + formatId(customerID);
+}
+
+/*
+Function Name: handleRemove
+Purpose: Serves REMOVE <customer ID>.
+Meaning of Parameters:
+  - const std::vector<std::string_view>& fields: The request fields.
+Description of Return Values:
+  - Returns "OK", or "ERR <reason>" if the customer does not exist or the removal could not be saved.
+*/
+static std::string handleRemove(const std::vector<std::string_view>& fields) {
+    CustomerId customerID{};
+    std::lock_guard<std::mutex> guard(accountLock);
+    if (!findCustomer(fields[1], customerID)) {
+        return "ERR Customer not found.";
+    } else if (!removeAccount(formatId(customerID))) {
+        return "ERR Removal could not be saved.";
+    } else {
+        return "OK";
+    }
+}
+
+/*
+Function Name: addCartItem
+Purpose: Parses one "<product ID>[:<quantity>]" field of a PURCHASE request and adds it to the cart; the quantity defaults to 1.
+Meaning of Parameters:
+  - std::string_view item: The field.
+  - Cart& cart: The cart being filled.
+  - std::string& problem: Receives the reason if the item is rejected.
+Description of Return Values:
+  - Returns `true` if the item was added.
+  - Returns `false` otherwise; the cart is unchanged.
+*/
+static bool addCartItem(std::string_view item, Cart& cart, std::string& problem) {
+    std::size_t colon = item.find(':');
+    ProductId productID{};
+    int quantity = 1;
+    if (!parseProductId(item.substr(0, colon), productID)) {
+        problem = "Invalid product ID " + std::string(item.substr(0, colon)) + ".";
+    } else if (colon != std::string_view::npos && !parseWholeNumber(item.substr(colon + 1), quantity)) {
+        problem = "Invalid quantity in " + std::string(item) + ".";
+    } else {
+        problem = cart.problem(productID, quantity);
+    }
+    return problem.empty() && cart.add(productID, quantity);
+}
+
+/*
+Function Name: handlePurchase
+Purpose: Serves PURCHASE <customer ID> <product ID>[:<quantity>] ..., committing the cart the same way as the menu's transactions.
+Meaning of Parameters:
+  - const std::vector<std::string_view>& fields: The request fields.
+Description of Return Values:
+  - Returns "OK <transaction ID> <total> <points earned>", or "ERR <reason>" if the customer or any line item is invalid, a product ran out before the purchase could take it, or the transaction could not be saved.
+*/
+static std::string handlePurchase(const std::vector<std::string_view>& fields) {
+    CustomerId customerID{};
+    Cart cart;
+    std::string problem;
+    if (!findCustomer(fields[1], customerID)) {
+        return "ERR Customer not found.";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    // Every line item is checked before anything is written, so a rejected item leaves the stores untouched
+    for (std::size_t i = 2; i < fields.size(); ++i) {
+        if (!addCartItem(fields[i], cart, problem)) {
+            return "ERR " + problem;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+
+    int rewardPoints = rewardRules.points(cart.total(), cart.rewardAmount());
+    TransactionId transactionID = commitTransaction(customerID, cart, rewardPoints);
+    if (transactionID == TransactionId()) {
+        return "ERR Transaction canceled: a product ran out or the transaction could not be saved.";
+    } else {
+        return "OK " + formatId(transactionID) + " " + formatMoney(cart.total()) + " " + std::to_string(rewardPoints);
+    }
+}
+
+/*
+Function Name: handleLookup
+Purpose: Serves LOOKUP <customer ID>. The credit card number is never sent.
+Meaning of Parameters:
+  - const std::vector<std::string_view>& fields: The request fields.
+Description of Return Values:
+  - Returns "OK <customer ID> <username> <first name> <last name> <age> <points>", or "ERR <reason>" if the customer does not exist.
+*/
+static std::string handleLookup(const std::vector<std::string_view>& fields) {
+    CustomerId customerID{};
+    CustomerRecord record;
+    if (!parseCustomerId(fields[1], customerID) || !customerStore.copyRecord(customerID, record)) {
+        return "ERR Customer not found.";
+    } else {
+        return "OK " + formatId(customerID) + " " + record.username + " " + record.firstName + " " + record.lastName + " " +
+               std::to_string(record.age) + " " + std::to_string(record.rewardPoints);
+    }
+}
+
+/*
+Function Name: handleProduct
+Purpose: Serves PRODUCT <product ID> for both catalog products and reward products. The name goes last, since reward names may contain spaces.
+Meaning of Parameters:
+  - const std::vector<std::string_view>& fields: The request fields.
+Description of Return Values:
+  - Returns "OK product <price> <inventory> <name>" or "OK reward <points> <inventory> <name>", or "ERR <reason>" if neither catalog has the ID.
+*/
+static std::string handleProduct(const std::vector<std::string_view>& fields) {
+    ProductId productID{};
+    const ProductRecord* product = parseProductId(fields[1], productID) ? productCatalog.find(productID) : nullptr;
+    const RewardRecord* reward = rewardsCatalog.find(productID);
+    if (product != nullptr) {
+        return "OK product " + formatMoney(product->price) + " " + std::to_string(product->inventory) + " " + product->name;
+    } else if (reward != nullptr) {
+        return "OK reward " + std::to_string(reward->pointValue) + " " + std::to_string(reward->inventory) + " " + reward->name;
+    } else {
+        return "ERR Product not found.";
+    }
+}
+
+/*
+Function Name: handleRedeem
+Purpose: Serves REDEEM <customer ID> <reward product ID>, taking one unit of the reward and its points the same way as the menu's redemption.
+Meaning of Parameters:
+  - const std::vector<std::string_view>& fields: The request fields.
+Description of Return Values:
+  - Returns "OK <points left>", or "ERR <reason>" if the customer or reward does not exist, the customer has too few points or the reward is out of stock.
+*/
+static std::string handleRedeem(const std::vector<std::string_view>& fields) {
+    CustomerId customerID{};
+    ProductId rewardID{};
+    const RewardRecord* reward = parseProductId(fields[2], rewardID) ? rewardsCatalog.find(rewardID) : nullptr;
+    int balance = -1;
+    if (!parseCustomerId(fields[1], customerID) || !customerStore.contains(customerID)) {
+        return "ERR Customer not found.";
+    } else if (reward == nullptr) {
+        return "ERR Reward not found.";
+    } else if (!customerStore.spendRewardPoints(customerID, reward->pointValue, balance)) {
+        return "ERR Not enough points: the customer has " + std::to_string(balance) + " and the reward costs " +
+               std::to_string(reward->pointValue) + ".";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    // The points are taken first, so a concurrent redemption cannot spend them too; they go back if the stock ran out
+    if (!processInventoryAdjustment(rewardID, 1, 7)) {
+        customerStore.addRewardPoints(customerID, reward->pointValue, balance);
+        return "ERR Reward is out of stock.";
+    } else {
+        writeUpdatedCustomerData(customerID, -reward->pointValue, 7, formatId(rewardID));
+        return "OK " + std::to_string(balance);
+    }
+}
+
+static const RequestHandler requestHandlers[] = {
+    {"REGISTER", 6, 6, "REGISTER <username> <first name> <last name> <age> <credit card>", handleRegister},
+    {"REMOVE", 2, 2, "REMOVE <customer ID>", handleRemove},
+    {"PURCHASE", 3, 3 + 64, "PURCHASE <customer ID> <product ID>[:<quantity>] ...", handlePurchase},
+    {"LOOKUP", 2, 2, "LOOKUP <customer ID>", handleLookup},
+    {"PRODUCT", 2, 2, "PRODUCT <product ID>", handleProduct},
+    {"REDEEM", 3, 3, "REDEEM <customer ID> <reward product ID>", handleRedeem},
+};
+
+/*
+Function Name: handleRequest
+Purpose: Serves one request line of the protocol described in server.h.
+Meaning of Parameters:
+  - std::string_view line: The request, without its newline.
+  - bool& closeConnection: Set to `true` if the request was QUIT.
+  - bool& stopServer: Set to `true` if the request was SHUTDOWN.
+Description of Return Values:
+  - Returns the reply line, without its newline.
+*/
+std::string handleRequest(std::string_view line, bool& closeConnection, bool& stopServer) {
+    std::vector<std::string_view> fields;
+    splitFields(line, fields);
+    if (fields.empty()) {
+        return "ERR Empty request.";
+    } else {
+        closeConnection = (fields[0] == "QUIT");
+        stopServer = stopServer || (fields[0] == "SHUTDOWN");
+    }
+
+    if (closeConnection || fields[0] == "SHUTDOWN" || fields[0] == "PING") {
+        return "OK";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    for (std::size_t i = 0; i < sizeof(requestHandlers) / sizeof(requestHandlers[0]); ++i) {
+        const RequestHandler& handler = requestHandlers[i];
+        if (fields[0] == handler.verb && fields.size() >= handler.minFields && fields.size() <= handler.maxFields) {
+            return handler.handle(fields);
+        } else if (fields[0] == handler.verb) {
+            return std::string("ERR Usage: ") + handler.usage;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return "ERR Unknown request " + std::string(fields[0]) + ".";
+}
+
+/*
+Function Name: replaceStaleSocket
+Purpose: Clears the way to bind the socket path. A socket file left by a server that did not shut down cleanly refuses connections and is removed; a live server or a file that is not a socket is left alone.
+Meaning of Parameters:
+  - const sockaddr_un& address: The socket address.
+Description of Return Values:
+  - Returns `true` if the path is free to bind.
+  - Returns `false` and outputs an error message otherwise.
+*/
+static bool replaceStaleSocket(const sockaddr_un& address) {
+    struct stat info;
+    if (lstat(address.sun_path, &info) != 0) {
+        return true;
+    } else if (!S_ISSOCK(info.st_mode)) {
+        std::cerr << "Error: " << address.sun_path << " exists and is not a socket.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    bool listening = (probe >= 0 && connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+    close(probe);
+    if (listening) {
+        std::cerr << "Error: A server is already listening on " << address.sun_path << ".\n";
+        return false;
+    } else {
+        return unlink(address.sun_path) == 0 || errno == ENOENT;
+    }
+}
+
+/*
+Function Name: openListeningSocket
+Purpose: Creates the non-blocking listening socket. Only the owner may connect to it.
+Meaning of Parameters:
+  - const std::string& socketPath: The path to bind.
+Description of Return Values:
+  - Returns the socket's file descriptor.
+  - Returns -1 and outputs an error message if the path is too long or in use, or the socket cannot be bound.
+*/
+static int openListeningSocket(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: The socket path must be 1 to " << sizeof(address.sun_path) - 1 << " characters long.\n";
+        return -1;
+    } else {
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+    }
+
+    if (!replaceStaleSocket(address)) {
+        return -1;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener < 0 || bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 || listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "Error: Unable to listen on " << socketPath << ": " << std::strerror(errno) << "\n";
+        close(listener);
+        return -1;
+    } else {
+        return listener;
+    }
+}
+
+/*
+Function Name: acceptConnections
+Purpose: Accepts every connection waiting on the listening socket.
+Meaning of Parameters:
+  - int listener: The listening socket.
+  - std::unordered_map<int, ClientConnection>& connections: The open connections by file descriptor; new ones are added.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void acceptConnections(int listener, std::unordered_map<int, ClientConnection>& connections) {
+    int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    while (fd >= 0) {
+        connections[fd].fd = fd;
+        fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    }
+}
+
+/*
+Function Name: serveRequest
+Purpose: Runs on a pool worker: serves one request, then hands the reply back to the event loop and wakes it.
+Meaning of Parameters:
+  - void* argument: The ServerRequest; the event loop deletes it once the reply is queued.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void serveRequest(void* argument) {
+    ServerRequest* request = static_cast<ServerRequest*>(argument);
+    request->reply = handleRequest(request->line, request->closeConnection, request->stopServer);
+
+    std::unique_lock<std::mutex> guard(completionLock);
+    completedRequests.push_back(request);
+    guard.unlock();
+    std::uint64_t one = 1;
+    if (write(completionSignal, &one, sizeof(one)) < 0) {
+        std::cerr << "Error: Unable to wake the server loop: " << std::strerror(errno) << "\n";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Function Name: dispatchRequest
+Purpose: Hands a connection's next complete request line to the thread pool, unless one of its requests is already there.
+Meaning of Parameters:
+  - ClientConnection& connection: The connection.
+  - WorkStealingPool& pool: The pool that serves requests.
+Description of Return Values:
+  - This function does not return a value. A connection whose unfinished line is longer than maxRequestLength is sent an error and marked closing.
+*/
+static void dispatchRequest(ClientConnection& connection, WorkStealingPool& pool) {
+    std::size_t newline = connection.input.find('\n');
+    if (connection.busy || connection.closing) {
+        return;
+    } else if (newline == std::string::npos && connection.input.size() > maxRequestLength) {
+        connection.output += "ERR Request too long.\n";
+        connection.closing = true;
+        return;
+    } else if (newline == std::string::npos) {
+        return;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    ServerRequest* request = new ServerRequest();
+    request->fd = connection.fd;
+    request->line.assign(connection.input, 0, newline);
+    connection.input.erase(0, newline + 1);
+    connection.busy = true;
+    PoolTask task;
+    task.run = serveRequest;
+    task.argument = request;
+    pool.submit(task);
+}
+
+/*
+Function Name: collectReplies
+Purpose: Takes the requests the workers have finished and queues their replies on their connections.
+Meaning of Parameters:
+  - std::unordered_map<int, ClientConnection>& connections: The open connections by file descriptor.
+  - bool& stopServer: Set to `true` if a SHUTDOWN request was served.
+Description of Return Values:
+  - This function does not return a value. Each connection is free for its next request afterwards.
+*/
+static void collectReplies(std::unordered_map<int, ClientConnection>& connections, bool& stopServer) {
+    std::uint64_t signals = 0;
+    // Reading the eventfd resets it; it only wakes poll, and the vector below says what finished
+    if (read(completionSignal, &signals, sizeof(signals)) < 0 && errno != EAGAIN) {
+        std::cerr << "Error: Unable to read the server wake-up signal: " << std::strerror(errno) << "\n";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    std::vector<ServerRequest*> finished;
+    std::unique_lock<std::mutex> guard(completionLock);
+    finished.swap(completedRequests);
+    guard.unlock();
+    for (std::size_t i = 0; i < finished.size(); ++i) {
+        // A connection is never closed while busy, so the one the request came from is still open
+        ClientConnection& connection = connections[finished[i]->fd];
+        connection.output += finished[i]->reply;
+        connection.output += '\n';
+        connection.busy = false;
+        connection.closing = connection.closing || finished[i]->closeConnection;
+        stopServer = stopServer || finished[i]->stopServer;
+        delete finished[i];
+    }
+}
+
+/*
+Function Name: readInput
+Purpose: Reads what a client has sent onto the end of its input buffer.
+Meaning of Parameters:
+  - ClientConnection& connection: The connection to read.
+Description of Return Values:
+  - This function does not return a value. The connection is marked closing when the client hangs up.
+*/
+static void readInput(ClientConnection& connection) {
+    char buffer[16384];
+    ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+    if (received > 0) {
+        connection.input.append(buffer, static_cast<std::size_t>(received));
+    } else {
+        connection.closing = connection.closing || received == 0 || (errno != EAGAIN && errno != EINTR);
+    }
+}
+
+/*
+Function Name: writeReplies
+Purpose: Sends as much of a connection's queued replies as the socket takes without blocking.
+Meaning of Parameters:
+  - ClientConnection& connection: The connection to write.
+Description of Return Values:
+  - This function does not return a value. If the client has gone away, the replies are dropped and the connection is marked closing.
+*/
+static void writeReplies(ClientConnection& connection) {
+    ssize_t sent = send(connection.fd, connection.output.data(), connection.output.size(), MSG_NOSIGNAL);
+    if (sent > 0) {
+        connection.output.erase(0, static_cast<std::size_t>(sent));
+    } else if (errno != EAGAIN && errno != EINTR) {
+        connection.output.clear();
+        connection.closing = true;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Function Name: buildPollSet
+Purpose: Lists what poll should wait for this round: the listener, the workers' wake-up signal and each connection that can make progress.
+Meaning of Parameters:
+  - int listener: The listening socket.
+  - std::unordered_map<int, ClientConnection>& connections: The open connections; each one's pollIndex is set.
+  - std::vector<pollfd>& pollSet: Receives the poll entries.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void buildPollSet(int listener, std::unordered_map<int, ClientConnection>& connections, std::vector<pollfd>& pollSet) {
+    pollSet.assign(1, pollfd{listener, POLLIN, 0});
+    pollSet.push_back(pollfd{completionSignal, POLLIN, 0});
+    for (std::unordered_map<int, ClientConnection>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        ClientConnection& connection = it->second;
+        // A closing connection with nothing to send is only waiting for the pool, and poll would report its hang-up every round
+        bool reading = !connection.closing && connection.input.size() <= maxBufferedInput;
+        short events = static_cast<short>((reading ? POLLIN : 0) | (connection.output.empty() ? 0 : POLLOUT));
+        connection.pollIndex = (events != 0) ? pollSet.size() : 0;
+        if (events != 0) {
+            pollSet.push_back(pollfd{connection.fd, events, 0});
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: serviceConnections
+Purpose: Reads every connection poll reported ready, hands each idle connection its next request, sends queued replies and closes the connections that are finished.
+Meaning of Parameters:
+  - const std::vector<pollfd>& pollSet: The poll results.
+  - std::unordered_map<int, ClientConnection>& connections: The open connections by file descriptor.
+  - WorkStealingPool& pool: The pool that serves requests.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void serviceConnections(const std::vector<pollfd>& pollSet, std::unordered_map<int, ClientConnection>& connections, WorkStealingPool& pool) {
+    std::unordered_map<int, ClientConnection>::iterator it = connections.begin();
+    while (it != connections.end()) {
+        ClientConnection& connection = it->second;
+        if (connection.pollIndex != 0 && (pollSet[connection.pollIndex].revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+            readInput(connection);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+        dispatchRequest(connection, pool);
+        // Replies are sent straight away rather than on the next poll round; a full socket keeps the rest for POLLOUT
+        if (!connection.output.empty()) {
+            writeReplies(connection);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+
+        if (connection.closing && connection.output.empty() && !connection.busy) {
+            close(connection.fd);
+            it = connections.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/*
+Function Name: stopConnections
+Purpose: Shuts the server's connections down: waits for the requests already on the pool, sends what replies the sockets take without blocking, and closes every connection.
+Meaning of Parameters:
+  - std::unordered_map<int, ClientConnection>& connections: The open connections by file descriptor.
+  - WorkStealingPool& pool: The pool that serves requests.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void stopConnections(std::unordered_map<int, ClientConnection>& connections, WorkStealingPool& pool) {
+    bool stopServer = true;
+    pool.wait();
+    collectReplies(connections, stopServer);
+    for (std::unordered_map<int, ClientConnection>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        if (!it->second.output.empty()) {
+            writeReplies(it->second);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+        close(it->first);
+    }
+    connections.clear();
+
+    PoolStats stats = pool.stats();
+    std::cerr << "Requests served: " << stats.executed << ", stolen from another thread's queue: " << stats.stolen << "\n";
+}
+
+/*
+Function Name: stopPersistence
+Purpose: Writes every change the persistence queue still holds, stops its writer thread and closes the transaction log, which stores the transaction counter.
+Meaning of Parameters:
+  - const DurabilityPolicy& durability: The policy the server ran with.
+Description of Return Values:
+  - This function does not return a value. It reports how transactions were group committed and, under a write-behind policy, how the changes were batched.
+*/
+static void stopPersistence(const DurabilityPolicy& durability) {
+    persistenceQueue.stop();
+    transactionLog.close();
+    PersistenceStats stats = persistenceQueue.stats();
+    if (durability.mode != DurabilityMode::EveryOperation) {
+        std::cerr << "Changes written behind: " << stats.operations << " in " << stats.batches << " batches (" << stats.fileWrites
+                  << " file writes, " << stats.failedWrites << " failed, " << stats.retried << " changes retried, "
+                  << stats.abandoned << " lost)\n";
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    TransactionLogStats log = transactionLog.stats();
+    std::cerr << "Transaction log appends: " << log.appends << " in " << log.commits << " commits (" << log.failedCommits << " failed)\n"
+              << "  Appends per commit: " << log.batchSizes.describe() << "\n"
+              << "  Commit latency (us): " << log.commitLatency.describe() << "\n";
+}
+
+/*
+Function Name: runServer
+Purpose: Serves requests on a Unix domain socket until a SHUTDOWN request, SIGINT or SIGTERM. The stores must already be loaded. One thread runs the poll loop for every connection and hands complete request lines to a work-stealing thread pool, so requests from different connections run concurrently while each connection's requests run one after another in the order they were sent.
+Meaning of Parameters:
+  - const std::string& socketPath: The path of the socket to create.
+  - std::size_t threadCount: How many threads serve requests; 0 uses one per CPU core.
+  - const DurabilityPolicy& durability: When changes are written to the data files; under a write-behind policy a request is answered once its changes are made in memory and queued.
+Description of Return Values:
+  - Returns `true` after a clean shutdown.
+  - Returns `false` and outputs an error message if the socket could not be opened or polled.
+*/
+bool runServer(const std::string& socketPath, std::size_t threadCount, const DurabilityPolicy& durability) {
+    int listener = openListeningSocket(socketPath);
+    completionSignal = (listener >= 0) ? eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) : -1;
+    if (listener < 0) {
+        return false;
+    } else if (completionSignal < 0) {
+        std::cerr << "Error: Unable to create the server wake-up signal: " << std::strerror(errno) << "\n";
+        close(listener);
+        unlink(socketPath.c_str());
+        return false;
+    } else {
+        std::signal(SIGINT, requestStop);
+        std::signal(SIGTERM, requestStop);
+    }
+
+    // The shared record code confirms every change on std::cout for the menu; a server has no one to show it to, so
+    // std::cout writes into a buffer that drops it until the server stops. The stream itself stays in a good state.
+    DiscardBuffer discard;
+    std::streambuf* menuOutput = std::cout.rdbuf(&discard);
+    // Saving once drops the catalog's removed records, so no purchase's save moves a record another thread is using
+    productCatalog.save();
+    persistenceQueue.start(durability);
+    WorkStealingPool pool(threadCount);
+    std::cerr << "Serving requests on " << socketPath << " until SHUTDOWN, SIGINT or SIGTERM. Request threads: " << pool.stats().threads
+              << ", changes written " << describeDurabilityPolicy(durability) << "\n";
+    std::unordered_map<int, ClientConnection> connections;
+    std::vector<pollfd> pollSet;
+    bool stopServer = false;
+    bool polled = true;
+    while (polled && !stopServer && stopSignal == 0) {
+        buildPollSet(listener, connections, pollSet);
+        polled = poll(pollSet.data(), pollSet.size(), -1) >= 0 || errno == EINTR;
+        collectReplies(connections, stopServer);
+        serviceConnections(pollSet, connections, pool);
+        acceptConnections(listener, connections);
+    }
+
+    stopConnections(connections, pool);
+    stopPersistence(durability);
+    close(completionSignal);
+    close(listener);
+    unlink(socketPath.c_str());
+    customerStore.waitForCompaction();
+    std::cout.rdbuf(menuOutput);
+    std::cerr << (polled ? "Server stopped.\n" : "Error: Unable to poll the server socket.\n");
+    return polled;
+}
+
+/*
+****************************************************************************
+****************************** SERVER END **********************************
+****************************************************************************
+*/
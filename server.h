@@ -0,0 +1,29 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include <string_view>
+#include "persistenceQueue.h"
+
+/* Declarations for the long-running server mode (app --serve) and its line protocol over a Unix domain socket */
+
+// The socket app --serve listens on, and client connects to, when no other path is given.
+static const char defaultSocketPath[] = "app.sock";
+
+// Requests and replies are single lines of space-separated fields. Every reply starts with "OK" or "ERR":
+//   REGISTER <username> <first name> <last name> <age> <credit card>   -> OK <customer ID>
+//   REMOVE <customer ID>                                             -> OK
+//   PURCHASE <customer ID> <product ID>[:<quantity>] ...             -> OK <transaction ID> <total> <points earned>
+//   LOOKUP <customer ID>                                             -> OK <customer ID> <username> <first> <last> <age> <points>
+//   PRODUCT <product ID>                                             -> OK product <price> <inventory> <name>
+//                                                                       OK reward <points> <inventory> <name>
+//   REDEEM <customer ID> <reward product ID>                         -> OK <points left>
+//   PING -> OK, QUIT -> OK and the server closes the connection, SHUTDOWN -> OK and the server stops.
+// A failed request gets "ERR <reason>"; nothing is changed in that case. Requests on different connections may be
+// served concurrently; each connection's replies come back in the order its requests were sent.
+static const std::size_t maxRequestLength = 4096;
+
+std::string handleRequest(std::string_view line, bool& closeConnection, bool& stopServer);
+bool runServer(const std::string& socketPath, std::size_t threadCount, const DurabilityPolicy& durability);
+
+#endif // SERVER_H
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include "threadPool.h"
+
+/*
+****************************************************************************
+***************************** THREAD POOL START ****************************
+****************************************************************************
+*/
+
+// The pool and queue the current thread works for, so a task submitted by a worker goes on its own queue
+static thread_local const WorkStealingPool* currentPool = nullptr;
+static thread_local std::size_t currentWorker = 0;
+
+/*
+Method Name: WorkStealingPool
+Purpose: Starts the worker threads, each with an empty queue.
+Meaning of Parameters:
+  - std::size_t threadCount: How many workers to start; 0 starts one per CPU core.
+Description of Return Values:
+  - None.
+*/
+WorkStealingPool::WorkStealingPool(std::size_t threadCount) {
+    std::size_t count = (threadCount > 0) ? threadCount : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    for (std::size_t i = 0; i < count; ++i) {
+        queues.push_back(std::unique_ptr<PoolQueue>(new PoolQueue()));
+    }
+    // The queues must all exist before any worker starts looking through them for work to steal
+    for (std::size_t i = 0; i < count; ++i) {
+        workers.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+    }
+}
+
+/*
+Method Name: ~WorkStealingPool
+Purpose: Lets the workers finish every task already submitted, then stops and joins them.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+WorkStealingPool::~WorkStealingPool() {
+    std::unique_lock<std::mutex> sleep(sleepLock);
+    stopping = true;
+    sleep.unlock();
+    wakeWorkers.notify_all();
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+/*
+Method Name: submit
+Purpose: Queues a task. From a worker of this pool it goes on that worker's own queue; from any other thread, on the next queue in turn. One sleeping worker is woken for it.
+Meaning of Parameters:
+  - PoolTask task: The task to run.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void WorkStealingPool::submit(PoolTask task) {
+    std::size_t target = (currentPool == this) ? currentWorker : nextQueue.fetch_add(1) % queues.size();
+    std::unique_lock<std::mutex> queueGuard(queues[target]->lock);
+    queues[target]->tasks.push_back(task);
+    queueGuard.unlock();
+
+    // The task is counted only once it is on a queue, so a worker that claims it is sure to find it
+    std::unique_lock<std::mutex> sleep(sleepLock);
+    ++unclaimedTasks;
+    ++unfinishedTasks;
+    sleep.unlock();
+    wakeWorkers.notify_one();
+}
+
+/*
+Method Name: wait
+Purpose: Blocks until every task submitted so far has finished.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> sleep(sleepLock);
+    while (unfinishedTasks > 0) {
+        allDone.wait(sleep);
+    }
+}
+
+/*
+Method Name: stats
+Purpose: Reports how much work the pool has done and how much of it was stolen.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the number of workers and the counts of tasks run and tasks stolen.
+*/
+PoolStats WorkStealingPool::stats() const {
+    PoolStats result;
+    result.threads = workers.size();
+    result.executed = executed.load();
+    result.stolen = stolen.load();
+    return result;
+}
+
+/*
+Method Name: claimTask
+Purpose: Sleeps until there is a task no other worker has claimed, then claims it.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns `true` if a task was claimed; the caller must then take one from the queues.
+  - Returns `false` once the pool is stopping and every task has been claimed.
+*/
+bool WorkStealingPool::claimTask() {
+    std::unique_lock<std::mutex> sleep(sleepLock);
+    while (unclaimedTasks == 0 && !stopping) {
+        wakeWorkers.wait(sleep);
+    }
+
+    if (unclaimedTasks == 0) {
+        return false;
+    } else {
+        --unclaimedTasks;
+        return true;
+    }
+}
+
+/*
+Method Name: takeTask
+Purpose: Takes the newest task from the worker's own queue, or else steals the oldest task from the first other queue that has one.
+Meaning of Parameters:
+  - std::size_t self: The worker's number.
+  - PoolTask& task: Receives the task.
+Description of Return Values:
+  - Returns `true` if a task was taken.
+  - Returns `false` if every queue was empty when it was looked at.
+*/
+bool WorkStealingPool::takeTask(std::size_t self, PoolTask& task) {
+    // The for loop looks at the worker's own queue first (offset 0), then at each other queue in turn
+    for (std::size_t offset = 0; offset < queues.size(); ++offset) {
+        PoolQueue& queue = *queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> queueGuard(queue.lock);
+        if (queue.tasks.empty()) {
+            continue;
+        } else if (offset == 0) {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        } else {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            stolen.fetch_add(1);
+        }
+        return true;
+    }
+    return false;
+}
+
+/*
+Method Name: workerLoop
+Purpose: The body of each worker thread: claims a task, takes it from the queues and runs it, until the pool stops.
+Meaning of Parameters:
+  - std::size_t self: The worker's number, which is also the index of its queue.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void WorkStealingPool::workerLoop(std::size_t self) {
+    currentPool = this;
+    currentWorker = self;
+    PoolTask task;
+    while (claimTask()) {
+        // A claimed task is on some queue, but another worker can take it first, leaving this worker a different one
+        while (!takeTask(self, task)) {
+            std::this_thread::yield();
+        }
+        task.run(task.argument);
+        executed.fetch_add(1);
+
+        std::unique_lock<std::mutex> sleep(sleepLock);
+        --unfinishedTasks;
+        if (unfinishedTasks == 0) {
+            allDone.notify_all();
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+****************************************************************************
+****************************** THREAD POOL END *****************************
+****************************************************************************
+*/
@@ -0,0 +1,68 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Declarations for the work-stealing thread pool that runs the server's requests */
+
+// One unit of work: a function and the argument to call it with. Whoever submits the task keeps the argument
+// alive until the function has run.
+struct PoolTask {
+    void (*run)(void* argument) = nullptr;
+    void* argument = nullptr;
+};
+
+struct PoolStats {
+    std::size_t threads = 0;
+    std::uint64_t executed = 0;
+    std::uint64_t stolen = 0; // Tasks run by a different worker than the one whose queue they were put on
+};
+
+// One worker's task queue.
+struct PoolQueue {
+    std::mutex lock;
+    std::deque<PoolTask> tasks;
+};
+
+// A fixed set of worker threads, each with its own task queue. Tasks submitted from outside the pool are dealt
+// to the queues in turn; a task submitted by a worker goes on that worker's own queue. A worker runs the newest
+// task on its own queue first, since it is the most likely to still be in its cache, and once its queue is empty
+// it steals the oldest task from another worker's queue before going to sleep. A slow task therefore holds up
+// only itself: the tasks queued behind it are taken by whichever workers are free.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(std::size_t threadCount);
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    ~WorkStealingPool();
+
+    void submit(PoolTask task);
+    void wait();
+    PoolStats stats() const;
+
+private:
+    std::vector<std::unique_ptr<PoolQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> nextQueue{0};
+    std::atomic<std::uint64_t> executed{0};
+    std::atomic<std::uint64_t> stolen{0};
+    std::mutex sleepLock;
+    std::condition_variable wakeWorkers; // Signalled when a task is queued or the pool is stopping
+    std::condition_variable allDone;     // Signalled when the last unfinished task finishes
+    std::size_t unclaimedTasks = 0;      // Queued tasks no worker has claimed yet; guarded by sleepLock
+    std::size_t unfinishedTasks = 0;     // Submitted tasks that have not finished; guarded by sleepLock
+    bool stopping = false;               // Guarded by sleepLock
+
+    void workerLoop(std::size_t self);
+    bool claimTask();
+    bool takeTask(std::size_t self, PoolTask& task);
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,14 @@
+#ifndef TOMBSTONELOG_H
+#define TOMBSTONELOG_H
+
+#include <string>
+#include <unordered_set>
+
+/* Declarations for the removal logs (customers.removed.txt, products.removed.txt) that hide deleted records until the next compaction */
+
+std::string tombstoneFileName(const std::string& dataFileName);
+bool appendTombstone(const std::string& fileName, const std::string& id);
+void readTombstones(const std::string& fileName, std::unordered_set<std::string>& ids);
+bool isTombstoned(const std::string& dataFileName, const std::string& id);
+
+#endif // TOMBSTONELOG_H
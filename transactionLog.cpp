@@ -0,0 +1,309 @@
+#include <algorithm>
+#include <iostream>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "transactionLog.h"
+#include "transactions.h"
+
+/*
+****************************************************************************
+*************************** TRANSACTION LOG START **************************
+****************************************************************************
+*/
+
+/*
+Method Name: add
+Purpose: Counts one value in its power-of-two bucket.
+Meaning of Parameters:
+  - std::uint64_t value: The value.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void CommitHistogram::add(std::uint64_t value) {
+    std::size_t bucket = 0;
+    while (value > 1 && bucket + 1 < bucketCount) {
+        value >>= 1;
+        ++bucket;
+    }
+    ++counts[bucket];
+}
+
+/*
+Method Name: total
+Purpose: Counts every value added.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the number of values in all buckets.
+*/
+std::uint64_t CommitHistogram::total() const {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        sum += counts[i];
+    }
+    return sum;
+}
+
+/*
+Method Name: describe
+Purpose: Lists the non-empty buckets for a report, e.g. "0-1: 40, 2-3: 12, 4-7: 3".
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the list, or "none" if no value was added.
+*/
+std::string CommitHistogram::describe() const {
+    std::string text;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        std::uint64_t low = (i == 0) ? 0 : (1ULL << i);
+        std::uint64_t high = (2ULL << i) - 1;
+        std::string range = std::to_string(low) + "-" + std::to_string(high);
+        text += (counts[i] == 0) ? "" : (text.empty() ? "" : ", ") + range + ": " + std::to_string(counts[i]);
+    }
+    return text.empty() ? "none" : text;
+}
+
+/*
+Function Name: writeAll
+Purpose: Writes a list of buffers to a file with as few writev calls as the system allows, finishing any partial write.
+Meaning of Parameters:
+  - int fd: The file, opened for appending.
+  - std::vector<iovec>& pieces: The buffers, in order; advanced past what has been written.
+Description of Return Values:
+  - Returns `true` if everything was written.
+  - Returns `false` if a write failed; errno says why.
+*/
+static bool writeAll(int fd, std::vector<iovec>& pieces) {
+    std::size_t first = 0;
+    while (first < pieces.size()) {
+        int count = static_cast<int>(std::min<std::size_t>(pieces.size() - first, IOV_MAX));
+        ssize_t written = writev(fd, &pieces[first], count);
+        if (written < 0 && errno != EINTR) {
+            return false;
+        } else {
+            written = std::max<ssize_t>(written, 0);
+        }
+        // Skip the buffers written in full, then the written part of the next one
+        std::size_t left = static_cast<std::size_t>(written);
+        while (first < pieces.size() && left >= pieces[first].iov_len) {
+            left -= pieces[first].iov_len;
+            ++first;
+        }
+        if (left > 0) {
+            pieces[first].iov_base = static_cast<char*>(pieces[first].iov_base) + left;
+            pieces[first].iov_len -= left;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return true;
+}
+
+/*
+Method Name: TransactionLog
+Purpose: Sets up a log for a file; the file is opened by the first append.
+Meaning of Parameters:
+  - const std::string& fileName: The log file, normally "transactions.txt".
+Description of Return Values:
+  - None.
+*/
+TransactionLog::TransactionLog(const std::string& fileName) : fileName(fileName) {
+}
+
+/*
+Method Name: ~TransactionLog
+Purpose: Closes the log file.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - None.
+*/
+TransactionLog::~TransactionLog() {
+    close();
+}
+
+/*
+Method Name: append
+Purpose: Appends one or more formatted transaction records from a caller that is the only one numbering them, e.g. the write-behind writer or the batch ingest.
+Meaning of Parameters:
+  - const std::string& record: The records, as formatted by formatTransactionRecord.
+  - int transactionCount: The counter value once they are on disk, i.e. the next transaction number; 0 leaves the counter alone.
+Description of Return Values:
+  - Returns `true` if the records were written and synced.
+  - Returns `false` and outputs an error message if the commit carrying them failed.
+*/
+bool TransactionLog::append(const std::string& record, int transactionCount) {
+    std::unique_lock<std::mutex> unordered;
+    return append(record, transactionCount, unordered);
+}
+
+/*
+Method Name: append
+Purpose: Appends one or more formatted transaction records and returns once they are on disk, sharing the write and the fdatasync with whatever other threads append at the same time. Records are written in the order they join the queue, so callers that number records keep holding the lock they number under until the record has joined.
+Meaning of Parameters:
+  - const std::string& record: The records, as formatted by formatTransactionRecord.
+  - int transactionCount: The counter value once they are on disk, i.e. the next transaction number; 0 leaves the counter alone.
+  - std::unique_lock<std::mutex>& order: The caller's hold on the lock its transaction numbers were issued under; released once the record is queued, before the commit is waited for. It may hold no lock.
+Description of Return Values:
+  - Returns `true` if the records were written and synced.
+  - Returns `false` and outputs an error message if the commit carrying them failed.
+*/
+bool TransactionLog::append(const std::string& record, int transactionCount, std::unique_lock<std::mutex>& order) {
+    bool written = false;
+    std::unique_lock<std::mutex> guard(lock);
+    std::uint64_t ticket = ++lastTicket;
+    waiting.push_back(PendingRecord{&record, transactionCount, ticket, std::chrono::steady_clock::now(), &written});
+    if (order.owns_lock()) {
+        order.unlock();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    // Each pass either leads a commit of everything waiting, or sleeps through someone else's
+    while (ticket > committedTicket) {
+        if (!committing) {
+            std::vector<PendingRecord> batch;
+            batch.swap(waiting);
+            std::uint64_t lastTicketInBatch = batch.back().ticket;
+            committing = true;
+            guard.unlock();
+            bool succeeded = commit(batch);
+            guard.lock();
+            finishCommit(batch, succeeded);
+            committedTicket = lastTicketInBatch;
+            committing = false;
+            committed.notify_all();
+        } else {
+            committed.wait(guard);
+        }
+    }
+    return written;
+}
+
+/*
+Method Name: commit
+Purpose: Runs on the leader without the lock: writes a batch of records in the order they were queued with writev and syncs the file with fdatasync. Nothing else is written, so each commit costs one sync. The file size is noted first, so a write that fails partway can be cut off again.
+Meaning of Parameters:
+  - const std::vector<PendingRecord>& batch: The records, in transaction number order.
+Description of Return Values:
+  - Returns `true` if the batch is on disk.
+  - Returns `false` and outputs an error message otherwise; none of the batch stays in the file, and no later commit is written until the part that did reach it is cut off.
+*/
+bool TransactionLog::commit(const std::vector<PendingRecord>& batch) {
+    std::vector<iovec> pieces(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        pieces[i].iov_base = const_cast<char*>(batch[i].text->data());
+        pieces[i].iov_len = batch[i].text->size();
+    }
+
+    fd = (fd >= 0) ? fd : open(fileName.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    // Records left by an earlier failed commit must be gone before new ones are appended after them
+    bool clean = fd >= 0 && (tornAt < 0 || ftruncate(fd, tornAt) == 0);
+    off_t size = clean ? lseek(fd, 0, SEEK_END) : -1;
+    tornAt = clean ? -1 : tornAt;
+    bool succeeded = size >= 0 && writeAll(fd, pieces) && fdatasync(fd) == 0;
+    if (!succeeded) {
+        std::cerr << "Error: Could not write to " << fileName << " file: " << std::strerror(errno) << "\n";
+        discardFailedWrite(size);
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    return succeeded;
+}
+
+/*
+Method Name: discardFailedWrite
+Purpose: Runs on the leader after a failed commit: truncates the file back to its size before the commit, so no part of the failed records stays behind to be counted by readTransactionCount or followed by the next commit.
+Meaning of Parameters:
+  - off_t size: The file size before the commit, or -1 if nothing was written.
+Description of Return Values:
+  - This method does not return a value. If the truncation fails the file is closed, and the next commit reopens it and truncates it before writing.
+*/
+void TransactionLog::discardFailedWrite(off_t size) {
+    tornAt = (tornAt >= 0) ? tornAt : size;
+    if (fd >= 0 && tornAt >= 0 && ftruncate(fd, tornAt) == 0) {
+        tornAt = -1;
+    } else if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: finishCommit
+Purpose: Runs on the leader with the lock held: tells each record's thread how the commit went, notes the highest counter value committed and adds the commit to the statistics.
+Meaning of Parameters:
+  - const std::vector<PendingRecord>& batch: The committed records.
+  - bool succeeded: Whether the commit succeeded.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void TransactionLog::finishCommit(const std::vector<PendingRecord>& batch, bool succeeded) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        *batch[i].written = succeeded;
+        committedCount = succeeded ? std::max(committedCount, batch[i].transactionCount) : committedCount;
+        counters.commitLatency.add(std::chrono::duration_cast<std::chrono::microseconds>(now - batch[i].arrived).count());
+    }
+    counters.appends += batch.size();
+    ++counters.commits;
+    counters.failedCommits += succeeded ? 0 : 1;
+    counters.batchSizes.add(batch.size());
+}
+
+/*
+Method Name: close
+Purpose: Closes the log file once no commit is running, cuts off what is left of a failed commit that could not be truncated before, and stores the transaction counter in "transaction_count.txt" if commits have raised it; the next append opens the file again. Runs at shutdown, so the counter costs one file replacement per run rather than one per commit.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - This method does not return a value.
+*/
+void TransactionLog::close() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (committing) {
+        committed.wait(guard);
+    }
+    if (tornAt >= 0 && truncate(fileName.c_str(), tornAt) == 0) {
+        tornAt = -1;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+    if (committedCount > storedCount) {
+        updateTransactionCount(committedCount);
+        storedCount = committedCount;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+}
+
+/*
+Method Name: stats
+Purpose: Reports how the log has been committed.
+Meaning of Parameters:
+  - None.
+Description of Return Values:
+  - Returns the append and commit counts and the batch size and latency histograms.
+*/
+TransactionLogStats TransactionLog::stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return counters;
+}
+
+/*
+****************************************************************************
+**************************** TRANSACTION LOG END ***************************
+****************************************************************************
+*/
@@ -0,0 +1,84 @@
+#ifndef TRANSACTIONLOG_H
+#define TRANSACTIONLOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+/* Declarations for the group-committed transaction log (transactions.txt) */
+
+// Counts values in power-of-two buckets: bucket 0 holds 0 and 1, bucket i holds 2^i up to 2^(i+1) - 1.
+class CommitHistogram {
+public:
+    static const std::size_t bucketCount = 32;
+
+    void add(std::uint64_t value);
+    std::uint64_t total() const;
+    std::string describe() const;
+
+private:
+    std::uint64_t counts[bucketCount] = {};
+};
+
+struct TransactionLogStats {
+    std::uint64_t appends = 0;       // A write-behind batch or an ingest of many transactions is one append
+    std::uint64_t commits = 0;       // writev + fdatasync rounds
+    std::uint64_t failedCommits = 0;
+    CommitHistogram batchSizes;      // Appends per commit
+    CommitHistogram commitLatency;   // Microseconds from an append being handed in to it being on disk
+};
+
+// One record waiting for a commit. It lives on the stack of the thread that appended it, which waits until the
+// commit that carries it is done.
+struct PendingRecord {
+    const std::string* text;
+    int transactionCount;            // The counter value once the record is on disk
+    std::uint64_t ticket;            // Order of arrival, which is transaction number order; commits keep it
+    std::chrono::steady_clock::time_point arrived;
+    bool* written;                   // Set by the committing thread
+};
+
+// Appends transaction records to the log with group commit. The file stays open. A thread that appends while no
+// commit is running becomes the leader: it takes every record waiting, writes them with one writev and makes them
+// durable with one fdatasync. Threads that append during that commit wait,
+// and the next leader commits all of them together, so under load each fdatasync covers many purchases and a
+// lone purchase is never held back waiting for company. The counter in "transaction_count.txt" is kept out of the
+// commits and only stored by close(); the log itself is the durable record of the last number (see
+// readTransactionCount). A commit that fails is cut back off the end of the file before anything else is written,
+// so a refunded purchase never stays in the log.
+class TransactionLog {
+public:
+    TransactionLog(const std::string& fileName);
+    TransactionLog(const TransactionLog&) = delete;
+    TransactionLog& operator=(const TransactionLog&) = delete;
+    ~TransactionLog();
+
+    bool append(const std::string& record, int transactionCount);
+    bool append(const std::string& record, int transactionCount, std::unique_lock<std::mutex>& order);
+    void close();
+    TransactionLogStats stats() const;
+
+private:
+    std::string fileName;
+    int fd = -1;
+    off_t tornAt = -1;                   // Where a failed commit's partial records start, until they are cut off; only the leader uses it
+    mutable std::mutex lock;
+    std::condition_variable committed;   // Signalled when a commit finishes
+    std::vector<PendingRecord> waiting;  // Guarded by lock, as are the fields below
+    std::uint64_t lastTicket = 0;
+    std::uint64_t committedTicket = 0;   // Every record up to this ticket has been committed or has failed
+    bool committing = false;
+    TransactionLogStats counters;
+    int committedCount = 0;              // The highest counter value committed so far
+    int storedCount = 0;                 // The counter value close() last stored
+
+    bool commit(const std::vector<PendingRecord>& batch);
+    void finishCommit(const std::vector<PendingRecord>& batch, bool succeeded);
+    void discardFailedWrite(off_t size);
+};
+
+#endif // TRANSACTIONLOG_H
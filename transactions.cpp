@@ -9,10 +9,16 @@
 #include <unordered_set>
 #include <cctype>
 #include <iomanip>
+#include <mutex>
 #include "transactions.h"
+#include "durableFile.h"
+#include "cart.h"
+#include "mappedFile.h"
+#include "recordParser.h"
 #include "globals.h"
 #include "utility.h"
 #include "customers.h"
+#include "persistenceQueue.h"
 #include "products.h"
 
 /*
@@ -21,32 +27,40 @@
 ****************************************************************************
 */
 
+// Concurrent purchases on the server's worker threads take turns issuing transaction IDs, and take turns numbering
+// their records and queueing them for "transactions.txt", so records reach the file in number order. Waiting for
+// the record to be written, and the rest of a purchase, runs side by side.
+static std::mutex transactionIdLock;
+static std::mutex transactionLogLock;
+
+// The next transaction number. The first purchase reads it with readTransactionCount; after that it is kept here,
+// since the files lag behind while the persistence queue holds records. Guarded by transactionLogLock.
+static int nextTransactionNumber = 0;
+
 /*
 Class Name: Transaction
 Purpose: Represents a financial transaction involving a customer and multiple products, tracking details such as transaction ID, customer ID, product IDs, total amount, and rewards earned.
 Meaning of Attributes:
-  - std::string transactionID: A unique identifier for the transaction, generated when the transaction is created.
-  - std::string customerID: The unique identifier of the customer associated with the transaction.
-  - std::vector<std::string> productIDs: A list of product IDs included in the transaction.
-  - double totalAmount: The total amount of the transaction, stored as a double.
+  - TransactionId transactionID: A unique identifier for the transaction, generated when the transaction is created.
+  - CustomerId customerID: The unique identifier of the customer associated with the transaction.
+  - std::vector<ProductId> productIDs: A list of product IDs included in the transaction.
+  - Money totalAmount: The total amount of the transaction, in whole cents.
   - int rewardPoints: The total reward points earned in the transaction.
 Description of Methods:
-  - Transaction(std::string custID, std::vector<std::string> prodIDs, double totalAmt, int rewards): 
+  - Transaction(CustomerId custID, std::vector<ProductId> prodIDs, Money totalAmt, int rewards): 
       Constructor to initialize a transaction with customer ID, product IDs, total amount, and rewards, and generate a unique transaction ID.
   - std::string toString(int transactionNumber) const: 
       Converts transaction details into a formatted string representation, including transaction number, transaction ID, customer ID, product IDs, total amount, and rewards.
-  - static void saveTransactionToFile(const Transaction& transaction): 
-      Appends the transaction's details to the "transactions.txt" file. If the file cannot be opened, outputs an error message.
 */
 class Transaction {
 public:
-    std::string transactionID;
-    std::string customerID;
-    std::vector<std::string> productIDs;
-    double totalAmount;
+    TransactionId transactionID;
+    CustomerId customerID;
+    std::vector<ProductId> productIDs;
+    Money totalAmount;
     int rewardPoints;
 
-    Transaction(std::string custID, std::vector<std::string> prodIDs, double totalAmt, int rewards)
+    Transaction(CustomerId custID, std::vector<ProductId> prodIDs, Money totalAmt, int rewards)
         : customerID(custID), productIDs(prodIDs), totalAmount(totalAmt), rewardPoints(rewards) {
             transactionID = generateTransactionID();
         }
@@ -60,60 +74,131 @@ public:
     - Returns a formatted string containing transaction details, including transaction ID, user ID, product IDs, total amount, and total reward points.
     */
     std::string toString(int transactionNumber) const {
-        std::ostringstream oss;
-        oss << "Transaction " << transactionNumber << "\n"
-            << "\tTransaction ID: " << transactionID << "\n"
-            << "\tUser ID: " << customerID << "\n"
-            << "\tProducts: ";
-        for (size_t i = 0; i < productIDs.size(); ++i) {
-            oss << "Product " << i+1 << " " <<  productIDs[i];
-            if (i < productIDs.size() - 1) oss << ", ";
-        }
-        oss << "\n\tTotal Amount: $" << totalAmount << "\n"
-            << "\tTotal Reward Points: " << rewardPoints << "\n";
-        return oss.str();
+        TransactionRecord record;
+        record.transactionID = transactionID;
+        record.customerID = customerID;
+        record.productIDs = productIDs;
+        record.totalAmount = totalAmount;
+        record.rewardPoints = rewardPoints;
+        return formatTransactionRecord(record, transactionNumber);
     }
 
-    /*
-    Method Name: saveTransactionToFile
-    Purpose: Appends a transaction's information to the "transactions.txt" file.
-    Meaning of Parameters:
-    - const Transaction& transaction: The transaction object containing the details to be saved.
-    Description of Return Values:
-    - This method does not return a value. It writes the transaction's data to the file or outputs an error message if the file cannot be opened.
-    */
-    static void saveTransactionToFile(const Transaction& transaction) {
-        std::ofstream outfile("transactions.txt", std::ios::app);
-        if (outfile.is_open()) {
-            int transactionNumber = readTransactionCount();
-            outfile << transaction.toString(transactionNumber);
-            outfile.close();
-            std::cout << "\nTransaction saved successfully.\n";
+};
+
+/*
+Function Name: saveTransactionsToFile
+Purpose: Appends one or more formatted transaction records to the "transactions.txt" file through the group-committed transaction log.
+Meaning of Parameters:
+  - const std::string& records: The records, as formatted by formatTransactionRecord.
+  - int transactionCount: The counter value after them, i.e. the next transaction number; stored when the log is closed.
+  - std::unique_lock<std::mutex>& order: The caller's hold on the lock the records were numbered under, released once they are queued in order; it may hold no lock.
+Description of Return Values:
+  - Returns `true` once the records are on disk.
+  - Returns `false` and outputs an error message if the file cannot be opened, written or synced.
+*/
+bool saveTransactionsToFile(const std::string& records, int transactionCount, std::unique_lock<std::mutex>& order) {
+    if (transactionLog.append(records, transactionCount, order)) {
+        std::cout << "\nTransaction saved successfully.\n";
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/*
+Function Name: formatTransactionRecord
+Purpose: Formats a transaction the way it is stored in "transactions.txt".
+Meaning of Parameters:
+  - const TransactionRecord& record: The transaction to format.
+  - int transactionNumber: The transaction number to include in the header line.
+Description of Return Values:
+  - Returns the record text, ending with a newline.
+*/
+std::string formatTransactionRecord(const TransactionRecord& record, int transactionNumber) {
+    std::ostringstream oss;
+    oss << "Transaction " << transactionNumber << "\n"
+        << "\tTransaction ID: " << formatId(record.transactionID) << "\n"
+        << "\tUser ID: " << idDigits(record.customerID) << "\n"
+        << "\tProducts: ";
+    for (size_t i = 0; i < record.productIDs.size(); ++i) {
+        oss << "Product " << i+1 << " " <<  idDigits(record.productIDs[i]);
+        if (i < record.productIDs.size() - 1) oss << ", ";
+    }
+    oss << "\n\tTotal Amount: $" << formatMoney(record.totalAmount) << "\n"
+        << "\tTotal Reward Points: " << record.rewardPoints << "\n";
+    return oss.str();
+}
+
+/*
+Function Name: loadTransactionIDs
+Purpose: Collects every transaction ID already recorded in the transactions file, so new IDs stay unique across runs.
+Meaning of Parameters:
+  - const std::string& fileName: The transactions file, normally "transactions.txt".
+  - FlatSet& ids: Receives the IDs; existing contents are kept.
+Description of Return Values:
+  - Returns the number of transaction records read. A missing file counts as empty.
+*/
+std::size_t loadTransactionIDs(const std::string& fileName, FlatSet& ids) {
+    std::string_view contents;
+    std::string_view line;
+    std::string_view value;
+    TransactionId id{};
+    std::size_t count = 0;
+    mappedFileContents(fileName, contents);
+    RecordParser parser(contents);
+
+    // The while loop scans the mapped file once and only keeps the "Transaction ID:" line of each record.
+    while (parser.nextLine(line)) {
+        if (fieldValue(line, "Transaction ID:", value) && parseTransactionId(value, id)) {
+            ids.insert(id);
+            ++count;
         } else {
-            std::cerr << "Error: Could not open transactions.txt file.\n";
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
         }
     }
+    return count;
+}
 
-};
+/*
+Function Name: lastLoggedTransactionNumber
+Purpose: Finds the number in the last "Transaction N" header line of the transactions file, looking back from the end.
+Meaning of Parameters:
+  - const std::string& fileName: The transactions file, normally "transactions.txt".
+Description of Return Values:
+  - Returns the number of the last record, or 0 if the file is missing or has none.
+*/
+static int lastLoggedTransactionNumber(const std::string& fileName) {
+    MappedFile log;
+    std::string_view contents = log.open(fileName) ? log.contents() : std::string_view();
+    std::size_t header = contents.rfind("\nTransaction ");
+    header = (header == std::string_view::npos) ? 0 : header + 1;
+    std::string_view line = contents.substr(header, contents.find('\n', header) - header);
+    std::string_view value;
+    int number = 0;
+    if (fieldValue(line, "Transaction ", value) && parseWholeNumber(value, number)) {
+        return number;
+    } else {
+        return 0;
+    }
+}
 
 /*
 Function Name: readTransactionCount
-Purpose: Reads the transaction count from the "transaction_count.txt" file.
+Purpose: Works out the next transaction number. "transaction_count.txt" is only stored at shutdown, so the last record in "transactions.txt", which every commit makes durable, is checked too.
 Meaning of Parameters:
   - None.
 Description of Return Values:
-  - Returns the transaction count as an integer if successfully read from the file.
-  - Returns 1 if the file cannot be read or the count is unavailable.
+  - Returns the larger of the stored count and one past the last logged transaction number; 1 if neither is available.
 */
 int readTransactionCount() {
     std::ifstream infile("transaction_count.txt");
     int count = 1;
-    if (infile >> count) {
-        return count;
+    if (!(infile >> count)) {
+        count = 1;
     } else {
         ; // Null Statement: to satisify requirement that every if block has a corresponding else.
     }
-    return 1;
+    return std::max(count, lastLoggedTransactionNumber("transactions.txt") + 1);
 }
 
 /*
@@ -122,11 +207,10 @@ Purpose: Updates the "transaction_count.txt" file with the given transaction cou
 Meaning of Parameters:
   - int count: The new transaction count to be written to the file.
 Description of Return Values:
-  - This function does not return a value. It writes the provided count to the "transaction_count.txt" file.
+  - This function does not return a value. It replaces the "transaction_count.txt" file with the provided count, or outputs an error message and keeps the old count.
 */
 void updateTransactionCount(int count) {
-    std::ofstream outfile("transaction_count.txt");
-    outfile << count;
+    replaceFile("transaction_count.txt", std::to_string(count));
 }
 
 /*
@@ -139,7 +223,7 @@ Description of Return Values:
 */
 void addTransaction() {
     std::string customerID;
-    std::unordered_set<std::string> validProductIDs = loadAndDisplayProducts(5);
+    std::unordered_set<ProductId> validProductIDs = loadAndDisplayProducts(5);
     
     if (validProductIDs.empty()) {
         return;
@@ -159,45 +243,87 @@ void addTransaction() {
         std::cerr << "Welcome back customer: " << customerID << "\n\n";
     }
 
-    // Step 2: Get Product IDs and validate each
-    std::vector<std::string> productList; // Store the list of products for transaction record
-    double totalAmount = 0.0;
-    processProducts(productList, totalAmount);
-
-    // Step 3: Calculate Rewards (e.g., 10% of totalAmount as reward points)
-    int rewardPoints = calculateRewardPoints(totalAmount);
+    // Step 2: Get Product IDs and validate each into the cart; nothing is written yet
+    Cart cart;
+    processProducts(cart);
+    if (cart.empty()) {
+        std::cerr << "No products were added. Transaction canceled.\n";
+        return;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
 
-    int transactionCount = readTransactionCount();
+    // Step 3: Calculate Rewards from the configured reward rules
+    int rewardPoints = rewardRules.points(cart.total(), cart.rewardAmount());
 
-    Transaction transaction(customerID, productList, totalAmount, rewardPoints);
+    // Step 4: Commit the inventory, transaction record, counter and points together
+    CustomerId id{};
+    parseCustomerId(trim(customerID), id);
+    commitTransaction(id, cart, rewardPoints);
+}
 
-    Transaction::saveTransactionToFile(transaction);
+/*
+Function Name: commitTransaction
+Purpose: Commits a checked-out cart in one pass: products.txt is written once for every line item, then the transaction record and counter are written and the reward points are logged. All three writes go through the persistence queue, so with a write-behind policy they happen after this returns.
+Meaning of Parameters:
+  - CustomerId customerID: The customer making the purchase.
+  - Cart& cart: The validated line items.
+  - int rewardPoints: The reward points earned by the purchase.
+Description of Return Values:
+  - Returns the ID of the committed transaction.
+  - Returns TransactionId() (0) and outputs an error message if no transaction ID could be issued, or the inventory ran short or could not be written; nothing else is written in that case. Also returns it if the transaction record could not be written; the inventory is put back and no points are credited.
+*/
+TransactionId commitTransaction(CustomerId customerID, Cart& cart, int rewardPoints) {
+    // The ID is issued before any inventory is deducted, so running out of IDs leaves the catalog untouched
+    Transaction transaction(customerID, cart.productIDs(), cart.total(), rewardPoints);
+    if (transaction.transactionID == TransactionId()) {
+        std::cerr << "Error: No transaction ID could be issued. Transaction canceled.\n";
+        return TransactionId();
+    } else if (!cart.commitInventory()) {
+        std::cerr << "Error: Inventory could not be updated. Transaction canceled.\n";
+        return TransactionId();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
 
-    // Update transaction count for the next transaction
-    updateTransactionCount(transactionCount + 1);
+    // The lock is released as soon as the record is queued in number order, so concurrent purchases share commits
+    std::unique_lock<std::mutex> logGuard(transactionLogLock);
+    nextTransactionNumber = (nextTransactionNumber > 0) ? nextTransactionNumber : readTransactionCount();
+    int transactionNumber = nextTransactionNumber++;
+    if (!persistenceQueue.appendTransaction(transaction.toString(transactionNumber), transactionNumber + 1, logGuard)) {
+        std::cerr << "Error: The transaction could not be saved. Transaction canceled.\n";
+        cart.returnInventory();
+        return TransactionId();
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
 
-    updateCustomerRewards(customerID, rewardPoints, 5);
+    updateCustomerRewards(customerID, rewardPoints, 5, formatId(transaction.transactionID));
+    return transaction.transactionID;
 }
 
 /*
 Function Name: generateTransactionID
-Purpose: Generates a unique transaction ID by appending "Transaction" to a random 7-digit number.
+Purpose: Generates a unique transaction ID from the next 7-digit number of the transaction ID generator.
 Meaning of Parameters:
   - None.
 Description of Return Values:
-  - Returns a string containing the newly generated unique transaction ID.
-  - Ensures the ID does not already exist in the `transactionIDs` set.
+  - Returns the newly generated unique transaction ID.
+  - Returns TransactionId() (0) if the generator cannot issue one; it outputs the error.
 */
-std::string generateTransactionID() {
-    std::srand(std::time(nullptr));
-    std::string newID;
-    // The do-while loop generates a unique transaction ID by repeatedly creating a random ID and checking it against existing IDs to ensure uniqueness before 
-    // inserting it into the set.
+TransactionId generateTransactionID() {
+    std::lock_guard<std::mutex> guard(transactionIdLock);
+    std::uint64_t number = 0;
+    // The generator never repeats itself; the do-while loop only skips an ID that was picked at random before it existed
     do {
-        newID = "Transaction" + std::to_string(1000000 + std::rand() % 9000000);
-    } while (transactionIDs.find(newID) != transactionIDs.end());
-    transactionIDs.insert(newID);
-    return newID;
+        if (!transactionIdGenerator.nextNumber(number)) {
+            return TransactionId();
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    } while (transactionIDs.contains(static_cast<TransactionId>(number)));
+    transactionIDs.insert(static_cast<TransactionId>(number));
+    return static_cast<TransactionId>(number);
 }
 
 /*
@@ -205,3 +331,265 @@ std::string generateTransactionID() {
 ********************** TRANSACTIONS/SHOPPING END ***************************
 ****************************************************************************
 */
+
+/*
+****************************************************************************
+************************ TRANSACTION RESCORING START ***********************
+****************************************************************************
+*/
+
+// Holds a rescore between working it out and writing it: the new balance of every customer it moved, then the whole
+// rewritten transactions file. finishRescore applies it, and since it sets balances rather than adding to them, a
+// rescore cut short by a failed save or a crash is finished by running it again at the next startup.
+static const std::string rescoreIntentFileName = "transactions.rescore.txt";
+
+// What rescoring needs from one transaction record, with the position of its points value in the file text.
+struct ScoredTransaction {
+    CustomerId customerID{};
+    Money totalAmount;
+    int rewardPoints = 0;
+    std::size_t pointsOffset = 0; // Where the "Total Reward Points:" value starts
+    std::size_t pointsLength = 0; // 0 if the record has no points line
+};
+
+/*
+Function Name: readScoredTransactions
+Purpose: Collects the customer, total and reward points of every record in the transactions file text.
+Meaning of Parameters:
+  - std::string_view text: The whole transactions file.
+  - std::vector<ScoredTransaction>& records: Receives one entry per record, in file order.
+Description of Return Values:
+  - This function does not return a value.
+*/
+static void readScoredTransactions(std::string_view text, std::vector<ScoredTransaction>& records) {
+    RecordParser parser(text);
+    std::string_view line;
+    std::string_view value;
+    // The while loop starts a new entry at every "Transaction N" header (the "Transaction ID:" line is not one) and fills it
+    // from the lines that follow; anything before the first header is skipped.
+    while (parser.nextLine(line)) {
+        if (fieldValue(line, "Transaction ID:", value)) {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        } else if (fieldValue(line, "Transaction", value)) {
+            records.push_back(ScoredTransaction());
+        } else if (records.empty()) {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        } else if (fieldValue(line, "User ID:", value)) {
+            parseCustomerId(value, records.back().customerID);
+        } else if (fieldValue(line, "Total Amount:", value)) {
+            parseMoney(value, records.back().totalAmount);
+        } else if (fieldValue(line, "Total Reward Points:", value) && parseNumber(value, records.back().rewardPoints)) {
+            records.back().pointsOffset = static_cast<std::size_t>(value.data() - text.data());
+            records.back().pointsLength = value.size();
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+}
+
+/*
+Function Name: rewriteRewardPoints
+Purpose: Copies the transactions file text with each record's points value replaced by its new one.
+Meaning of Parameters:
+  - std::string_view text: The whole transactions file.
+  - const std::vector<ScoredTransaction>& records: The records, as read by readScoredTransactions.
+  - const std::vector<int>& points: The new points, one per record.
+Description of Return Values:
+  - Returns the new file text.
+*/
+static std::string rewriteRewardPoints(std::string_view text, const std::vector<ScoredTransaction>& records, const std::vector<int>& points) {
+    std::string rewritten;
+    rewritten.reserve(text.size() + text.size() / 16);
+    std::size_t copied = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (records[i].pointsLength != 0) {
+            rewritten.append(text.substr(copied, records[i].pointsOffset - copied));
+            rewritten += std::to_string(points[i]);
+            copied = records[i].pointsOffset + records[i].pointsLength;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    rewritten.append(text.substr(copied));
+    return rewritten;
+}
+
+/*
+Function Name: creditRescoredPoints
+Purpose: Moves each customer's balance in memory by the difference between the new and old points of their transactions. A balance that would go negative, because points were already redeemed, stops at zero. Records of removed customers still count as changed.
+Meaning of Parameters:
+  - const std::vector<ScoredTransaction>& records: The records, as read by readScoredTransactions.
+  - const std::vector<int>& points: The new points, one per record.
+  - std::vector<CustomerId>& moved: Receives each customer whose balance moved, once.
+  - std::vector<CustomerId>& clamped: Receives each customer whose balance was stopped at zero, once.
+Description of Return Values:
+  - Returns how many records changed.
+*/
+static std::size_t creditRescoredPoints(const std::vector<ScoredTransaction>& records, const std::vector<int>& points,
+                                        std::vector<CustomerId>& moved, std::vector<CustomerId>& clamped) {
+    FlatSet movedIDs(sizeof(std::uint64_t));
+    FlatSet clampedIDs(sizeof(std::uint64_t));
+    std::size_t changed = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        CustomerRecord* customer = customerStore.find(records[i].customerID);
+        if (records[i].pointsLength == 0 || points[i] == records[i].rewardPoints) {
+            continue;
+        } else if (customer != nullptr) {
+            customer->rewardPoints += points[i] - records[i].rewardPoints;
+            if (customer->rewardPoints < 0 && clampedIDs.insert(customer->userID)) {
+                clamped.push_back(customer->userID);
+            } else {
+                ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+            }
+            if (movedIDs.insert(customer->userID)) {
+                moved.push_back(customer->userID);
+            } else {
+                ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+            }
+            customer->rewardPoints = std::max(customer->rewardPoints, 0);
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+        ++changed;
+    }
+    return changed;
+}
+
+/*
+Function Name: formatRescoreIntent
+Purpose: Writes out a worked-out rescore for finishRescore: a "Rescore N" line, one "CustID########## balance" line for each of the N customers it moved, then the rewritten transactions file.
+Meaning of Parameters:
+  - const std::vector<CustomerId>& moved: The customers whose balances moved; their balances are read from the store.
+  - const std::string& rewritten: The transactions file text with the new points.
+Description of Return Values:
+  - Returns the text of the rescore intent file.
+*/
+static std::string formatRescoreIntent(const std::vector<CustomerId>& moved, const std::string& rewritten) {
+    std::string intent = "Rescore " + std::to_string(moved.size()) + "\n";
+    for (std::size_t i = 0; i < moved.size(); ++i) {
+        intent += formatId(moved[i]) + " " + std::to_string(customerStore.find(moved[i])->rewardPoints) + "\n";
+    }
+    intent += rewritten;
+    return intent;
+}
+
+/*
+Function Name: applyRescoreBalances
+Purpose: Reads the balance lines of a rescore intent file and sets each customer's balance to the one recorded. Setting rather than adding makes applying the same intent twice harmless.
+Meaning of Parameters:
+  - RecordParser& parser: A parser over the intent file, positioned at its start; left after the last balance line.
+Description of Return Values:
+  - Returns `true` if the header and every balance line could be read.
+  - Returns `false` if the file is damaged.
+*/
+static bool applyRescoreBalances(RecordParser& parser) {
+    std::string_view line;
+    std::string_view value;
+    int count = 0;
+    bool valid = parser.nextLine(line) && fieldValue(line, "Rescore", value) && parseWholeNumber(value, count);
+    for (int i = 0; valid && i < count; ++i) {
+        CustomerId customerID{};
+        int balance = 0;
+        std::size_t space = parser.nextLine(line) ? line.find(' ') : std::string_view::npos;
+        valid = space != std::string_view::npos && parseCustomerId(line.substr(0, space), customerID) &&
+                parseWholeNumber(line.substr(space + 1), balance);
+        CustomerRecord* customer = valid ? customerStore.find(customerID) : nullptr;
+        if (customer != nullptr) {
+            customer->rewardPoints = balance;
+        } else {
+            ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        }
+    }
+    return valid;
+}
+
+/*
+Function Name: finishRescore
+Purpose: Completes a rescore recorded in "transactions.rescore.txt": sets the recorded balances, saves the customer file, then replaces the transactions file and removes the intent file. Runs at the end of every rescore and at startup, where it finishes one that a failed save or a crash cut short.
+Meaning of Parameters:
+  - const std::string& fileName: The transactions file, normally "transactions.txt".
+Description of Return Values:
+  - Returns `true` if there was no rescore to finish or it was finished.
+  - Returns `false` and outputs an error message if the intent file is damaged or a file could not be written; the intent file is kept so the next startup tries again.
+*/
+bool finishRescore(const std::string& fileName) {
+    std::string intent;
+    if (!readWholeFile(rescoreIntentFileName, intent)) {
+        return true;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    RecordParser parser(intent);
+    if (!applyRescoreBalances(parser)) {
+        std::cerr << "Error: " << rescoreIntentFileName << " is damaged; the rescore it holds was not finished.\n";
+        return false;
+    } else if (!customerStore.save()) {
+        std::cerr << "Error: The rescored balances could not be saved; the rescore will be finished at the next startup.\n";
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    // The log's open descriptor would keep appending to the replaced file, so it is closed first
+    transactionLog.close();
+    if (!replaceFile(fileName, std::string_view(intent).substr(parser.position()))) {
+        std::cerr << "Error: The rescored transactions could not be saved; the rescore will be finished at the next startup.\n";
+        return false;
+    } else {
+        std::remove(rescoreIntentFileName.c_str());
+        return true;
+    }
+}
+
+/*
+Function Name: rescoreTransactions
+Purpose: Recalculates the reward points of every recorded transaction under the current reward rules, rewrites "transactions.txt" with them and moves the customers' balances by the difference. The points are worked out for the whole file at once with the batch calculateRewardPoints. A record keeps only its total and not the amount of each line item, so the rules must not have product or category multipliers; otherwise nothing is rescored. The result is first stored whole in "transactions.rescore.txt" and then applied by finishRescore, customer file first, so it is never half applied.
+Meaning of Parameters:
+  - const std::string& fileName: The transactions file, normally "transactions.txt".
+Description of Return Values:
+  - Returns `true` if both the transactions file and the customer file were written, or nothing needed to change. The customers whose balances were stopped at zero are listed.
+  - Returns `false` and outputs an error message if the rules have multipliers or a file could not be written.
+*/
+bool rescoreTransactions(const std::string& fileName) {
+    std::string text;
+    std::vector<ScoredTransaction> records;
+    // Rescoring multiplied purchases from their totals would take back points they earned under the multipliers
+    if (rewardRules.hasMultipliers()) {
+        std::cerr << "Error: The reward rules have product or category multipliers, which cannot be applied to transaction "
+                     "totals alone. Nothing was rescored.\n";
+        return false;
+    } else {
+        readWholeFile(fileName, text);
+    }
+    readScoredTransactions(text, records);
+
+    std::vector<Money> amounts(records.size());
+    std::vector<int> points(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        amounts[i] = records[i].totalAmount;
+    }
+    calculateRewardPoints(amounts.data(), points.data(), records.size());
+
+    std::vector<CustomerId> moved;
+    std::vector<CustomerId> clamped;
+    std::size_t changed = creditRescoredPoints(records, points, moved, clamped);
+    std::cout << "Rescored " << records.size() << " transaction(s): " << changed << " changed, "
+              << clamped.size() << " balance(s) stopped at zero.\n";
+    for (std::size_t i = 0; i < clamped.size(); ++i) {
+        std::cout << "  Stopped at zero: " << formatId(clamped[i]) << "\n";
+    }
+    if (changed == 0) {
+        return true;
+    } else if (!replaceFile(rescoreIntentFileName, formatRescoreIntent(moved, rewriteRewardPoints(text, records, points)))) {
+        return false;
+    } else {
+        return finishRescore(fileName);
+    }
+}
+
+/*
+****************************************************************************
+************************* TRANSACTION RESCORING END ************************
+****************************************************************************
+*/
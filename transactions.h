@@ -1,12 +1,33 @@
 #ifndef TRANSACTIONS_H
 #define TRANSACTIONS_H
 
+#include <mutex>
 #include <string>
+#include <vector>
+#include "money.h"
+#include "recordId.h"
 
 /* Declarations for transaction-related classes and functions */
+class Cart;
+class FlatSet;
+
+struct TransactionRecord {
+    TransactionId transactionID{};
+    CustomerId customerID{};
+    std::vector<ProductId> productIDs; // One per line item
+    Money totalAmount;
+    int rewardPoints = 0;
+};
+
 void addTransaction();
-std::string generateTransactionID();
+TransactionId commitTransaction(CustomerId customerID, Cart& cart, int rewardPoints);
+TransactionId generateTransactionID();
+bool saveTransactionsToFile(const std::string& records, int transactionCount, std::unique_lock<std::mutex>& order);
 void updateTransactionCount(int count);
 int readTransactionCount();
+std::string formatTransactionRecord(const TransactionRecord& record, int transactionNumber);
+std::size_t loadTransactionIDs(const std::string& fileName, FlatSet& ids);
+bool rescoreTransactions(const std::string& fileName);
+bool finishRescore(const std::string& fileName);
 
 #endif // TRANSACTIONS_H
@@ -1,5 +1,7 @@
 #include <iostream>
 #include "utility.h"
+#include "durableFile.h"
+#include "globals.h"
 
 /*
 Function Name: trim
@@ -24,13 +26,67 @@ std::string trim(const std::string &s) {
             --end;
         } while (end != start && std::isspace(*end));
     } else {
-      ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+        return std::string(); // Empty or whitespace-only input; `end + 1` would run past the end
     }
 
     // Return the trimmed string
     return std::string(start, end + 1);
 }
 
+/*
+Function Name: extractField
+Purpose: Checks whether a trimmed record line starts with the given key and, if so, extracts the value that follows it.
+Meaning of Parameters:
+  - const std::string& line: The trimmed line read from a record file (e.g. "Age: 42").
+  - const std::string& key: The field key to match, including its colon when it has one (e.g. "Age:").
+  - std::string& value: Receives the trimmed text after the key when the key matches.
+Description of Return Values:
+  - Returns `true` if the line starts with the key; `value` then holds the field value.
+  - Returns `false` if the line does not start with the key; `value` is left unchanged.
+*/
+bool extractField(const std::string& line, const std::string& key, std::string& value) {
+    if (line.compare(0, key.size(), key) != 0) {
+        return false;
+    } else {
+        ; // Null Statement: to satisify requirement that every if block has a corresponding else.
+    }
+
+    value = trim(line.substr(key.size()));
+    return true;
+}
+
+/*
+Function Name: replaceFileExtension
+Purpose: Derives the name of a companion file by replacing a data file's extension.
+Meaning of Parameters:
+  - const std::string& fileName: The data file, e.g. "customers.txt".
+  - const std::string& extension: The new extension including its dot, e.g. ".idx".
+Description of Return Values:
+  - Returns the companion file name, e.g. "customers.idx". A name without an extension has the new one added.
+*/
+std::string replaceFileExtension(const std::string& fileName, const std::string& extension) {
+    std::string::size_type dot = fileName.find_last_of('.');
+    std::string::size_type slash = fileName.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return fileName + extension;
+    } else {
+        return fileName.substr(0, dot) + extension;
+    }
+}
+
+/*
+Function Name: fileExists
+Purpose: Checks whether a file exists and can be opened for reading.
+Meaning of Parameters:
+  - const std::string& fileName: The file to check.
+Description of Return Values:
+  - Returns `true` if the file can be opened, `false` otherwise.
+*/
+bool fileExists(const std::string& fileName) {
+    std::ifstream infile(fileName);
+    return infile.is_open();
+}
+
 /*
 Function Name: deincrement_count
 Purpose: Decreases the count stored in a specified file by 1, typically used when removing an item.
@@ -52,14 +108,7 @@ void deincrement_count(const std::string& fileName) {
     }
 
     num--;
-
-    std::ofstream outFile(fileName);
-    if (outFile.is_open()) {
-        outFile << num;
-        outFile.close();
-    } else {
-        std::cerr << "Error: Could not open file." << std::endl;
-    }
+    replaceFile(fileName, std::to_string(num));
 }
 
 /*
@@ -85,7 +134,7 @@ void productsTxtChecker()
 
 /*
 Function Name: customersTxtChecker
-Purpose: Checks if the "customers.txt" file exists and provides an error message if it does not.
+Purpose: Checks if the customer file the customer store was loaded from ("customers.txt" or "customers.bin") exists and provides an error message if it does not.
 Meaning of Parameters:
   - None.
 Description of Return Values:
@@ -93,9 +142,9 @@ Description of Return Values:
 */
 void customersTxtChecker()
 {
-    std::ifstream infile("customers.txt");
+    std::ifstream infile(customerStore.dataFile());
     if (!infile.is_open()) {
-        std::cerr << "Error: customers.txt file does not exist.\n";
+        std::cerr << "Error: " << customerStore.dataFile() << " file does not exist.\n";
         std::cerr << "Please go to menu option 1 and input some customer information.\n";
         return;
     } else {
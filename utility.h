@@ -6,6 +6,9 @@
 #include <fstream>
 
 std::string trim(const std::string &s);
+bool extractField(const std::string& line, const std::string& key, std::string& value);
+std::string replaceFileExtension(const std::string& fileName, const std::string& extension);
+bool fileExists(const std::string& fileName);
 void deincrement_count(const std::string& fileName);
 void productsTxtChecker();
 void customersTxtChecker();